@@ -534,6 +534,18 @@ FUNCTION(ADD_GEMRB_PLUGIN_TEST plugin_name)
 	ENDIF()
 ENDFUNCTION()
 
+FUNCTION(ADD_GEMRB_PLUGIN_BENCHMARK plugin_name)
+	IF (BUILD_TESTING AND USE_BENCHMARKS)
+		ADD_EXECUTABLE(Benchmark_${plugin_name} ${ARGN})
+		target_compile_definitions(Benchmark_${plugin_name} PRIVATE _USE_MATH_DEFINES)
+
+		TARGET_LINK_LIBRARIES(Benchmark_${plugin_name} GTest::gtest GTest::gtest_main gemrb_core)
+
+		# run by the benchmark target, together with the core ones
+		SET_PROPERTY(GLOBAL APPEND PROPERTY GEMRB_PLUGIN_BENCHMARKS Benchmark_${plugin_name})
+	ENDIF()
+ENDFUNCTION()
+
 # pretty-print options macro
 # as of 2.8 cmake does not support anything like EVAL
 MACRO(PRINT_OPTION option)
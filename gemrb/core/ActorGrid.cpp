@@ -0,0 +1,187 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorGrid.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace GemRB {
+
+int ActorGrid::CellCoordinate(int pos)
+{
+	// round towards negative infinity, so the cells around 0 aren't doubled
+	if (pos < 0) {
+		return -1 - (-1 - pos) / CELL_SIZE;
+	}
+	return pos / CELL_SIZE;
+}
+
+ActorGrid::CellKey ActorGrid::MakeKey(int cx, int cy)
+{
+	return (CellKey(uint32_t(cx)) << 32) | uint32_t(cy);
+}
+
+ActorGrid::CellKey ActorGrid::GetKey(const Point& pos)
+{
+	return MakeKey(CellCoordinate(pos.x), CellCoordinate(pos.y));
+}
+
+int ActorGrid::GetReach(const Actor* actor)
+{
+	// covers both Selectable::IsOver and the circle PersonalDistance subtracts
+	return std::max(16, (actor->circleSize - 1) * 16) + 1;
+}
+
+void ActorGrid::Erase(CellKey key, const Actor* actor)
+{
+	auto it = cells.find(key);
+	if (it == cells.end()) return;
+
+	Cell& cell = it->second;
+	auto slot = std::find_if(cell.begin(), cell.end(), [actor](const Slot& s) {
+		return s.actor == actor;
+	});
+	if (slot == cell.end()) return;
+
+	// the order is restored from the sequence numbers, so we can swap
+	*slot = cell.back();
+	cell.pop_back();
+	if (cell.empty()) {
+		cells.erase(it);
+	}
+}
+
+void ActorGrid::AddActor(Actor* actor)
+{
+	if (!actor || entries.count(actor)) return;
+
+	Entry& entry = entries[actor];
+	entry.actor = actor;
+	entry.seq = nextSeq++;
+	entry.cell = GetKey(actor->Pos);
+	cells[entry.cell].push_back({ entry.seq, actor });
+	maxReach = std::max(maxReach, GetReach(actor));
+}
+
+void ActorGrid::RemoveActor(const Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+
+	Erase(it->second.cell, actor);
+	entries.erase(it);
+}
+
+void ActorGrid::UpdateEntry(Entry& entry)
+{
+	// the reach is only ever grown, which keeps the padding conservative
+	maxReach = std::max(maxReach, GetReach(entry.actor));
+
+	CellKey key = GetKey(entry.actor->Pos);
+	if (key == entry.cell) return;
+
+	Erase(entry.cell, entry.actor);
+	cells[key].push_back({ entry.seq, entry.actor });
+	entry.cell = key;
+}
+
+void ActorGrid::UpdateActor(const Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+	UpdateEntry(it->second);
+}
+
+void ActorGrid::Refresh()
+{
+	for (auto& entry : entries) {
+		UpdateEntry(entry.second);
+	}
+}
+
+void ActorGrid::Clear()
+{
+	entries.clear();
+	cells.clear();
+	maxReach = 0;
+}
+
+bool ActorGrid::GetCandidates(const Region& bounds, std::vector<Actor*>& candidates) const
+{
+	if (!enabled) return false;
+
+	candidates.clear();
+	if (entries.empty()) return true;
+
+	// widen in 64 bits, since the callers may pass huge radii
+	int64_t pad = maxReach;
+	int64_t left = int64_t(bounds.x) - pad;
+	int64_t top = int64_t(bounds.y) - pad;
+	int64_t right = int64_t(bounds.x) + std::max(0, bounds.w) + pad;
+	int64_t bottom = int64_t(bounds.y) + std::max(0, bounds.h) + pad;
+	auto clampCoordinate = [](int64_t pos) {
+		return CellCoordinate(int(Clamp<int64_t>(pos, INT_MIN / 2, INT_MAX / 2)));
+	};
+	int minX = clampCoordinate(left);
+	int minY = clampCoordinate(top);
+	int maxX = clampCoordinate(right);
+	int maxY = clampCoordinate(bottom);
+
+	std::vector<Slot> slots;
+	uint64_t cellCount = uint64_t(maxX - minX + 1) * uint64_t(maxY - minY + 1);
+	if (cellCount > cells.size()) {
+		// cheaper to go over the occupied cells than all the covered ones
+		for (const auto& cell : cells) {
+			int cx = int32_t(uint32_t(cell.first >> 32));
+			int cy = int32_t(uint32_t(cell.first));
+			if (cx < minX || cx > maxX || cy < minY || cy > maxY) continue;
+			slots.insert(slots.end(), cell.second.begin(), cell.second.end());
+		}
+	} else {
+		for (int cy = minY; cy <= maxY; cy++) {
+			for (int cx = minX; cx <= maxX; cx++) {
+				auto cell = cells.find(MakeKey(cx, cy));
+				if (cell == cells.end()) continue;
+				slots.insert(slots.end(), cell->second.begin(), cell->second.end());
+			}
+		}
+	}
+
+	std::sort(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+		return a.seq < b.seq;
+	});
+
+	candidates.reserve(slots.size());
+	for (const Slot& slot : slots) {
+		candidates.push_back(slot.actor);
+	}
+	return true;
+}
+
+bool ActorGrid::GetCandidates(const Point& center, unsigned int radius, std::vector<Actor*>& candidates) const
+{
+	int r = int(std::min<unsigned int>(radius, INT_MAX / 4));
+	return GetCandidates(Region(center.x - r, center.y - r, 2 * r, 2 * r), candidates);
+}
+
+}
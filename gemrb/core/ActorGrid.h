@@ -0,0 +1,99 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTOR_GRID_H
+#define ACTOR_GRID_H
+
+#include "exports.h"
+
+#include "Region.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+
+/**
+ * Per-map uniform grid bucketing the area's actors by their position, so that
+ * the radius, point and rectangle queries only have to look at the actors in
+ * the nearby cells instead of every actor in the area.
+ *
+ * Like with ActorIndex, the cells only narrow down the candidates; the caller
+ * still has to run the exact distance checks on them.
+ */
+class GEM_EXPORT ActorGrid {
+public:
+	// in area pixels; big enough for most queries to only touch a handful of cells
+	static constexpr int CELL_SIZE = 128;
+
+	// turning this off makes GetCandidates always fail, so the callers fall back to the full scan
+	bool enabled = true;
+
+	void AddActor(Actor* actor);
+	void RemoveActor(const Actor* actor);
+	// moves the actor between cells if its position (or circle) changed, see Scriptable::SetPos
+	void UpdateActor(const Actor* actor);
+	// resyncs all the actors, catching any moves that bypassed UpdateActor
+	void Refresh();
+	void Clear();
+
+	/**
+	 * Fills candidates with the actors whose position or ground circle could
+	 * lie within bounds, in the same order as the area's actor list.
+	 * Returns false when disabled, so the caller has to check all actors.
+	 */
+	bool GetCandidates(const Region& bounds, std::vector<Actor*>& candidates) const;
+	// the same for a circle (in pixels) around center
+	bool GetCandidates(const Point& center, unsigned int radius, std::vector<Actor*>& candidates) const;
+
+private:
+	using CellKey = uint64_t;
+
+	struct Slot {
+		size_t seq; // insertion order, mirroring the order of Map::actors
+		Actor* actor;
+	};
+	using Cell = std::vector<Slot>;
+
+	struct Entry {
+		Actor* actor = nullptr;
+		size_t seq = 0;
+		CellKey cell = 0;
+	};
+
+	std::unordered_map<const Actor*, Entry> entries;
+	std::unordered_map<CellKey, Cell> cells;
+	size_t nextSeq = 0;
+	// the largest ground circle extent seen, padding all the queries
+	int maxReach = 0;
+
+	static int CellCoordinate(int pos);
+	static CellKey MakeKey(int cx, int cy);
+	static CellKey GetKey(const Point& pos);
+	static int GetReach(const Actor* actor);
+	void Erase(CellKey key, const Actor* actor);
+	void UpdateEntry(Entry& entry);
+};
+
+}
+
+#endif
@@ -0,0 +1,268 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorIndex.h"
+
+#include "ie_stats.h"
+
+#include "GameScript/GSUtils.h"
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+static bool GetIDSField(IDSFunction func, ActorIndex::Field& field)
+{
+	if (func == GameScript::ID_Allegiance) {
+		field = ActorIndex::Field::EA;
+	} else if (func == GameScript::ID_General) {
+		field = ActorIndex::Field::General;
+	} else if (func == GameScript::ID_Race) {
+		field = ActorIndex::Field::Race;
+	} else if (func == GameScript::ID_Class) {
+		field = ActorIndex::Field::Class;
+	} else if (func == GameScript::ID_Specific) {
+		field = ActorIndex::Field::Specific;
+	} else if (func == GameScript::ID_Gender) {
+		field = ActorIndex::Field::Gender;
+	} else if (func == GameScript::ID_Alignment) {
+		field = ActorIndex::Field::Alignment;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+bool ActorIndex::IsIndexedStat(unsigned int stat)
+{
+	switch (stat) {
+		case IE_EA:
+		case IE_GENERAL:
+		case IE_RACE:
+		case IE_SPECIFIC:
+		case IE_SEX:
+		case IE_ALIGNMENT:
+		// everything GetActiveClass depends on
+		case IE_CLASS:
+		case IE_MC_FLAGS:
+		case IE_LEVEL:
+		case IE_LEVEL2:
+		case IE_LEVEL3:
+			return true;
+		default:
+			return false;
+	}
+}
+
+ieDword ActorIndex::GetKey(const Actor* actor, Field field)
+{
+	switch (field) {
+		case Field::EA:
+			return actor->GetStat(IE_EA);
+		case Field::General:
+			return actor->GetStat(IE_GENERAL);
+		case Field::Race:
+			return actor->GetStat(IE_RACE);
+		case Field::Class:
+			return actor->GetActiveClass();
+		case Field::Specific:
+			return actor->GetStat(IE_SPECIFIC);
+		case Field::Gender:
+			return actor->GetStat(IE_SEX);
+		case Field::Alignment:
+			return actor->GetStat(IE_ALIGNMENT);
+		default:
+			return 0;
+	}
+}
+
+void ActorIndex::Insert(Field field, ieDword key, const Slot& slot)
+{
+	buckets[field][key].push_back(slot);
+}
+
+void ActorIndex::Erase(Field field, ieDword key, const Actor* actor)
+{
+	auto& fieldBuckets = buckets[field];
+	auto it = fieldBuckets.find(key);
+	if (it == fieldBuckets.end()) return;
+
+	Bucket& bucket = it->second;
+	auto slot = std::find_if(bucket.begin(), bucket.end(), [actor](const Slot& s) {
+		return s.actor == actor;
+	});
+	if (slot == bucket.end()) return;
+
+	// the order is restored from the sequence numbers, so we can swap
+	*slot = bucket.back();
+	bucket.pop_back();
+	if (bucket.empty()) {
+		fieldBuckets.erase(it);
+	}
+}
+
+void ActorIndex::AddActor(Actor* actor)
+{
+	if (!actor || entries.count(actor)) return;
+
+	Entry& entry = entries[actor];
+	entry.actor = actor;
+	entry.seq = nextSeq++;
+	for (Field field : EnumIterator<Field>()) {
+		entry.keys[field] = GetKey(actor, field);
+		Insert(field, entry.keys[field], { entry.seq, actor });
+	}
+}
+
+void ActorIndex::RemoveActor(const Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+
+	for (Field field : EnumIterator<Field>()) {
+		Erase(field, it->second.keys[field], actor);
+	}
+	entries.erase(it);
+}
+
+void ActorIndex::UpdateEntry(Entry& entry)
+{
+	for (Field field : EnumIterator<Field>()) {
+		ieDword key = GetKey(entry.actor, field);
+		if (key == entry.keys[field]) continue;
+
+		Erase(field, entry.keys[field], entry.actor);
+		Insert(field, key, { entry.seq, entry.actor });
+		entry.keys[field] = key;
+	}
+}
+
+void ActorIndex::UpdateActor(const Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+	UpdateEntry(it->second);
+}
+
+void ActorIndex::Refresh()
+{
+	for (auto& entry : entries) {
+		UpdateEntry(entry.second);
+	}
+}
+
+void ActorIndex::Clear()
+{
+	entries.clear();
+	for (auto& fieldBuckets : buckets) {
+		fieldBuckets.clear();
+	}
+}
+
+int ActorIndex::CollectBuckets(Field field, int parameter, std::vector<const Bucket*>& out) const
+{
+	const auto& fieldBuckets = buckets[field];
+	int count = 0;
+	IDSFunction matcher = nullptr;
+
+	switch (field) {
+		case Field::EA:
+			// these match everyone
+			if (parameter == EA_ANYTHING) return -1;
+			matcher = GameScript::ID_Allegiance;
+			break;
+		case Field::Alignment:
+			matcher = GameScript::ID_Alignment;
+			break;
+		case Field::Class:
+			// the *_ALL values check the class levels instead, see idclass
+			if (parameter >= 202 && parameter <= 209) return -1;
+			break;
+		default:
+			break;
+	}
+
+	if (!matcher) {
+		// exact value comparison, so a single bucket
+		auto it = fieldBuckets.find(ieDword(parameter));
+		if (it != fieldBuckets.end()) {
+			out.push_back(&it->second);
+			count = int(it->second.size());
+		}
+		return count;
+	}
+
+	// range or mask comparisons depend only on the bucket key, so any member
+	// can stand in for the whole bucket
+	for (const auto& bucket : fieldBuckets) {
+		if (matcher(bucket.second.front().actor, parameter)) {
+			out.push_back(&bucket.second);
+			count += int(bucket.second.size());
+		}
+	}
+	return count;
+}
+
+bool ActorIndex::GetCandidates(const Object* oC, std::vector<Actor*>& candidates) const
+{
+	if (!enabled || !oC) return false;
+
+	int bestCount = -1;
+	std::vector<const Bucket*> best;
+	std::vector<const Bucket*> current;
+	for (int j = 0; j < ObjectIDSCount; j++) {
+		int parameter = oC->objectFields[j];
+		if (!parameter) continue;
+
+		Field field;
+		if (!GetIDSField(idtargets[j], field)) continue;
+
+		current.clear();
+		int count = CollectBuckets(field, parameter, current);
+		if (count < 0) continue;
+		if (bestCount < 0 || count < bestCount) {
+			bestCount = count;
+			best.swap(current);
+		}
+		if (bestCount == 0) break;
+	}
+
+	if (bestCount < 0) return false;
+
+	std::vector<Slot> slots;
+	slots.reserve(bestCount);
+	for (const Bucket* bucket : best) {
+		slots.insert(slots.end(), bucket->begin(), bucket->end());
+	}
+	// newest first, like iterating Map::actors backwards
+	std::sort(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+		return a.seq > b.seq;
+	});
+
+	candidates.clear();
+	candidates.reserve(slots.size());
+	for (const Slot& slot : slots) {
+		candidates.push_back(slot.actor);
+	}
+	return true;
+}
+
+}
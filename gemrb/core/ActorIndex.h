@@ -0,0 +1,110 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTOR_INDEX_H
+#define ACTOR_INDEX_H
+
+#include "exports.h"
+#include "ie_types.h"
+
+#include "EnumIndex.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+class Object;
+
+/**
+ * Per-map lookup tables bucketing the area's actors by the stats that IDS
+ * object targeting checks (eg. [ENEMY.0.0.MAGE]), so that object matching
+ * only has to look at the actors in the smallest matching buckets instead of
+ * every actor in the area.
+ *
+ * The buckets are only used to narrow down the candidates; the caller still
+ * has to run the full IDS checks on them.
+ */
+class GEM_EXPORT ActorIndex {
+public:
+	enum class Field : uint8_t {
+		EA,
+		General,
+		Race,
+		Class,
+		Specific,
+		Gender,
+		Alignment,
+
+		count
+	};
+
+	// turning this off makes GetCandidates always fail, so the callers fall back to the full scan
+	bool enabled = true;
+
+	void AddActor(Actor* actor);
+	void RemoveActor(const Actor* actor);
+	// moves the actor between buckets if any of its indexed stats changed
+	void UpdateActor(const Actor* actor);
+	// resyncs all the actors, catching any stat changes that bypassed UpdateActor
+	void Refresh();
+	void Clear();
+
+	/**
+	 * Fills candidates with the actors that could match the IDS fields of oC,
+	 * in the same (reversed) order as the area's actor list.
+	 * Returns false if none of the set fields is indexed, so the caller has to check all actors.
+	 */
+	bool GetCandidates(const Object* oC, std::vector<Actor*>& candidates) const;
+
+	// true for stats that affect any of the keys, see Actor::SetStat
+	static bool IsIndexedStat(unsigned int stat);
+
+private:
+	struct Slot {
+		size_t seq; // insertion order, mirroring the order of Map::actors
+		Actor* actor;
+	};
+	using Bucket = std::vector<Slot>;
+	using Keys = EnumArray<Field, ieDword>;
+
+	struct Entry {
+		Actor* actor = nullptr;
+		size_t seq = 0;
+		Keys keys {};
+	};
+
+	std::unordered_map<const Actor*, Entry> entries;
+	EnumArray<Field, std::unordered_map<ieDword, Bucket>> buckets;
+	size_t nextSeq = 0;
+
+	static ieDword GetKey(const Actor* actor, Field field);
+	void Insert(Field field, ieDword key, const Slot& slot);
+	void Erase(Field field, ieDword key, const Actor* actor);
+	void UpdateEntry(Entry& entry);
+	// returns the number of candidates or -1 if the field can't be used for narrowing
+	int CollectBuckets(Field field, int parameter, std::vector<const Bucket*>& out) const;
+};
+
+}
+
+#endif
@@ -30,15 +30,19 @@
 namespace GemRB {
 
 Animation::Animation(std::vector<frame_t> fr, float customFPS) noexcept
+	: Animation(std::make_shared<const std::vector<frame_t>>(std::move(fr)), customFPS)
+{}
+
+Animation::Animation(FrameSet fr, float customFPS) noexcept
 	: frames(std::move(fr))
 {
-	size_t count = frames.size();
+	size_t count = GetFrameCount();
 	assert(count > 0);
 	frameIdx = RAND<index_t>(0, count - 1);
 	flags = Flags::Active;
 	fps = customFPS;
 
-	for (const frame_t& frame : frames) {
+	for (const frame_t& frame : *frames) {
 		if (!frame) continue;
 		Region r = frame->Frame;
 		r.x = -r.x;
@@ -81,7 +85,7 @@ Animation::frame_t Animation::LastFrame(void)
 	} else {
 		starttime = GetMilliseconds();
 	}
-	return frames[GetCurrentFrameIndex()];
+	return (*frames)[GetCurrentFrameIndex()];
 }
 
 Animation::frame_t Animation::NextFrame(void)
@@ -91,7 +95,7 @@ Animation::frame_t Animation::NextFrame(void)
 		return nullptr;
 	}
 
-	Holder<Sprite2D> ret = frames[GetCurrentFrameIndex()];
+	Holder<Sprite2D> ret = (*frames)[GetCurrentFrameIndex()];
 
 	if (endReached && bool(flags & Flags::Once))
 		return ret;
@@ -123,7 +127,7 @@ Animation::frame_t Animation::NextFrame(void)
 		starttime = time;
 	}
 	if (frameIdx >= GetFrameCount()) {
-		if (!frames.empty()) {
+		if (GetFrameCount()) {
 			if (bool(flags & Flags::Once)) {
 				frameIdx = GetFrameCount() - 1;
 				endReached = true;
@@ -145,7 +149,7 @@ Animation::frame_t Animation::GetSyncedNextFrame(const Animation* master)
 		Log(MESSAGE, "Sprite2D", "Frame fetched while animation is inactive!");
 		return nullptr;
 	}
-	Holder<Sprite2D> ret = frames[GetCurrentFrameIndex()];
+	Holder<Sprite2D> ret = (*frames)[GetCurrentFrameIndex()];
 	starttime = master->starttime;
 	endReached = master->endReached;
 	lastTime = master->lastTime;
@@ -163,10 +167,35 @@ Animation::frame_t Animation::GetFrame(index_t i) const
 	if (i >= GetFrameCount()) {
 		return nullptr;
 	}
-	return frames[i];
+	return (*frames)[i];
 }
 
 void Animation::MirrorAnimation(BlitFlags bf)
+{
+	if (bf == BlitFlags::NONE || !frames) {
+		return;
+	}
+
+	// copy on write, the old set may be shared
+	std::vector<frame_t> mirrored = *frames;
+	MirrorFrames(mirrored, bf);
+	if (!sourceFrames) {
+		sourceFrames = frames;
+	}
+	frames = std::make_shared<const std::vector<frame_t>>(std::move(mirrored));
+
+	if (bf & BlitFlags::MIRRORX) {
+		// flip animArea horizontally as well
+		animArea.x = -animArea.w - animArea.x;
+	}
+
+	if (bf & BlitFlags::MIRRORY) {
+		// flip animArea vertically as well
+		animArea.y = -animArea.h - animArea.y;
+	}
+}
+
+void Animation::MirrorFrames(std::vector<frame_t>& frames, BlitFlags bf)
 {
 	if (bf == BlitFlags::NONE) {
 		return;
@@ -185,16 +214,6 @@ void Animation::MirrorAnimation(BlitFlags bf)
 			sprite->Frame.y = sprite->Frame.h - sprite->Frame.y;
 		}
 	}
-
-	if (bf & BlitFlags::MIRRORX) {
-		// flip animArea horizontally as well
-		animArea.x = -animArea.w - animArea.x;
-	}
-
-	if (bf & BlitFlags::MIRRORY) {
-		// flip animArea vertically as well
-		animArea.y = -animArea.h - animArea.y;
-	}
 }
 
 void Animation::AddAnimArea(const Animation* slave)
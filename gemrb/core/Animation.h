@@ -28,6 +28,7 @@
 #include "Region.h"
 #include "Sprite2D.h"
 
+#include <memory>
 #include <vector>
 
 namespace GemRB {
@@ -38,6 +39,8 @@ class GEM_EXPORT Animation {
 public:
 	using index_t = uint16_t;
 	using frame_t = Holder<Sprite2D>;
+	// the frames are never modified, so animations of the same cycle can share them
+	using FrameSet = std::shared_ptr<const std::vector<frame_t>>;
 
 	enum class Flags : uint8_t {
 		None = 0,
@@ -61,6 +64,7 @@ public:
 	Flags flags = Flags::None;
 
 	explicit Animation(std::vector<frame_t>, float customFPS) noexcept;
+	explicit Animation(FrameSet, float customFPS) noexcept;
 	Animation() noexcept = default;
 
 	explicit operator bool() const
@@ -76,17 +80,23 @@ public:
 	frame_t GetFrame(index_t i) const;
 
 	void MirrorAnimation(BlitFlags flags);
+	/** replaces the frames with mirrored copies */
+	static void MirrorFrames(std::vector<frame_t>& frames, BlitFlags flags);
 	/** sets frame index */
 	void SetFrame(index_t index);
 	/** returns the frame count */
-	index_t GetFrameCount() const { return frames.size(); }
+	index_t GetFrameCount() const { return frames ? frames->size() : 0; }
 	/** returns the current frame's index */
 	index_t GetCurrentFrameIndex() const;
 	/** add other animation's animarea to self */
 	void AddAnimArea(const Animation* slave);
+	/** whether both play the same frame set, see AnimationFactory::GetCycle */
+	bool SharesFrames(const Animation& other) const { return frames && frames == other.frames; }
 
 private:
-	std::vector<frame_t> frames;
+	FrameSet frames;
+	// the mirrored copies don't own their pixels, these frames do
+	FrameSet sourceFrames;
 	tick_t starttime = 0;
 	tick_t lastTime = 0;
 };
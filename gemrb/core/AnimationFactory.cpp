@@ -21,6 +21,9 @@
 #include "AnimationFactory.h"
 
 #include "Interface.h"
+#include "Palette.h"
+
+#include <set>
 
 namespace GemRB {
 
@@ -37,13 +40,45 @@ AnimationFactory::AnimationFactory(const ResRef& resref,
 	assert(cycles.size() < InvalidIndex);
 	assert(FLTable.size() < InvalidIndex);
 	fps = core->GetAnimationFPS(resRef);
+
+	memorySize = sizeof(*this) + frames.capacity() * sizeof(Holder<Sprite2D>) + cycles.capacity() * sizeof(CycleEntry) + FLTable.capacity() * sizeof(index_t);
+	// the frames usually share a palette
+	std::set<const Palette*> palettes;
+	for (const auto& frame : frames) {
+		if (!frame) continue;
+		memorySize += sizeof(Sprite2D) + frame->GetMemorySize();
+		palettes.insert(frame->GetPalette().get());
+	}
+	palettes.erase(nullptr);
+	memorySize += palettes.size() * sizeof(Palette);
+}
+
+AnimationFactory::CycleStats AnimationFactory::cycleStats;
+
+AnimationFactory::~AnimationFactory() noexcept
+{
+	for (const auto& set : cycleFrames) {
+		cycleStats.frameSets--;
+		cycleStats.frames -= set.second->size();
+		if (set.first.second != BlitFlags::NONE) {
+			cycleStats.mirroredFrames -= set.second->size();
+		}
+	}
 }
 
-Animation* AnimationFactory::GetCycle(index_t cycle) const noexcept
+Animation* AnimationFactory::GetCycle(index_t cycle, BlitFlags mirror) const noexcept
 {
 	if (cycle >= cycles.size() || cycles[cycle].FramesCount == 0) {
 		return nullptr;
 	}
+
+	auto key = std::make_pair(cycle, mirror);
+	auto cached = cycleFrames.find(key);
+	if (cached != cycleFrames.end()) {
+		cycleStats.hits++;
+		return new Animation(Share(cached->second), fps);
+	}
+
 	index_t ff = cycles[cycle].FirstFrame;
 	index_t lf = ff + cycles[cycle].FramesCount;
 	std::vector<Animation::frame_t> animframes;
@@ -52,7 +87,20 @@ Animation* AnimationFactory::GetCycle(index_t cycle) const noexcept
 		animframes.push_back(frames[FLTable[i]]);
 	}
 	assert(cycles[cycle].FramesCount == animframes.size());
-	return new Animation(std::move(animframes), fps);
+	Animation::MirrorFrames(animframes, mirror);
+
+	cycleStats.misses++;
+	cycleStats.frameSets++;
+	cycleStats.frames += animframes.size();
+	// the map node and the set, mirroring also copies the sprites but not their pixels
+	memorySize += 4 * sizeof(void*) + sizeof(cycleFrames.begin()->second) + animframes.capacity() * sizeof(Animation::frame_t);
+	if (mirror != BlitFlags::NONE) {
+		cycleStats.mirroredFrames += animframes.size();
+		memorySize += animframes.size() * sizeof(Sprite2D);
+	}
+	auto set = std::make_shared<const std::vector<Animation::frame_t>>(std::move(animframes));
+	cycleFrames.emplace(key, set);
+	return new Animation(Share(set), fps);
 }
 
 /* returns the required frame of the named cycle, cycle defaults to 0 */
@@ -66,7 +114,7 @@ Holder<Sprite2D> AnimationFactory::GetFrame(index_t index, index_t cycle) const
 	if (index >= fc) {
 		return nullptr;
 	}
-	return frames[FLTable[ff + index]];
+	return Share(frames[FLTable[ff + index]]);
 }
 
 Holder<Sprite2D> AnimationFactory::GetFrameWithoutCycle(index_t index) const
@@ -74,7 +122,7 @@ Holder<Sprite2D> AnimationFactory::GetFrameWithoutCycle(index_t index) const
 	if (index >= frames.size()) {
 		return nullptr;
 	}
-	return frames[index];
+	return Share(frames[index]);
 }
 
 AnimationFactory::index_t AnimationFactory::GetCycleSize(index_t idx) const
@@ -85,4 +133,9 @@ AnimationFactory::index_t AnimationFactory::GetCycleSize(index_t idx) const
 	return cycles[idx].FramesCount;
 }
 
+size_t AnimationFactory::GetMemorySize() const
+{
+	return memorySize;
+}
+
 }
@@ -27,6 +27,8 @@
 #include "FactoryObject.h"
 #include "Sprite2D.h"
 
+#include <map>
+
 namespace GemRB {
 
 class GEM_EXPORT AnimationFactory : public FactoryObject {
@@ -39,24 +41,45 @@ public:
 		index_t FirstFrame;
 	};
 
+	// the cached frame sets of all the factories
+	struct CycleStats {
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t frameSets = 0;
+		size_t frames = 0;
+		size_t mirroredFrames = 0; // sprite copies, the pixels are still shared
+	};
+
 	AnimationFactory(const ResRef& resref,
 			 std::vector<Holder<Sprite2D>> frames,
 			 std::vector<CycleEntry> cycles,
 			 std::vector<index_t> FLTable);
+	AnimationFactory(const AnimationFactory&) = delete;
+	AnimationFactory(AnimationFactory&&) = default;
+	~AnimationFactory() noexcept override;
+	AnimationFactory& operator=(const AnimationFactory&) = delete;
 
-	Animation* GetCycle(index_t cycle) const noexcept;
+	/** Returns a new animation of the cycle, sharing the frames with all the others */
+	Animation* GetCycle(index_t cycle, BlitFlags mirror = BlitFlags::NONE) const noexcept;
+	static const CycleStats& GetCycleStats() { return cycleStats; }
 	/** No descriptions */
 	Holder<Sprite2D> GetFrame(index_t index, index_t cycle = 0) const;
 	Holder<Sprite2D> GetFrameWithoutCycle(index_t index) const;
 	index_t GetCycleCount() const { return cycles.size(); }
 	index_t GetFrameCount() const { return frames.size(); }
 	index_t GetCycleSize(index_t idx) const;
+	size_t GetMemorySize() const override;
 
 private:
 	std::vector<Holder<Sprite2D>> frames;
 	std::vector<CycleEntry> cycles;
 	std::vector<index_t> FLTable; // Frame Lookup Table
 	float fps = ANI_DEFAULT_FRAMERATE; // comes from animfps.2da
+	mutable std::map<std::pair<index_t, BlitFlags>, Animation::FrameSet> cycleFrames;
+	// grows with the cached cycles
+	mutable size_t memorySize = 0;
+
+	static CycleStats cycleStats;
 };
 
 }
@@ -23,6 +23,7 @@
 
 #include "globals.h"
 
+#include "Compressor.h"
 #include "Plugin.h"
 #include "SaveGameAREExtractor.h"
 
@@ -33,7 +34,7 @@ public:
 	virtual int CreateArchive(DataStream* stream) = 0;
 	//decompressing a .sav file similar to CBF
 	virtual int DecompressSaveGame(DataStream* compressed, SaveGameAREExtractor&) = 0;
-	virtual int AddToSaveGame(DataStream* str, DataStream* uncompressed) = 0;
+	virtual int AddToSaveGame(DataStream* str, DataStream* uncompressed, Compressor::Level level = Compressor::Level::Best) = 0;
 	virtual int AddToSaveGameCompressed(DataStream* str, DataStream* compressed) = 0;
 };
 
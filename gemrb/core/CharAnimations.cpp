@@ -1014,7 +1014,31 @@ const CharAnimations::PartAnim* CharAnimations::GetAnimation(unsigned char Stanc
 			}
 		}
 
-		SharedAnim newanim(af->GetCycle(Cycle));
+		BlitFlags mirror = BlitFlags::NONE;
+		switch (AnimType) {
+			case IE_ANI_NINE_FRAMES: //dragon animations
+			case IE_ANI_FOUR_FRAMES: //wyvern animations
+			case IE_ANI_FOUR_FRAMES_2:
+			case IE_ANI_BIRD:
+			case IE_ANI_CODE_MIRROR:
+			case IE_ANI_CODE_MIRROR_2: //9 orientations
+			case IE_ANI_CODE_MIRROR_3:
+			case IE_ANI_PST_ANIMATION_3: //no stc just std
+			case IE_ANI_PST_ANIMATION_2: //no std just stc
+			case IE_ANI_PST_ANIMATION_1:
+			case IE_ANI_FRAGMENT:
+			case IE_ANI_TWO_FILES_3C:
+			case IE_ANI_TWO_FILES_5:
+				if (Orient > 8) {
+					mirror = BlitFlags::MIRRORX;
+				}
+				break;
+			default:
+				break;
+		}
+
+		// the (mirrored) frames are shared with all the other actors using this cycle
+		SharedAnim newanim(af->GetCycle(Cycle, mirror));
 
 		if (!newanim) {
 			if (part < actorPartCount) {
@@ -1094,27 +1118,6 @@ const CharAnimations::PartAnim* CharAnimations::GetAnimation(unsigned char Stanc
 				newanim->flags |= Animation::Flags::Once;
 				break;
 		}
-		switch (AnimType) {
-			case IE_ANI_NINE_FRAMES: //dragon animations
-			case IE_ANI_FOUR_FRAMES: //wyvern animations
-			case IE_ANI_FOUR_FRAMES_2:
-			case IE_ANI_BIRD:
-			case IE_ANI_CODE_MIRROR:
-			case IE_ANI_CODE_MIRROR_2: //9 orientations
-			case IE_ANI_CODE_MIRROR_3:
-			case IE_ANI_PST_ANIMATION_3: //no stc just std
-			case IE_ANI_PST_ANIMATION_2: //no std just stc
-			case IE_ANI_PST_ANIMATION_1:
-			case IE_ANI_FRAGMENT:
-			case IE_ANI_TWO_FILES_3C:
-			case IE_ANI_TWO_FILES_5:
-				if (Orient > 8) {
-					newanim->MirrorAnimation(BlitFlags::MIRRORX);
-				}
-				break;
-			default:
-				break;
-		}
 
 		newparts[part] = newanim;
 
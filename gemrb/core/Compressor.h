@@ -29,10 +29,15 @@ namespace GemRB {
 
 class GEM_EXPORT Compressor : public Plugin {
 public:
+	enum class Level : uint8_t {
+		Best,
+		Fast // for saves that happen while playing
+	};
+
 	/** decompresses a datastream (memory or file) to a FILE * stream */
 	virtual int Decompress(DataStream* dest, DataStream* source, unsigned int size_guess = 0) const = 0;
 	/** compresses a datastream (memory or file) to another DataStream */
-	virtual int Compress(DataStream* dest, DataStream* source) const = 0;
+	virtual int Compress(DataStream* dest, DataStream* source, Level level = Level::Best) const = 0;
 };
 
 }
@@ -0,0 +1,323 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "DirectoryIndex.h"
+
+#include "Interface.h"
+
+#include "Logging/Logging.h"
+#include "Strings/CString.h"
+#include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
+#if defined(SUPPORTS_MEMSTREAM)
+	#include "Streams/MappedFileMemoryStream.h"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <mutex>
+
+namespace GemRB {
+
+const path_t DirectoryIndex::FileName = "dirindex.bin";
+
+// the file is only used on the machine that wrote it, so everything is stored in native byte order
+static const char indexMagic[8] = { 'G', 'E', 'M', 'D', 'I', 'R', 'I', 'X' };
+// the offset tables are aligned, so they can be used in place
+static constexpr uint32_t INDEX_VERSION = 2;
+// listings of directories changed this recently may miss changes made within the same second
+static constexpr long long RACY_SECONDS = 2;
+
+static std::mutex indexMutex;
+static std::map<path_t, std::shared_ptr<const DirectoryIndex::Listing>> stored;
+// the file stored was read from, empty until there was one
+static path_t indexPath;
+// stored changed since it was last written
+static bool indexDirty = false;
+
+// takes care of truncated or foreign files, which are just ignored
+class IndexReader {
+public:
+	IndexReader(const char* data, size_t size)
+		: pos(data), end(data + size) {}
+
+	// returns the next len bytes in place
+	const char* Skip(size_t len)
+	{
+		if (size_t(end - pos) < len) return nullptr;
+		const char* data = pos;
+		pos += len;
+		return data;
+	}
+
+	// the buffer itself is at least as aligned
+	bool Align(size_t alignment)
+	{
+		size_t misalignment = reinterpret_cast<uintptr_t>(pos) % alignment;
+		return !misalignment || Skip(alignment - misalignment);
+	}
+
+	template<typename T>
+	bool Read(T& value)
+	{
+		return Read(&value, sizeof(T));
+	}
+
+	bool Read(void* dest, size_t len)
+	{
+		if (size_t(end - pos) < len) return false;
+		memcpy(dest, pos, len);
+		pos += len;
+		return true;
+	}
+
+private:
+	const char* pos;
+	const char* end;
+};
+
+static bool ReadListing(IndexReader& reader, path_t& dir, DirectoryIndex::Listing& listing)
+{
+	uint32_t pathLen = 0;
+	uint32_t count = 0;
+	uint32_t namesLen = 0;
+	if (!reader.Read(pathLen)) return false;
+	const char* path = reader.Skip(pathLen);
+	if (!path) return false;
+	dir.assign(path, pathLen);
+	if (!reader.Read(listing.time) || !reader.Read(count) || !reader.Read(namesLen)) return false;
+
+	if (!reader.Align(alignof(uint32_t))) return false;
+	const char* offsets = reader.Skip(size_t(count) * sizeof(uint32_t));
+	const char* names = reader.Skip(namesLen);
+	if (!offsets || !names) return false;
+	listing.offsets = reinterpret_cast<const uint32_t*>(offsets);
+	listing.count = count;
+	listing.names = names;
+	listing.namesLen = namesLen;
+
+	if (count && (namesLen == 0 || names[namesLen - 1] != '\0')) return false;
+	return std::all_of(listing.offsets, listing.offsets + count, [namesLen](uint32_t offset) {
+		return offset < namesLen;
+	});
+}
+
+// written next to the old file and then moved over it, since listings may still point into the old one
+static void SaveIndex()
+{
+	FileStream out;
+	path_t tmpPath = indexPath + ".tmp";
+	indexDirty = false;
+	if (!out.Create(tmpPath)) {
+		Log(ERROR, "DirectoryIndex", "Cannot write {}.", tmpPath);
+		return;
+	}
+
+	uint32_t count = uint32_t(stored.size());
+	out.Write(indexMagic, sizeof(indexMagic));
+	out.Write(&INDEX_VERSION, sizeof(INDEX_VERSION));
+	out.Write(&count, sizeof(count));
+	for (const auto& entry : stored) {
+		const DirectoryIndex::Listing& listing = *entry.second;
+		uint32_t pathLen = uint32_t(entry.first.length());
+		uint32_t nameCount = listing.count;
+		uint32_t namesLen = listing.namesLen;
+		out.Write(&pathLen, sizeof(pathLen));
+		out.Write(entry.first.c_str(), pathLen);
+		out.Write(&listing.time, sizeof(listing.time));
+		out.Write(&nameCount, sizeof(nameCount));
+		out.Write(&namesLen, sizeof(namesLen));
+		static const char padding[alignof(uint32_t)] = {};
+		size_t misalignment = out.GetPos() % alignof(uint32_t);
+		if (misalignment) out.Write(padding, alignof(uint32_t) - misalignment);
+		out.Write(listing.offsets, nameCount * sizeof(uint32_t));
+		out.Write(listing.names, namesLen);
+	}
+	out.Close();
+
+	if (!RenameFile(tmpPath, indexPath)) {
+		Log(ERROR, "DirectoryIndex", "Cannot replace {}.", indexPath);
+		UnlinkFile(tmpPath);
+	}
+}
+
+// maps the file where possible, so that the listings don't need copying
+static std::shared_ptr<const MemoryStream> OpenIndex(const path_t& path)
+{
+#if defined(SUPPORTS_MEMSTREAM)
+	auto mapped = std::make_shared<MappedFileMemoryStream>(path);
+	if (mapped->isOk()) return mapped;
+#endif
+	FileStream* file = FileStream::OpenFile(path);
+	if (!file) return nullptr;
+
+	strpos_t size = file->Size();
+	void* data = malloc(size);
+	bool ok = file->Read(data, size) == strret_t(size);
+	delete file;
+	if (!ok) {
+		free(data);
+		return nullptr;
+	}
+	return std::make_shared<MemoryStream>(path, data, size);
+}
+
+static void LoadIndex(const path_t& path)
+{
+	if (path == indexPath) return;
+	if (indexDirty) SaveIndex();
+	indexPath = path;
+	indexDirty = false;
+	stored.clear();
+
+	auto file = OpenIndex(indexPath);
+	if (!file) return;
+
+	IndexReader reader(file->GetBuffer(), file->Size());
+	char magic[sizeof(indexMagic)];
+	uint32_t version = 0;
+	uint32_t count = 0;
+	if (!reader.Read(magic) || memcmp(magic, indexMagic, sizeof(magic)) != 0) return;
+	if (!reader.Read(version) || version != INDEX_VERSION || !reader.Read(count)) return;
+
+	std::map<path_t, std::shared_ptr<const DirectoryIndex::Listing>> listings;
+	for (uint32_t i = 0; i < count; ++i) {
+		path_t dir;
+		auto listing = std::make_shared<DirectoryIndex::Listing>();
+		listing->indexFile = file;
+		if (!ReadListing(reader, dir, *listing)) {
+			Log(WARNING, "DirectoryIndex", "Ignoring damaged {}.", indexPath);
+			return;
+		}
+		listings[dir] = std::move(listing);
+	}
+	stored = std::move(listings);
+}
+
+static StringView NameAt(const DirectoryIndex::Listing& listing, uint32_t offset)
+{
+	return StringView(listing.names + offset);
+}
+
+static std::shared_ptr<DirectoryIndex::Listing> ListDirectory(const path_t& dir)
+{
+	auto listing = std::make_shared<DirectoryIndex::Listing>();
+	// taken before listing, so changes made in between invalidate the result
+	listing->time = DirectoryModificationTime(dir);
+
+	DirectoryIterator it(dir);
+	it.SetFlags(DirectoryIterator::Files, true);
+	if (it) {
+		do {
+			const path_t name = it.GetName();
+			listing->ownOffsets.push_back(uint32_t(listing->ownNames.length()));
+			listing->ownNames.append(name.c_str(), name.length() + 1);
+		} while (++it);
+	}
+	listing->names = listing->ownNames.c_str();
+	listing->namesLen = uint32_t(listing->ownNames.length());
+
+	// stable, so the first of several files differing only in case wins
+	CstrLessCI less;
+	auto& offsets = listing->ownOffsets;
+	std::stable_sort(offsets.begin(), offsets.end(), [&](uint32_t a, uint32_t b) {
+		return less(NameAt(*listing, a), NameAt(*listing, b));
+	});
+	auto last = std::unique(offsets.begin(), offsets.end(), [&](uint32_t a, uint32_t b) {
+		if (less(NameAt(*listing, a), NameAt(*listing, b))) return false;
+		Log(ERROR, "CachedDirectoryImporter", "Duplicate '{}' files in '{}' directory", NameAt(*listing, b), dir);
+		return true;
+	});
+	offsets.erase(last, offsets.end());
+	listing->offsets = offsets.data();
+	listing->count = uint32_t(offsets.size());
+	return listing;
+}
+
+DirectoryIndex::DirectoryIndex(std::shared_ptr<const Listing> listing) noexcept
+	: listing(std::move(listing))
+{}
+
+DirectoryIndex DirectoryIndex::Load(const path_t& dir, bool persistent)
+{
+	return Load(dir, persistent ? PathJoin(core->config.CachePath, FileName) : path_t());
+}
+
+DirectoryIndex DirectoryIndex::Load(const path_t& dir, const path_t& indexFile)
+{
+	if (indexFile.empty()) {
+		return DirectoryIndex(ListDirectory(dir));
+	}
+
+	std::shared_ptr<const Listing> known;
+	{
+		std::lock_guard<std::mutex> lock(indexMutex);
+		LoadIndex(indexFile);
+		auto entry = stored.find(dir);
+		if (entry != stored.end()) known = entry->second;
+	}
+	long long time = DirectoryModificationTime(dir);
+	if (time && known && known->time == time) {
+		return DirectoryIndex(std::move(known));
+	}
+
+	// not locked, so several directories can be listed at once
+	auto listing = ListDirectory(dir);
+	std::lock_guard<std::mutex> lock(indexMutex);
+	LoadIndex(indexFile);
+	if (listing->time && listing->time < std::time(nullptr) - RACY_SECONDS) {
+		stored[dir] = listing;
+		indexDirty = true;
+	} else if (stored.erase(dir)) {
+		indexDirty = true;
+	}
+	return DirectoryIndex(std::move(listing));
+}
+
+void DirectoryIndex::Flush()
+{
+	std::lock_guard<std::mutex> lock(indexMutex);
+	if (indexDirty) SaveIndex();
+}
+
+StringView DirectoryIndex::Find(StringView name) const
+{
+	if (!listing) return StringView();
+
+	CstrLessCI less;
+	const uint32_t* end = listing->offsets + listing->count;
+	auto it = std::lower_bound(listing->offsets, end, name, [&](uint32_t offset, const StringView& value) {
+		return less(NameAt(*listing, offset), value);
+	});
+	if (it == end || less(name, NameAt(*listing, *it))) {
+		return StringView();
+	}
+	return NameAt(*listing, *it);
+}
+
+size_t DirectoryIndex::Count() const
+{
+	return listing ? listing->count : 0;
+}
+
+}
@@ -0,0 +1,90 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef DIRECTORYINDEX_H
+#define DIRECTORYINDEX_H
+
+#include "exports.h"
+
+#include "Strings/StringView.h"
+#include "System/VFS.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+class MemoryStream;
+
+/**
+ * A sorted listing of the files in a directory, searched case insensitively.
+ *
+ * Listing override directories with tens of thousands of files is slow, so
+ * the listings are also kept in a single index file in the cache. A stored
+ * listing is reused as long as the modification time of its directory, which
+ * changes whenever files are added, removed or renamed, stays the same.
+ * Changes to the index file are only written out by Flush. Stored listings
+ * are served straight from the mapped index file.
+ */
+class GEM_EXPORT DirectoryIndex {
+public:
+	// name of the index file in the cache
+	static const path_t FileName;
+
+	struct Listing {
+		long long time = 0; // of the directory, 0 if unknown
+		const uint32_t* offsets = nullptr; // into names, in case insensitive order
+		uint32_t count = 0;
+		const char* names = nullptr; // nul terminated
+		uint32_t namesLen = 0;
+
+		// what offsets and names point into: a fresh listing or the index file
+		std::vector<uint32_t> ownOffsets;
+		std::string ownNames;
+		std::shared_ptr<const MemoryStream> indexFile;
+
+		Listing() noexcept = default;
+		Listing(const Listing&) = delete;
+		Listing& operator=(const Listing&) = delete;
+	};
+
+	DirectoryIndex() noexcept = default;
+
+	// lists dir or, if persistent, reuses its listing stored in the cache when it is still valid
+	static DirectoryIndex Load(const path_t& dir, bool persistent);
+	// the same with another index file, none if it is empty
+	static DirectoryIndex Load(const path_t& dir, const path_t& indexFile);
+	// writes the index file if any persistent listing changed since the last call
+	static void Flush();
+
+	// returns the file name as found on disk or an empty view if there is no such file
+	StringView Find(StringView name) const;
+	size_t Count() const;
+
+private:
+	explicit DirectoryIndex(std::shared_ptr<const Listing> listing) noexcept;
+
+	std::shared_ptr<const Listing> listing;
+};
+
+}
+
+#endif
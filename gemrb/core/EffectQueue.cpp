@@ -442,12 +442,95 @@ Effect* EffectQueue::CreateUnsummonEffect(const Effect* fx)
 	return newfx;
 }
 
+EffectQueue::EffectQueue(const EffectQueue& other)
+	: effects(other.effects), Owner(other.Owner)
+{
+	RebuildIndex();
+}
+
+EffectQueue::EffectQueue(EffectQueue&& other) noexcept
+	: effects(std::move(other.effects)), opcodeIndex(std::move(other.opcodeIndex)), Owner(other.Owner)
+{
+	// list nodes are moved over, so the references in the index stay valid
+	other.effects.clear();
+	other.opcodeIndex.clear();
+}
+
+EffectQueue& EffectQueue::operator=(const EffectQueue& other)
+{
+	if (this != &other) {
+		effects = other.effects;
+		Owner = other.Owner;
+		RebuildIndex();
+	}
+	return *this;
+}
+
+EffectQueue& EffectQueue::operator=(EffectQueue&& other) noexcept
+{
+	if (this != &other) {
+		effects = std::move(other.effects);
+		opcodeIndex = std::move(other.opcodeIndex);
+		Owner = other.Owner;
+		other.effects.clear();
+		other.opcodeIndex.clear();
+	}
+	return *this;
+}
+
+const EffectQueue::opcode_view_t& EffectQueue::OpcodeEffects(ieDword opcode) const
+{
+	static const opcode_view_t none;
+	auto it = opcodeIndex.find(opcode);
+	if (it == opcodeIndex.end()) {
+		return none;
+	}
+	return it->second;
+}
+
+void EffectQueue::IndexEffect(Effect& fx, bool insert)
+{
+	opcode_view_t& view = opcodeIndex[fx.Opcode];
+	if (insert) {
+		view.emplace(view.begin(), fx);
+	} else {
+		view.emplace_back(fx);
+	}
+}
+
+void EffectQueue::UnindexEffect(const Effect& fx)
+{
+	auto it = opcodeIndex.find(fx.Opcode);
+	if (it == opcodeIndex.end()) return;
+
+	opcode_view_t& view = it->second;
+	for (auto ref = view.begin(); ref != view.end(); ++ref) {
+		if (&ref->get() == &fx) {
+			view.erase(ref);
+			break;
+		}
+	}
+	if (view.empty()) {
+		opcodeIndex.erase(it);
+	}
+}
+
+void EffectQueue::RebuildIndex()
+{
+	opcodeIndex.clear();
+	for (auto& fx : effects) {
+		IndexEffect(fx, false);
+	}
+}
+
 void EffectQueue::AddEffect(Effect* fx, bool insert)
 {
 	if (insert) {
 		effects.push_front(std::move(*fx));
+		IndexEffect(effects.front(), true);
 	} else {
 		effects.push_back(std::move(*fx));
+		IndexEffect(effects.back(), false);
 	}
 	delete fx;
 }
@@ -458,6 +541,7 @@ bool EffectQueue::RemoveEffect(const Effect* fx)
 {
 	for (auto f = effects.begin(); f != effects.end(); ++f) {
 		if (*fx == *f) {
+			UnindexEffect(*f);
 			effects.erase(f);
 			return true;
 		}
@@ -472,13 +556,22 @@ void EffectQueue::ApplyAllEffects(Actor* target)
 {
 	const auto& Opcodes = Globals::Get().Opcodes;
 
+	bool reindex = false;
 	for (auto& fx : effects) {
+		ieDword opcode = fx.Opcode;
 		if (Opcodes[fx.Opcode].Flags & EFFECT_REINIT_ON_LOAD) {
 			// pretend to be the first application (FirstApply==1)
 			ApplyEffect(target, &fx, 1);
 		} else {
 			ApplyEffect(target, &fx, 0);
 		}
+		// some effects transform into others when applied
+		if (fx.Opcode != opcode) {
+			reindex = true;
+		}
+	}
+	if (reindex) {
+		RebuildIndex();
 	}
 }
 
@@ -486,6 +579,7 @@ void EffectQueue::Cleanup()
 {
 	for (auto f = effects.begin(); f != effects.end();) {
 		if (f->TimingMode == FX_DURATION_JUST_EXPIRED) {
+			UnindexEffect(*f);
 			f = effects.erase(f);
 		} else {
 			++f;
@@ -1335,13 +1429,6 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 	return res;
 }
 
-// looks for opcode with param2
-
-#define MATCH_OPCODE() \
-	if (fx.Opcode != opcode) { \
-		continue; \
-	}
-
 // useful for: remove projectile type
 #define MATCH_PROJECTILE() \
 	if (fx.Projectile != projectile) { \
@@ -1376,8 +1463,7 @@ static inline bool IsLive(ieByte timingmode)
 //will be killed along with it
 void EffectQueue::RemoveAllEffects(ieDword opcode)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		fx.TimingMode = FX_DURATION_JUST_EXPIRED;
@@ -1553,8 +1639,7 @@ void EffectQueue::RemoveAllEffects(EffectRef& effectReference)
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithResource(ieDword opcode, const ResRef& resource)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) {
 			continue;
@@ -1574,8 +1659,7 @@ void EffectQueue::RemoveAllEffectsWithResource(EffectRef& effectReference, const
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithSource(ieDword opcode, const ResRef& source, int mode)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		if (fx.SourceRef != source) continue;
 
 		// equipping effects only
@@ -1605,8 +1689,7 @@ void EffectQueue::RemoveAllEffectsWithSource(EffectRef& effectReference, const R
 //(works only if a higher stat means good for the target)
 void EffectQueue::RemoveAllDetrimentalEffects(ieDword opcode, ieDword current)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		switch (fx.Parameter2) {
@@ -1642,8 +1725,7 @@ void EffectQueue::RemoveAllDetrimentalEffects(EffectRef& effectReference, ieDwor
 //opcode need to be removed (see removal of portrait icon)
 void EffectQueue::RemoveAllEffectsWithParam(ieDword opcode, ieDword param, bool param1)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (param1) {
 			if (fx.Parameter1 != param) continue;
@@ -1671,8 +1753,7 @@ void EffectQueue::RemoveAllEffectsWithParam1(EffectRef& effectReference, ieDword
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithParamAndResource(ieDword opcode, ieDword param2, const ResRef& resource)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 
@@ -1801,8 +1882,7 @@ bool EffectQueue::RollDispelChance(ieDword casterLevel, ieDword level)
 
 const Effect* EffectQueue::HasOpcode(ieDword opcode) const
 {
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		return &fx;
@@ -1821,8 +1901,7 @@ const Effect* EffectQueue::HasEffect(EffectRef& effectReference) const
 
 Effect* EffectQueue::HasOpcode(ieDword opcode)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		return &fx;
@@ -1841,8 +1920,7 @@ Effect* EffectQueue::HasEffect(EffectRef& effectReference)
 
 const Effect* EffectQueue::HasOpcodeWithParam(ieDword opcode, ieDword param2) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 
@@ -1866,8 +1944,7 @@ const Effect* EffectQueue::HasEffectWithParam(EffectRef& effectReference, ieDwor
 
 const Effect* EffectQueue::HasOpcodeWithParamPair(ieDword opcode, ieDword param1, ieDword param2) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 		//0 is always accepted as first parameter
@@ -1894,8 +1971,7 @@ const Effect* EffectQueue::HasEffectWithParamPair(EffectRef& effectReference, ie
 bool EffectQueue::DecreaseParam1OfEffect(ieDword opcode, ieDword amount)
 {
 	bool found = false;
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		ieDword& amount_left = fx.Parameter1;
 		if (amount_left > amount) {
@@ -1922,8 +1998,7 @@ bool EffectQueue::DecreaseParam1OfEffect(EffectRef& effectReference, ieDword amo
 //returns the damage amount NOT soaked
 int EffectQueue::DecreaseParam3OfEffect(ieDword opcode, ieDword amount, ieDword param2)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 		ieDword value = fx.Parameter3;
@@ -1961,8 +2036,7 @@ static const int ids_stats[9] = { IE_FACTION, IE_TEAM, IE_EA, IE_GENERAL, IE_RAC
 int EffectQueue::BonusAgainstCreature(ieDword opcode, const Actor* actor) const
 {
 	ieDword sum = 0;
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (fx.Parameter1) {
 			ieDword param1;
@@ -2013,8 +2087,7 @@ int EffectQueue::BonusAgainstCreature(EffectRef& effectReference, const Actor* a
 int EffectQueue::BonusForParam2(ieDword opcode, ieDword param2) const
 {
 	int sum = 0;
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 		sum += fx.Parameter1;
@@ -2035,8 +2108,7 @@ int EffectQueue::MaxParam1(ieDword opcode, bool positive) const
 {
 	int max = 0;
 	ieDwordSigned param1 = 0;
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		param1 = signed(fx.Parameter1);
@@ -2058,8 +2130,7 @@ int EffectQueue::MaxParam1(EffectRef& effectReference, bool positive) const
 
 bool EffectQueue::WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const
 {
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		int magic = (int) fx.Parameter1;
@@ -2098,8 +2169,7 @@ void EffectQueue::AddWeaponEffects(EffectQueue* fxqueue, EffectRef& fx_ref, ieDw
 	ieDword opcode = fx_ref.opcode;
 	Point p(-1, -1);
 
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (!param2 && fx.Parameter2 != param2) continue;
 
@@ -2118,8 +2188,7 @@ int EffectQueue::SumDamageReduction(EffectRef& effectReference, ieDword weaponEn
 	int remaining = 0;
 	int count = 0;
 
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		count++;
@@ -2139,8 +2208,7 @@ int EffectQueue::SumDamageReduction(EffectRef& effectReference, ieDword weaponEn
 //useful for immunity vs spell, can't use item, etc.
 const Effect* EffectQueue::HasOpcodeWithResource(ieDword opcode, const ResRef& resource) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) continue;
 
@@ -2164,8 +2232,7 @@ const Effect* EffectQueue::HasEffectWithPower(EffectRef& effectReference, ieDwor
 
 const Effect* EffectQueue::HasOpcodeWithPower(ieDword opcode, ieDword power) const
 {
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		// NOTE: matching greater or equals!
 		if (fx.Power < power) continue;
@@ -2192,8 +2259,7 @@ const Effect* EffectQueue::HasSource(const ResRef& removed) const
 //used in contingency/sequencer code (cannot have the same contingency twice)
 const Effect* EffectQueue::HasOpcodeWithSource(ieDword opcode, const ResRef& removed) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (removed != fx.SourceRef) {
 			continue;
@@ -2277,18 +2343,23 @@ Effect* EffectQueue::GetNextEffect(queue_t::iterator& f)
 
 ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2, const ResRef& resource, const ResRef& source) const
 {
-	ieDword cnt = 0;
+	auto matches = [&](const Effect& fx) {
+		if (param1 != 0xffffffff && fx.Parameter1 != param1) return false;
+		if (param2 != 0xffffffff && fx.Parameter2 != param2) return false;
+		if (!resource.IsEmpty() && fx.Resource != resource) return false;
+		if (!source.IsEmpty() && fx.SourceRef != source) return false;
+		return true;
+	};
 
-	for (const auto& fx : effects) {
-		if (opcode != 0xffffffff)
-			MATCH_OPCODE()
-		if (param1 != 0xffffffff)
-			MATCH_PARAM1()
-		if (param2 != 0xffffffff)
-			MATCH_PARAM2()
-		if (!resource.IsEmpty() && fx.Resource != resource) continue;
-		if (!source.IsEmpty() && fx.SourceRef != source) continue;
-		cnt++;
+	ieDword cnt = 0;
+	if (opcode == 0xffffffff) {
+		for (const auto& fx : effects) {
+			if (matches(fx)) cnt++;
+		}
+	} else {
+		for (const Effect& fx : OpcodeEffects(opcode)) {
+			if (matches(fx)) cnt++;
+		}
 	}
 	return cnt;
 }
@@ -2298,8 +2369,7 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effectReference, const Effec
 	ieDword cnt = 1;
 	ieDword opcode = ResolveEffect(effectReference);
 
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const Effect& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (&fx == fx2) break;
 		cnt++;
@@ -2309,8 +2379,7 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effectReference, const Effec
 
 void EffectQueue::ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (Effect& fx : OpcodeEffects(opcode)) {
 		fx.Pos = Point(x, y);
 		fx.Parameter3 = 0;
 		return;
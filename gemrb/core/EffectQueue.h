@@ -33,7 +33,10 @@
 #include "Effect.h"
 
 #include <cstdlib>
+#include <functional>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace GemRB {
 
@@ -212,11 +215,24 @@ private:
 	/** List of Effects applied on the Actor */
 	using queue_t = std::list<Effect>;
 	queue_t effects;
+	/** The same effects grouped by opcode, in queue order.
+	 * The list itself is kept, since effects get added while the queue is being applied */
+	using opcode_view_t = std::vector<std::reference_wrapper<Effect>>;
+	std::unordered_map<ieDword, opcode_view_t> opcodeIndex;
 	/** Actor which is target of the Effects */
 	Scriptable* Owner = nullptr;
 
+	const opcode_view_t& OpcodeEffects(ieDword opcode) const;
+	void IndexEffect(Effect& fx, bool insert);
+	void UnindexEffect(const Effect& fx);
+	void RebuildIndex();
+
 public:
 	EffectQueue() noexcept {};
+	EffectQueue(const EffectQueue& other);
+	EffectQueue(EffectQueue&& other) noexcept;
+	EffectQueue& operator=(const EffectQueue& other);
+	EffectQueue& operator=(EffectQueue&& other) noexcept;
 
 	explicit operator bool() const
 	{
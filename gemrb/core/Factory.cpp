@@ -20,32 +20,101 @@
 
 #include "Factory.h"
 
+#include "Logging/Logging.h"
+
 namespace GemRB {
 
-void Factory::AddFactoryObject(object_t fobject)
+Factory::Factory(size_t maxBytes) noexcept
+	: maxBytes(maxBytes)
+{}
+
+void Factory::AddFactoryObject(object_t fobject, bool evictable)
 {
-	fobjects.push_back(std::move(fobject));
+	auto& typeObjects = fobjects[fobject->SuperClassID];
+	// like before, the first one added stays in use
+	if (typeObjects.count(fobject->resRef)) {
+		return;
+	}
+
+	Entry& entry = typeObjects[fobject->resRef];
+	entry.bytes = fobject->GetMemorySize();
+	entry.evictable = evictable;
+	entry.use = lru.emplace(lru.end(), fobject->SuperClassID, fobject->resRef);
+	entry.object = std::move(fobject);
+
+	stats.objects++;
+	stats.bytes += entry.bytes;
+	UpdateSizes();
+	if (stats.bytes > maxBytes) {
+		Evict();
+	}
 }
 
-int Factory::IsLoaded(const ResRef& resref, SClass_ID type) const
+Factory::object_t Factory::GetFactoryObject(const ResRef& resRef, SClass_ID type)
 {
-	if (resref.IsEmpty()) {
-		return -1;
+	if (resRef.IsEmpty()) {
+		return nullptr;
+	}
+
+	auto typeObjects = fobjects.find(type);
+	if (typeObjects == fobjects.end()) {
+		stats.misses++;
+		return nullptr;
 	}
+	auto entry = typeObjects->second.find(resRef);
+	if (entry == typeObjects->second.end()) {
+		stats.misses++;
+		return nullptr;
+	}
+
+	stats.hits++;
+	lru.splice(lru.end(), lru, entry->second.use);
+	return entry->second.object;
+}
 
-	for (unsigned int i = 0; i < fobjects.size(); i++) {
-		if (fobjects[i]->SuperClassID == type) {
-			if (fobjects[i]->resRef == resref) {
-				return i;
-			}
+const Factory::Stats& Factory::GetStats()
+{
+	UpdateSizes();
+	return stats;
+}
+
+void Factory::UpdateSizes()
+{
+	// eg. animation factories cache the cycles they build
+	for (auto& typeObjects : fobjects) {
+		for (auto& entry : typeObjects.second) {
+			size_t bytes = entry.second.object->GetMemorySize();
+			stats.bytes += bytes - entry.second.bytes;
+			entry.second.bytes = bytes;
 		}
 	}
-	return -1;
 }
 
-Factory::object_t Factory::GetFactoryObject(int pos) const
+void Factory::Evict()
 {
-	return fobjects[pos];
+	size_t evicted = 0;
+	auto it = lru.begin();
+	while (it != lru.end() && stats.bytes > maxBytes) {
+		auto& typeObjects = fobjects[it->first];
+		auto entry = typeObjects.find(it->second);
+		assert(entry != typeObjects.end());
+		// still in use elsewhere, so dropping it wouldn't free anything
+		if (!entry->second.evictable || entry->second.object.use_count() > 1) {
+			++it;
+			continue;
+		}
+
+		stats.bytes -= entry->second.bytes;
+		stats.objects--;
+		typeObjects.erase(entry);
+		it = lru.erase(it);
+		evicted++;
+	}
+
+	stats.evictions += evicted;
+	if (evicted) {
+		Log(DEBUG, "Factory", "Dropped {} unused objects, {} bytes in {} objects remain.", evicted, stats.bytes, stats.objects);
+	}
 }
 
 }
@@ -25,24 +25,60 @@
 
 #include "FactoryObject.h"
 
+#include <list>
+#include <map>
 #include <memory>
 
 namespace GemRB {
 
+/**
+ * Cache of the objects built from resources, eg. animation factories.
+ *
+ * Beyond the memory budget, evictable objects that nobody else holds any
+ * more are dropped, least recently used first. They are simply rebuilt
+ * from their resource the next time they are needed. The parts they hand
+ * out (eg. animation frames) hold them too, see FactoryObject::Share.
+ */
 class GEM_EXPORT Factory {
 public:
 	using object_t = std::shared_ptr<FactoryObject>;
+	static constexpr size_t MAX_BYTES = 96 * 1024 * 1024;
+
+	struct Stats {
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t objects = 0;
+		size_t bytes = 0; // as estimated by the objects themselves, which can grow after being added
+	};
 
-	Factory() noexcept = default;
+	explicit Factory(size_t maxBytes = MAX_BYTES) noexcept;
 	Factory(const Factory&) = delete;
 	Factory& operator=(const Factory&) = delete;
 
-	void AddFactoryObject(object_t fobject);
-	int IsLoaded(const ResRef& resRef, SClass_ID type) const;
-	object_t GetFactoryObject(int pos) const;
+	// objects that can't be rebuilt from a resource have to be kept forever
+	void AddFactoryObject(object_t fobject, bool evictable = true);
+	// returns nullptr if the object isn't cached
+	object_t GetFactoryObject(const ResRef& resRef, SClass_ID type);
+	const Stats& GetStats();
 
 private:
-	std::vector<object_t> fobjects;
+	using key_t = std::pair<SClass_ID, ResRef>;
+
+	struct Entry {
+		object_t object;
+		size_t bytes = 0;
+		bool evictable = true;
+		std::list<key_t>::iterator use; // position in the lru order
+	};
+
+	size_t maxBytes;
+	Stats stats;
+	std::map<SClass_ID, ResRefMap<Entry>> fobjects;
+	std::list<key_t> lru; // front is the least recently used
+
+	void UpdateSizes();
+	void Evict();
 };
 
 }
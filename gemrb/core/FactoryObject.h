@@ -27,15 +27,31 @@
 
 #include "Resource.h"
 
+#include <memory>
+
 namespace GemRB {
 
-class GEM_EXPORT FactoryObject {
+class GEM_EXPORT FactoryObject : public std::enable_shared_from_this<FactoryObject> {
 public:
 	SClass_ID SuperClassID;
 	ResRef resRef;
 	FactoryObject(const ResRef& name, SClass_ID superClassID)
 		: SuperClassID(superClassID), resRef(name) {};
 	virtual ~FactoryObject() noexcept = default;
+
+	/** Estimated size of the decoded data, for the cache budget */
+	virtual size_t GetMemorySize() const { return 0; }
+
+protected:
+	/** Ties a part that is handed out (eg. a frame) to this object, so the
+	 * Factory doesn't evict it while the part is still in use */
+	template<typename T>
+	std::shared_ptr<T> Share(const std::shared_ptr<T>& part) const
+	{
+		std::shared_ptr<const FactoryObject> self = weak_from_this().lock();
+		if (!self || !part) return part;
+		return std::shared_ptr<T>(self, part.get());
+	}
 };
 
 }
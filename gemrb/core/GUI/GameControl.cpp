@@ -273,9 +273,10 @@ void GameControl::ClearMouseState()
 
 // generate an action to do the actual movement
 // only PST supports RunToPoint
-void GameControl::CreateMovement(Actor* actor, const Point& p, bool append, bool tryToRun) const
+int GameControl::CreateMovement(Actor* actor, const Point& p, bool append, bool tryToRun) const
 {
 	Action* action = nullptr;
+	int distance = -1;
 	tryToRun = tryToRun || AlwaysRun;
 
 	if (append) {
@@ -285,6 +286,7 @@ void GameControl::CreateMovement(Actor* actor, const Point& p, bool append, bool
 		//try running (in PST) only if not encumbered
 		if (tryToRun && CanRun(actor)) {
 			action = GenerateAction(fmt::format("RunToPoint([{}.{}])", p.x, p.y));
+			distance = IF_RUNNING; // sic, see RunToPoint
 		}
 
 		// check again because GenerateAction can fail (non PST)
@@ -294,11 +296,13 @@ void GameControl::CreateMovement(Actor* actor, const Point& p, bool append, bool
 				// gemrb extension to make travel through nearly blocked regions less painful
 				action->int0Parameter = MAX_TRAVELING_DISTANCE / 10; // empirical
 			}
+			distance = action->int0Parameter;
 		}
 	}
 
 	actor->CommandActor(action, !append);
 	actor->Destination = p; // just to force target reticle drawing if paused
+	return distance;
 }
 
 // can we handle it (no movement impairments)?
@@ -1484,7 +1488,11 @@ void GameControl::DebugPaint(const Point& p, bool sample) const noexcept
 		if (sample) {
 			DebugPropVal = map->tileProps.QueryTileProp(tile, prop);
 		} else {
+			map->WaitForPaths();
 			map->tileProps.SetTileProp(tile, prop, DebugPropVal);
+			if (prop == TileProps::Property::SEARCH_MAP) {
+				map->SearchMapChanged(tile);
+			}
 		}
 	}
 }
@@ -2380,6 +2388,7 @@ void GameControl::CommandSelectedMovement(const Point& p, bool formation, bool a
 	bool doWorldMap = ShouldTriggerWorldMap(party[0]);
 
 	std::vector<Point> formationPoints = GetFormationPoints(p, party, angle);
+	std::vector<PathRequest> paths;
 	for (size_t i = 0; i < party.size(); i++) {
 		Actor* actor = party[i];
 		// don't stop the party if we're just trying to add a waypoint
@@ -2387,14 +2396,26 @@ void GameControl::CommandSelectedMovement(const Point& p, bool formation, bool a
 			actor->Stop();
 		}
 
-		if (formation && party.size() > 1) {
-			CreateMovement(actor, formationPoints[i], append, tryToRun);
-		} else {
-			CreateMovement(actor, p, append, tryToRun);
-		}
+		Point dest = formation && party.size() > 1 ? formationPoints[i] : p;
+		int distance = CreateMovement(actor, dest, append, tryToRun);
 
 		// don't trigger the travel region, so everyone can bunch up there and NIDSpecial2 can take over
 		if (doWorldMap) actor->SetInternalFlag(IF_PST_WMAPPING, BitOp::OR);
+
+		if (distance < 0 || actor->GetCurrentArea() != party[0]->GetCurrentArea()) continue;
+		PathRequest request;
+		request.start = actor->Pos;
+		request.dest = dest;
+		request.size = actor->circleSize;
+		request.minDistance = distance;
+		request.flags = PF_SIGHT | PF_ACTORS_ARE_BLOCKING;
+		request.caller = actor;
+		paths.push_back(std::move(request));
+	}
+
+	// search all the paths at once, instead of one per actor when their moves start
+	if (paths.size() > 1) {
+		PlanPartyPaths(party[0]->GetCurrentArea(), paths);
 	}
 
 	// p is a searchmap travel region or a plain travel region in pst (matching several other criteria)
@@ -2402,6 +2423,17 @@ void GameControl::CommandSelectedMovement(const Point& p, bool formation, bool a
 		party[0]->AddAction("NIDSpecial2()");
 	}
 }
+// the searches run in the background and are handed over at the start of the next area
+// update, so the actors then take the paths from their MoveToPoint; each search only
+// ignores its own actor, the rest of the party still blocks it
+void GameControl::PlanPartyPaths(Map* area, std::vector<PathRequest>& paths) const
+{
+	for (PathRequest& request : paths) {
+		area->QueuePath(std::move(request));
+	}
+	area->DispatchPaths();
+}
+
 bool GameControl::OnMouseWheelScroll(const Point& delta)
 {
 	// Game coordinates start at the top left to the bottom right
@@ -47,6 +47,7 @@ class Door;
 class InfoPoint;
 class Map;
 class Movable;
+struct PathRequest;
 
 /**
  * @class GameControl
@@ -205,8 +206,9 @@ public:
 	void MakeSelection(bool extend = false);
 	void InitFormation(const Point&, bool rotating);
 	Point GetFormationOffset(size_t formation, uint8_t pos) const;
-	/** calls MoveToPoint or RunToPoint */
-	void CreateMovement(Actor* actor, const Point& p, bool append = true, bool tryToRun = false) const;
+	/** calls MoveToPoint or RunToPoint, returns the distance they will pass to WalkTo or -1 for waypoints */
+	int CreateMovement(Actor* actor, const Point& p, bool append = true, bool tryToRun = false) const;
+	void PlanPartyPaths(Map* area, std::vector<PathRequest>& paths) const;
 	bool ShouldTriggerWorldMap(const Actor* pc) const;
 	/** checks if the actor should be running instead of walking */
 	bool CanRun(const Actor* actor) const;
@@ -24,6 +24,7 @@
 
 #include "DisplayMessage.h"
 #include "Game.h"
+#include "GameData.h"
 #include "Interface.h"
 #include "WorldMap.h"
 
@@ -32,6 +33,9 @@
 
 namespace GemRB {
 
+// how long the pointer has to rest on an area before it is prefetched
+static constexpr tick_t PREFETCH_DELAY = 300;
+
 WorldMapControl::WorldMapControl(const Region& frame, Holder<Font> font, const Color& normal, const Color& selected, const Color& notvisited)
 	: Control(frame), ftext(std::move(font))
 {
@@ -244,6 +248,14 @@ bool WorldMapControl::OnMouseOver(const MouseEvent& me)
 			if (!str.empty() && hours >= 0) {
 				SetTooltip(fmt::format(u"{}: {}", str, hours));
 			}
+			// the player is likely to pick it if the pointer stays, so start reading it then
+			pendingPrefetch = std::make_shared<ResRef>(Area->AreaResRef);
+			std::weak_ptr<ResRef> pending = pendingPrefetch;
+			EventHandler h = [pending]() {
+				auto area = pending.lock();
+				if (area) gamedata->PrefetchArea(*area);
+			};
+			core->SetTimer(h, PREFETCH_DELAY, 0);
 		}
 		break;
 	}
@@ -266,6 +278,7 @@ bool WorldMapControl::OnMouseDrag(const MouseEvent& me)
 void WorldMapControl::OnMouseLeave(const MouseEvent& me, const DragOp* op)
 {
 	Area = NULL;
+	pendingPrefetch = nullptr;
 	Control::OnMouseLeave(me, op);
 }
 
@@ -64,6 +64,10 @@ public:
 	Holder<Sprite2D> areaIndicator;
 	ColorAnimation hoverAnim;
 
+private:
+	// the hovered area, until the timer prefetching it fires
+	std::shared_ptr<ResRef> pendingPrefetch;
+
 protected:
 	/** Mouse Over Event */
 	bool OnMouseOver(const MouseEvent& /*me*/) override;
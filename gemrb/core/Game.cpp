@@ -35,6 +35,7 @@
 #include "MusicMgr.h"
 #include "Particles.h"
 #include "PluginMgr.h"
+#include "ResourceSource.h"
 #include "ScriptEngine.h"
 #include "Spell.h"
 #include "TableMgr.h"
@@ -745,6 +746,8 @@ void Game::SetMasterArea(const ResRef& area)
 
 int Game::AddMap(Map* map)
 {
+	// named area variables of this area are now accessible
+	VariablesChanged();
 	if (MasterArea(map->GetScriptRef())) {
 		Maps.insert(Maps.begin(), 1, map);
 		MapIndex++;
@@ -827,6 +830,7 @@ int Game::DelMap(unsigned int index, int forced)
 	core->SwapoutArea(Maps[index]);
 	delete Maps[index];
 	Maps.erase(Maps.begin() + index);
+	VariablesChanged();
 	// current map will be decreased
 	if (MapIndex > (int) index) {
 		MapIndex--;
@@ -867,6 +871,8 @@ int Game::LoadMap(const ResRef& resRef, bool loadscreen)
 		sE->RunFunction("LoadScreen", "SetLoadScreen");
 	}
 
+	// it may have just been swapped out
+	core->cacheWriter.Wait(PathJoinExt(core->config.CachePath, resRef, TypeExt(IE_ARE_CLASS_ID)));
 	if (core->saveGameAREExtractor.extractARE(resRef) != GEM_OK) {
 		core->LoadProgress(100);
 		return GEM_ERROR;
@@ -880,10 +886,13 @@ int Game::LoadMap(const ResRef& resRef, bool loadscreen)
 	}
 
 	Map* newMap = mM->GetMap(resRef, IsDay());
+	// whatever was read ahead was either used now or isn't needed anymore
+	gamedata->DropPrefetched();
 	if (!newMap) {
 		core->LoadProgress(100);
 		return GEM_ERROR;
 	}
+	newMap->BuildPathClusters();
 
 	int ret = AddMap(newMap);
 
@@ -907,6 +916,7 @@ int Game::LoadMap(const ResRef& resRef, bool loadscreen)
 	}
 
 	core->GetAudioDrv()->SetReverbProperties(newMap->GetReverbProperties());
+	gamedata->LogFactoryStats();
 
 	core->LoadProgress(100);
 	return ret;
@@ -1397,6 +1407,7 @@ void Game::IncrementChapter()
 	} else if (!core->HasFeature(GFFlags::NO_NEW_VARIABLES)) {
 		locals["CHAPTER"] = 0;
 	}
+	VariablesChanged();
 
 	//clear statistics
 	for (const auto& pc : PCs) {
@@ -1606,6 +1617,8 @@ void Game::UpdateScripts()
 
 	for (size_t idx = 0; idx < Maps.size(); idx++) {
 		Maps[idx]->UpdateScripts();
+		// searched in the background until the next update
+		Maps[idx]->DispatchPaths();
 	}
 
 	bool combatEnded = false;
@@ -1729,6 +1742,7 @@ void Game::TextDream()
 		}
 
 		locals["DREAM"] = dream + 1;
+		VariablesChanged();
 		core->SetEventFlag(EF_TEXTSCREEN);
 	}
 }
@@ -252,6 +252,7 @@ public:
 	std::vector<Actor*> selected;
 	int version = 0;
 	kaputz_t kaputz;
+	mutable VariableSlots kaputzSlots;
 	std::array<ieByte, BESTIARY_SIZE> beasts;
 	ieByte* mazedata = nullptr; //only in PST
 	ieDword CombatCounter = 0;
@@ -308,6 +309,7 @@ private:
 	void LoadCRTable();
 	Actor* timestopper = nullptr;
 	ieDword timestopEnd = 0;
+	unsigned int variablesEpoch = 0;
 
 public:
 	/** Returns the PC's slot count for partyID */
@@ -373,6 +375,9 @@ public:
 	 * if you want to change the pathfinder too. */
 	int LoadMap(const ResRef& resRef, bool loadScreen);
 	int DelMap(unsigned int index, int forced = 0);
+	/** Call after changing any script variable (in any scope), so cached trigger results get reevaluated */
+	void VariablesChanged() { variablesEpoch++; }
+	unsigned int GetVariablesEpoch() const { return variablesEpoch; }
 	int AddNPC(Actor* npc);
 	Actor* GetNPC(unsigned int Index) const;
 	void SwapPCs(unsigned int pc1, unsigned int pc2) const;
@@ -35,6 +35,7 @@
 #include "Interface.h"
 #include "Item.h"
 #include "ItemMgr.h"
+#include "MapMgr.h"
 #include "PluginMgr.h"
 #include "ResourceSource.h"
 #include "ScriptedAnimation.h"
@@ -53,6 +54,9 @@ GEM_EXPORT GameData* gamedata;
 
 GameData::~GameData()
 {
+	// the worker uses the resource lookups
+	DropPrefetched(true);
+	LogFactoryStats();
 	PaletteCache.clear();
 
 	while (!stores.empty()) {
@@ -325,13 +329,72 @@ Holder<Sprite2D> GameData::GetAnySprite(const ResRef& resRef, int cycle, int fra
 	return img;
 }
 
+void GameData::PrefetchArea(const ResRef& areaName)
+{
+	if (areaName.IsEmpty() || areaName == prefetchedArea) return;
+
+	const Game* game = core->GetGame();
+	if (!game || game->FindMap(areaName) >= 0) return;
+
+	// only keep one area around, the party can't head for more at once
+	DropPrefetched();
+	prefetchedArea = areaName;
+
+	// everything else happens on the worker, including the extraction and the header parsing
+	prefetcher.QueueJob([this, areaName]() {
+		std::vector<ResourcePrefetcher::Request> requests;
+		// the area itself is small and can come from the save, so it is only used for the list
+		core->cacheWriter.Wait(PathJoinExt(core->config.CachePath, areaName, TypeExt(IE_ARE_CLASS_ID)));
+		if (core->saveGameAREExtractor.extractARE(areaName) != GEM_OK) return requests;
+		DataStream* ds = GetResourceStream(areaName, IE_ARE_CLASS_ID, true);
+		auto mM = GetImporter<MapMgr>(IE_ARE_CLASS_ID, ds);
+		if (!mM) return requests;
+
+		std::vector<std::pair<ResRef, SClass_ID>> resources;
+		mM->ListResources(resources);
+		for (const auto& resource : resources) {
+			if (prefetcher.IsQueued(resource.first, resource.second)) continue;
+			DataStream* stream = GetResourceStream(resource.first, resource.second, true);
+			if (stream) requests.push_back({ resource.first, resource.second, stream });
+		}
+		Log(DEBUG, "GameData", "Prefetching {} resources for {}.", requests.size(), areaName);
+		return requests;
+	});
+}
+
+void GameData::PrefetchTables(const std::vector<ResRef>& tables)
+{
+	for (const auto& table : tables) {
+		if (prefetcher.IsQueued(table, IE_2DA_CLASS_ID)) continue;
+		DataStream* stream = GetResourceStream(table, IE_2DA_CLASS_ID, true);
+		if (stream) prefetcher.Queue(table, IE_2DA_CLASS_ID, stream);
+	}
+}
+
+void GameData::LogFactoryStats()
+{
+	const Factory::Stats& stats = factory.GetStats();
+	Log(DEBUG, "GameData", "Factory: {} hits, {} misses, {} evictions, {} objects of {} KiB (budget {} KiB).",
+	    stats.hits, stats.misses, stats.evictions, stats.objects, stats.bytes / 1024, Factory::MAX_BYTES / 1024);
+	const AnimationFactory::CycleStats& cycles = AnimationFactory::GetCycleStats();
+	Log(DEBUG, "GameData", "Animation cycles: {} shared, {} built, {} frame sets with {} frames ({} mirrored).",
+	    cycles.hits, cycles.misses, cycles.frameSets, cycles.frames, cycles.mirroredFrames);
+}
+
+void GameData::DropPrefetched(bool waitForWorker)
+{
+	prefetcher.Clear();
+	prefetchedArea.Reset();
+	if (waitForWorker) prefetcher.WaitForJobs();
+}
+
 Factory::object_t GameData::GetFactoryResource(const ResRef& resName, SClass_ID type, bool silent)
 {
 	if (resName.IsEmpty()) return nullptr;
 
 	// already cached?
-	int objectIndex = factory.IsLoaded(resName, type);
-	if (objectIndex != -1) return factory.GetFactoryObject(objectIndex);
+	auto cached = factory.GetFactoryObject(resName, type);
+	if (cached) return cached;
 
 	switch (type) {
 		case IE_BAM_CLASS_ID:
@@ -139,12 +139,17 @@ public:
 		return std::static_pointer_cast<T>(GetFactoryResource(resName, type, silent));
 	}
 
+	const Factory::Stats& GetFactoryStats() { return factory.GetStats(); }
+	/** logged whenever an area was loaded, to keep an eye on the factory budget */
+	void LogFactoryStats();
+
 	template<typename T, typename... ARGS>
 	std::shared_ptr<T> AddFactoryResource(ARGS&&... args)
 	{
 		static_assert(std::is_base_of<FactoryObject, T>::value, "T must be a FactoryObject.");
 		auto obj = std::make_shared<T>(std::forward<ARGS>(args)...);
-		factory.AddFactoryObject(obj);
+		// there's no resource to rebuild it from
+		factory.AddFactoryObject(obj, false);
 		return obj;
 	}
 
@@ -194,6 +199,15 @@ public:
 	inline int GetTextSpeed() const { return TextScreenSpeed; }
 	inline void SetTextSpeed(int speed) { TextScreenSpeed = speed; }
 
+	/** reads the resources of an area in the background, ahead of loading it */
+	void PrefetchArea(const ResRef& areaName);
+	/** looks up and reads the given tables in the background, so LoadTable finds them ready;
+	 * safe to call from another thread once the search path is complete */
+	void PrefetchTables(const std::vector<ResRef>& tables);
+	/** drops the prefetched data, once it was used or could go stale,
+	 * waiting for the area lookup in progress if it mustn't overlap with the caller */
+	void DropPrefetched(bool waitForWorker = false);
+
 private:
 	void ReadItemSounds();
 	void ReadSpellProtTable();
@@ -222,6 +236,7 @@ private:
 	std::array<std::array<std::array<int, 7>, 4>, 4> weaponStyleBoni {};
 	ResRefMap<ieByte> itemAnims;
 	std::vector<ItemUseType> itemUse;
+	ResRef prefetchedArea;
 
 public:
 	std::vector<ResRef> defaultSounds;
@@ -118,12 +118,12 @@ void GameScript::NoAction(Scriptable* /*Sender*/, Action* /*parameters*/)
 
 void GameScript::SG(Scriptable* Sender, Action* parameters)
 {
-	SetVariable(Sender, parameters->string0Parameter, parameters->int0Parameter, "GLOBAL");
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->int0Parameter, "GLOBAL");
 }
 
 void GameScript::SetGlobal(Scriptable* Sender, Action* parameters)
 {
-	SetVariable(Sender, parameters->string0Parameter, parameters->int0Parameter);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->int0Parameter);
 }
 
 void GameScript::SetGlobalRandom(Scriptable* Sender, Action* parameters)
@@ -137,7 +137,7 @@ void GameScript::SetGlobalRandom(Scriptable* Sender, Action* parameters)
 	} else if (max > 0) {
 		value = RandomNumValue % max + parameters->int0Parameter; // should be +1 instead?
 	}
-	SetVariable(Sender, parameters->string0Parameter, value, parameters->resref1Parameter);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value, parameters->resref1Parameter);
 }
 
 void GameScript::StartTimer(Scriptable* Sender, Action* parameters)
@@ -156,7 +156,7 @@ void GameScript::SetGlobalTimer(Scriptable* Sender, Action* parameters)
 	ieDword mytime;
 
 	mytime = core->GetGame()->GameTime; //gametime (should increase it)
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    parameters->int0Parameter * core->Time.defaultTicksPerSec + mytime);
 }
 
@@ -175,17 +175,17 @@ void GameScript::SetGlobalTimerRandom(Scriptable* Sender, Action* parameters)
 		random = RandomNumValue % random + parameters->int1Parameter;
 	}
 	mytime = core->GetGame()->GameTime; //gametime (should increase it)
-	SetVariable(Sender, parameters->string0Parameter, random * core->Time.defaultTicksPerSec + mytime);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, random * core->Time.defaultTicksPerSec + mytime);
 }
 
 void GameScript::SetGlobalTimerOnce(Scriptable* Sender, Action* parameters)
 {
-	ieDword mytime = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword mytime = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	if (mytime != 0) {
 		return;
 	}
 	mytime = core->GetGame()->GameTime; //gametime (should increase it)
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    parameters->int0Parameter * core->Time.defaultTicksPerSec + mytime);
 }
 
@@ -193,7 +193,7 @@ void GameScript::RealSetGlobalTimer(Scriptable* Sender, Action* parameters)
 {
 	ieDword mytime = core->GetGame()->RealTime;
 
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    parameters->int0Parameter * core->Time.defaultTicksPerSec + mytime);
 }
 
@@ -415,7 +415,7 @@ void GameScript::ChangeStatGlobal(Scriptable* Sender, Action* parameters)
 	if (!actor) {
 		return;
 	}
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter);
 	if (parameters->int1Parameter == 1) {
 		value += actor->GetBase(parameters->int0Parameter);
 	}
@@ -1067,7 +1067,7 @@ void GameScript::CreateCreatureAtLocation(Scriptable* Sender, Action* parameters
 	if (parameters->variable0Parameter.IsEmpty()) {
 		parameters->variable0Parameter = "LOCALSsavedlocation";
 	}
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	parameters->pointParameter.y = (ieWord) (value & 0xffff);
 	parameters->pointParameter.x = (ieWord) (value >> 16);
 	CreateCreatureCore(Sender, parameters, CC_CHECK_IMPASSABLE | CC_STRING1);
@@ -2170,7 +2170,7 @@ void GameScript::PlaySequence(Scriptable* Sender, Action* parameters)
 //same as PlaySequence, but the value comes from a variable
 void GameScript::PlaySequenceGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	PlaySequenceCore(Sender, parameters, value);
 }
 
@@ -2864,7 +2864,7 @@ void GameScript::UnMakeGlobal(Scriptable* Sender, Action* /*parameters*/)
 //this apparently doesn't check the gold, thus could be used from non actors
 void GameScript::GivePartyGoldGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword gold = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter);
+	ieDword gold = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter);
 	Actor* act = Scriptable::As<Actor>(Sender);
 	if (act) {
 		ieDword mygold = act->GetStat(IE_GOLD);
@@ -2937,7 +2937,7 @@ void GameScript::GiveObjectGoldGlobal(Scriptable* Sender, Action* parameters)
 	Actor* actor = Scriptable::As<Actor>(tar);
 	if (!actor) return;
 
-	ieDword gold = CheckVariable(Sender, parameters->string0Parameter, parameters->resref1Parameter);
+	ieDword gold = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->resref1Parameter);
 	actor->SetBase(IE_GOLD, actor->GetBase(IE_GOLD) + gold);
 	// no need to nullify the var, it was done manually
 }
@@ -3000,7 +3000,7 @@ void GameScript::AddExperiencePartyCR(Scriptable* /*Sender*/, Action* parameters
 
 void GameScript::AddExperiencePartyGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword xp = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter);
+	ieDword xp = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter);
 	core->GetGame()->ShareXP(xp, SX_DIVIDE);
 	core->GetAudioPlayback().PlayDefaultSound(DS_GOTXP, SFXChannel::Actions);
 }
@@ -3286,7 +3286,7 @@ void GameScript::SetToken(Scriptable* /*Sender*/, Action* parameters)
 //Assigns a numeric variable to the token
 void GameScript::SetTokenGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	SetTokenAsString(parameters->variable1Parameter, value);
 }
 
@@ -3403,16 +3403,16 @@ void GameScript::AnkhegHide(Scriptable* Sender, Action* /*parameters*/)
 
 void GameScript::GlobalSetGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
-	SetVariable(Sender, parameters->string1Parameter, value);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	SetVariable(Sender, parameters->string1Parameter, parameters->symbol1, value);
 }
 
 /* adding the second variable to the first, they must be GLOBAL */
 void GameScript::AddGlobals(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL");
-	SetVariable(Sender, parameters->string0Parameter, value1 + value2, "GLOBAL");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "GLOBAL");
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 + value2, "GLOBAL");
 }
 
 /* adding the second variable to the first, they could be area or locals */
@@ -3422,14 +3422,14 @@ void GameScript::GlobalAddGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 + value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 + value2);
 }
 
 /* adding the number to the global, they could be area or locals */
 void GameScript::IncrementGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
-	SetVariable(Sender, parameters->string0Parameter,
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    value + parameters->int0Parameter);
 }
 
@@ -3437,14 +3437,14 @@ void GameScript::IncrementGlobal(Scriptable* Sender, Action* parameters)
 // only user: 0901tria.baf:    IncrementGlobalOnce("Evil_Trias_2","GLOBAL","Good","GLOBAL",-1)
 void GameScript::IncrementGlobalOnce(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	if (value != 0) {
 		return;
 	}
-	SetVariable(Sender, parameters->string0Parameter, 1);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, 1);
 
-	value = CheckVariable(Sender, parameters->string1Parameter);
-	SetVariable(Sender, parameters->string1Parameter, ieDword(int(value) + parameters->int0Parameter));
+	value = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1);
+	SetVariable(Sender, parameters->string1Parameter, parameters->symbol1, ieDword(int(value) + parameters->int0Parameter));
 }
 
 void GameScript::GlobalSubGlobal(Scriptable* Sender, Action* parameters)
@@ -3453,7 +3453,7 @@ void GameScript::GlobalSubGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 - value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 - value2);
 }
 
 void GameScript::GlobalAndGlobal(Scriptable* Sender, Action* parameters)
@@ -3462,7 +3462,7 @@ void GameScript::GlobalAndGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 && value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 && value2);
 }
 
 void GameScript::GlobalOrGlobal(Scriptable* Sender, Action* parameters)
@@ -3471,7 +3471,7 @@ void GameScript::GlobalOrGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 || value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 || value2);
 }
 
 void GameScript::GlobalBOrGlobal(Scriptable* Sender, Action* parameters)
@@ -3480,7 +3480,7 @@ void GameScript::GlobalBOrGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 | value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 | value2);
 }
 
 void GameScript::GlobalBAndGlobal(Scriptable* Sender, Action* parameters)
@@ -3489,7 +3489,7 @@ void GameScript::GlobalBAndGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 & value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 & value2);
 }
 
 void GameScript::GlobalXorGlobal(Scriptable* Sender, Action* parameters)
@@ -3498,14 +3498,14 @@ void GameScript::GlobalXorGlobal(Scriptable* Sender, Action* parameters)
 				       parameters->string0Parameter);
 	ieDword value2 = CheckVariable(Sender,
 				       parameters->string1Parameter);
-	SetVariable(Sender, parameters->string0Parameter, value1 ^ value2);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1 ^ value2);
 }
 
 void GameScript::GlobalBOr(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable(Sender,
 				       parameters->string0Parameter);
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    value1 | parameters->int0Parameter);
 }
 
@@ -3513,7 +3513,7 @@ void GameScript::GlobalBAnd(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable(Sender,
 				       parameters->string0Parameter);
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    value1 & parameters->int0Parameter);
 }
 
@@ -3521,23 +3521,23 @@ void GameScript::GlobalXor(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable(Sender,
 				       parameters->string0Parameter);
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    value1 ^ parameters->int0Parameter);
 }
 
 void GameScript::GlobalMax(Scriptable* Sender, Action* parameters)
 {
-	int value1 = CheckVariable(Sender, parameters->string0Parameter);
+	int value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	if (value1 > parameters->int0Parameter) {
-		SetVariable(Sender, parameters->string0Parameter, value1);
+		SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 	}
 }
 
 void GameScript::GlobalMin(Scriptable* Sender, Action* parameters)
 {
-	int value1 = CheckVariable(Sender, parameters->string0Parameter);
+	int value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	if (value1 < parameters->int0Parameter) {
-		SetVariable(Sender, parameters->string0Parameter, value1);
+		SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 	}
 }
 
@@ -3545,7 +3545,7 @@ void GameScript::BitClear(Scriptable* Sender, Action* parameters)
 {
 	ieDword value1 = CheckVariable(Sender,
 				       parameters->string0Parameter);
-	SetVariable(Sender, parameters->string0Parameter,
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0,
 		    value1 & ~parameters->int0Parameter);
 }
 
@@ -3559,7 +3559,7 @@ void GameScript::GlobalShL(Scriptable* Sender, Action* parameters)
 	} else {
 		value1 <<= value2;
 	}
-	SetVariable(Sender, parameters->string0Parameter, value1);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 }
 
 void GameScript::GlobalShR(Scriptable* Sender, Action* parameters)
@@ -3572,48 +3572,48 @@ void GameScript::GlobalShR(Scriptable* Sender, Action* parameters)
 	} else {
 		value1 >>= value2;
 	}
-	SetVariable(Sender, parameters->string0Parameter, value1);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 }
 
 void GameScript::GlobalMaxGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter);
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1);
 	if (value1 < value2) {
-		SetVariable(Sender, parameters->string0Parameter, value2);
+		SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value2);
 	}
 }
 
 void GameScript::GlobalMinGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter);
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1);
 	if (value1 > value2) {
-		SetVariable(Sender, parameters->string0Parameter, value2);
+		SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value2);
 	}
 }
 
 void GameScript::GlobalShLGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter);
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1);
 	if (value2 > 31) {
 		value1 = 0;
 	} else {
 		value1 <<= value2;
 	}
-	SetVariable(Sender, parameters->string0Parameter, value1);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 }
 void GameScript::GlobalShRGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter);
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1);
 	if (value2 > 31) {
 		value1 = 0;
 	} else {
 		value1 >>= value2;
 	}
-	SetVariable(Sender, parameters->string0Parameter, value1);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 }
 
 void GameScript::ClearAllActions(Scriptable* Sender, Action* /*parameters*/)
@@ -3765,17 +3765,17 @@ void GameScript::SetTextColor(Scriptable* /*Sender*/, Action* parameters)
 
 void GameScript::BitGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	HandleBitMod(value, parameters->int0Parameter, BitOp(parameters->int1Parameter));
-	SetVariable(Sender, parameters->string0Parameter, value);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value);
 }
 
 void GameScript::GlobalBitGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter);
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1);
 	HandleBitMod(value1, value2, BitOp(parameters->int1Parameter));
-	SetVariable(Sender, parameters->string0Parameter, value1);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value1);
 }
 
 void GameScript::SetVisualRange(Scriptable* Sender, Action* parameters)
@@ -4285,7 +4285,7 @@ void GameScript::CreateItemNumGlobal(Scriptable* Sender, Action* parameters)
 		default:
 			return;
 	}
-	int value = CheckVariable(Sender, parameters->string0Parameter);
+	int value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0);
 	CREItem* item = new CREItem();
 	if (!CreateItemCore(item, parameters->resref1Parameter, value, 0, 0)) {
 		delete item;
@@ -6526,7 +6526,7 @@ void GameScript::GetStat(Scriptable* Sender, Action* parameters)
 	if (actor) {
 		value = actor->GetStat(parameters->int0Parameter);
 	}
-	SetVariable(Sender, parameters->string0Parameter, value);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value);
 }
 
 void GameScript::BreakInstants(Scriptable* Sender, Action* /*parameters*/)
@@ -0,0 +1,433 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "CompiledScript.h"
+
+#include "GSUtils.h"
+#include "GameScript.h"
+#include "Interface.h"
+#include "MurmurHash.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
+#include "System/VFS.h"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace GemRB {
+
+// the files are only used on the machine that wrote them, so everything is stored in native byte order
+static const char scriptMagic[8] = { 'G', 'E', 'M', 'B', 'C', 'S', 'C', '2' };
+static constexpr uint32_t SCRIPT_VERSION = 2;
+const path_t CompiledScriptDir = "scripts";
+static const path_t stampName = "fingerprint";
+// more than any game has, so it is only reached by entries of since edited scripts piling up
+static constexpr size_t MAX_COMPILED_SCRIPTS = 8192;
+
+// everything the parser output depends on besides the text
+static uint32_t ParserFingerprint()
+{
+	Hasher hasher;
+	hasher.Feed(SCRIPT_VERSION);
+	hasher.Feed(HasTriggerPoint);
+	hasher.Feed(HasAdditionalRect);
+	hasher.Feed(ObjectFieldsCount);
+	hasher.Feed(MaxObjectNesting);
+	hasher.Feed(ExtraParametersCount);
+	hasher.Feed(NextTriggerObjectID);
+	for (short flags : triggerflags) {
+		hasher.Feed(uint16_t(flags));
+	}
+	for (uint16_t flags : actionflags) {
+		hasher.Feed(flags);
+	}
+	return hasher.GetHash().value;
+}
+
+// identifies the script text, it is checked again on load, so a name clash can't return the wrong script
+struct ScriptSource {
+	uint64_t size = 0;
+	uint64_t digest = 0;
+
+	ScriptSource(const char* text, size_t size)
+		: size(size)
+	{
+		// 64 bit FNV-1a
+		digest = 0xcbf29ce484222325ULL;
+		for (size_t i = 0; i < size; ++i) {
+			digest = (digest ^ uint8_t(text[i])) * 0x100000001b3ULL;
+		}
+	}
+};
+
+static path_t CompiledScriptPath(const ScriptSource& source)
+{
+	path_t name = fmt::format("{:08x}{:016x}.bin", uint32_t(source.size), source.digest);
+	return PathJoin(core->config.CachePath, CompiledScriptDir, name);
+}
+
+static uint32_t ReadStamp(const path_t& dir)
+{
+	uint32_t stamp = 0;
+	FileStream* file = FileStream::OpenFile(PathJoin(dir, stampName));
+	if (file) {
+		if (file->Read(&stamp, sizeof(stamp)) != sizeof(stamp)) stamp = 0;
+		delete file;
+	}
+	return stamp;
+}
+
+// ClearCache leaves the directory alone, so it is emptied here once the parser
+// setup changed (eg. another game) or it grew too large
+static bool PrepareScriptDir()
+{
+	static int prepared = -1;
+	if (prepared != -1) return prepared;
+
+	path_t dir = PathJoin(core->config.CachePath, CompiledScriptDir);
+	if (!DirExists(dir) && !MakeDirectory(dir)) {
+		Log(ERROR, "GameScript", "Cannot create {}, not caching scripts.", dir);
+		prepared = 0;
+		return false;
+	}
+
+	uint32_t fingerprint = ParserFingerprint();
+	std::vector<path_t> entries;
+	DirectoryIterator files(dir);
+	files.SetFlags(DirectoryIterator::Files, true);
+	if (files) {
+		do {
+			if (files.GetName() != stampName) entries.push_back(files.GetFullPath());
+		} while (++files);
+	}
+	if (ReadStamp(dir) != fingerprint || entries.size() > MAX_COMPILED_SCRIPTS) {
+		for (const path_t& entry : entries) {
+			UnlinkFile(entry);
+		}
+		FileStream stamp;
+		if (!stamp.Create(PathJoin(dir, stampName)) || stamp.Write(&fingerprint, sizeof(fingerprint)) != sizeof(fingerprint)) {
+			Log(ERROR, "GameScript", "Cannot write to {}, not caching scripts.", dir);
+			prepared = 0;
+			return false;
+		}
+	}
+	prepared = 1;
+	return true;
+}
+
+class ScriptWriter {
+public:
+	template<typename T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_array<T>::value, "only plain values");
+		data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	void WriteString(const StringParam& str)
+	{
+		uint8_t len = uint8_t(str.length());
+		Write(len);
+		data.append(str.c_str(), len);
+	}
+
+	void WritePoint(const Point& p)
+	{
+		Write(p.x);
+		Write(p.y);
+	}
+
+	void WriteObject(const Object* object)
+	{
+		Write(uint8_t(object != nullptr));
+		if (!object) return;
+		for (int field : object->objectFields) {
+			Write(field);
+		}
+		for (int filter : object->objectFilters) {
+			Write(filter);
+		}
+		WritePoint(object->objectRect.origin);
+		Write(object->objectRect.size.w);
+		Write(object->objectRect.size.h);
+		WriteString(object->objectName);
+	}
+
+	std::string data;
+};
+
+// takes care of truncated or damaged data, which is just rejected
+class ScriptReader {
+public:
+	ScriptReader(const char* data, size_t size)
+		: pos(data), end(data + size) {}
+
+	template<typename T>
+	bool Read(T& value)
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_array<T>::value, "only plain values");
+		if (size_t(end - pos) < sizeof(T)) return false;
+		memcpy(&value, pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	bool ReadString(StringParam& str)
+	{
+		uint8_t len = 0;
+		if (!Read(len) || len > StringParam::Size || size_t(end - pos) < len) return false;
+		str.Reset();
+		memcpy(str.begin(), pos, len);
+		pos += len;
+		return true;
+	}
+
+	bool ReadPoint(Point& p)
+	{
+		return Read(p.x) && Read(p.y);
+	}
+
+	// arena is null for the objects of actions, see DecodeObject
+	bool ReadObject(Object*& object, ScriptArena* arena)
+	{
+		uint8_t present = 0;
+		if (!Read(present)) return false;
+		if (!present) return true;
+
+		object = arena ? new (*arena) Object() : new Object();
+		for (int& field : object->objectFields) {
+			if (!Read(field)) return false;
+		}
+		for (int& filter : object->objectFilters) {
+			if (!Read(filter)) return false;
+		}
+		Point origin;
+		Size size;
+		if (!ReadPoint(origin) || !Read(size.w) || !Read(size.h) || !ReadString(object->objectName)) return false;
+		object->objectRect = Region(origin, size);
+		return true;
+	}
+
+	// every element takes at least a byte, so bigger counts can only come from damaged data
+	bool ReadCount(uint32_t& count)
+	{
+		return Read(count) && count <= size_t(end - pos);
+	}
+
+	bool AtEnd() const { return pos == end; }
+
+private:
+	const char* pos;
+	const char* end;
+};
+
+static void WriteTrigger(ScriptWriter& writer, const Trigger* tR)
+{
+	writer.Write(tR->triggerID);
+	writer.Write(tR->int0Parameter);
+	writer.Write(tR->flags);
+	writer.Write(tR->int1Parameter);
+	writer.Write(tR->int2Parameter);
+	writer.WritePoint(tR->pointParameter);
+	writer.WriteObject(tR->objectParameter);
+	writer.WriteString(tR->string0Parameter);
+	writer.WriteString(tR->string1Parameter);
+}
+
+static void WriteAction(ScriptWriter& writer, const Action* aC)
+{
+	writer.Write(aC->actionID);
+	for (const Object* object : aC->objects) {
+		writer.WriteObject(object);
+	}
+	writer.Write(aC->int0Parameter);
+	writer.WritePoint(aC->pointParameter);
+	writer.Write(aC->int1Parameter);
+	writer.Write(aC->int2Parameter);
+	writer.WriteString(aC->string0Parameter);
+	writer.WriteString(aC->string1Parameter);
+	writer.Write(aC->flags);
+}
+
+std::string WriteCompiledScript(const Script& script, const char* text, size_t size)
+{
+	ScriptSource source(text, size);
+	ScriptWriter writer;
+	writer.data.append(scriptMagic, sizeof(scriptMagic));
+	writer.Write(ParserFingerprint());
+	writer.Write(source.size);
+	writer.Write(source.digest);
+	writer.Write(uint32_t(script.responseBlocks.size()));
+	for (const ResponseBlock* rB : script.responseBlocks) {
+		const Condition* cO = rB->condition;
+		writer.Write(uint8_t(cO != nullptr));
+		if (cO) {
+			writer.Write(uint32_t(cO->triggers.size()));
+			for (const Trigger* tR : cO->triggers) {
+				WriteTrigger(writer, tR);
+			}
+		}
+
+		const ResponseSet* rS = rB->responseSet;
+		writer.Write(uint8_t(rS != nullptr));
+		if (!rS) continue;
+		writer.Write(uint32_t(rS->responses.size()));
+		for (const Response* rE : rS->responses) {
+			writer.Write(rE->weight);
+			writer.Write(uint32_t(rE->actions.size()));
+			for (const Action* aC : rE->actions) {
+				WriteAction(writer, aC);
+			}
+		}
+	}
+	return std::move(writer.data);
+}
+
+static Trigger* ReadTrigger(ScriptReader& reader, ScriptArena& arena)
+{
+	Trigger* tR = new (arena) Trigger();
+	bool ok = reader.Read(tR->triggerID) && reader.Read(tR->int0Parameter) && reader.Read(tR->flags) &&
+		reader.Read(tR->int1Parameter) && reader.Read(tR->int2Parameter) && reader.ReadPoint(tR->pointParameter) &&
+		reader.ReadObject(tR->objectParameter, &arena) && reader.ReadString(tR->string0Parameter) && reader.ReadString(tR->string1Parameter);
+	if (!ok || tR->triggerID >= MAX_TRIGGERS) {
+		tR->Release();
+		return nullptr;
+	}
+	return tR;
+}
+
+static Action* ReadAction(ScriptReader& reader)
+{
+	// not autofreed, because it is referenced by the Script
+	Action* aC = new Action(false);
+	bool ok = reader.Read(aC->actionID);
+	for (Object*& object : aC->objects) {
+		ok = ok && reader.ReadObject(object, nullptr);
+	}
+	ok = ok && reader.Read(aC->int0Parameter) && reader.ReadPoint(aC->pointParameter) && reader.Read(aC->int1Parameter) &&
+		reader.Read(aC->int2Parameter) && reader.ReadString(aC->string0Parameter) && reader.ReadString(aC->string1Parameter) &&
+		reader.Read(aC->flags);
+	if (!ok || aC->actionID >= MAX_ACTIONS) {
+		aC->Release();
+		return nullptr;
+	}
+	return aC;
+}
+
+// on failure the caller releases what was read so far
+static bool ReadResponseBlock(ScriptReader& reader, ScriptArena& arena, ResponseBlock* rB)
+{
+	uint8_t present = 0;
+	uint32_t count = 0;
+	if (!reader.Read(present)) return false;
+	if (present) {
+		if (!reader.ReadCount(count)) return false;
+		rB->condition = new (arena) Condition();
+		rB->condition->triggers.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			Trigger* tR = ReadTrigger(reader, arena);
+			if (!tR) return false;
+			rB->condition->triggers.push_back(tR);
+		}
+	}
+
+	if (!reader.Read(present)) return false;
+	if (!present) return true;
+	if (!reader.ReadCount(count)) return false;
+	rB->responseSet = new (arena) ResponseSet();
+	rB->responseSet->responses.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		Response* rE = new (arena) Response();
+		rB->responseSet->responses.push_back(rE);
+		uint32_t actionCount = 0;
+		if (!reader.Read(rE->weight) || !reader.ReadCount(actionCount)) return false;
+		rE->actions.reserve(actionCount);
+		for (uint32_t j = 0; j < actionCount; ++j) {
+			Action* aC = ReadAction(reader);
+			if (!aC) return false;
+			rE->actions.push_back(aC);
+		}
+	}
+	return true;
+}
+
+bool ReadCompiledScript(const char* data, size_t size, const char* text, size_t textSize, Script& script)
+{
+	ScriptSource source(text, textSize);
+	ScriptReader reader(data, size);
+	char magic[sizeof(scriptMagic)];
+	uint32_t fingerprint = 0;
+	uint64_t sourceSize = 0;
+	uint64_t sourceDigest = 0;
+	uint32_t count = 0;
+	if (!reader.Read(magic) || memcmp(magic, scriptMagic, sizeof(magic)) != 0) return false;
+	if (!reader.Read(fingerprint) || fingerprint != ParserFingerprint()) return false;
+	if (!reader.Read(sourceSize) || sourceSize != source.size || !reader.Read(sourceDigest) || sourceDigest != source.digest) return false;
+	if (!reader.ReadCount(count)) return false;
+
+	script.responseBlocks.reserve(count);
+	bool ok = true;
+	for (uint32_t i = 0; ok && i < count; ++i) {
+		ResponseBlock* rB = new (script.arena) ResponseBlock();
+		script.responseBlocks.push_back(rB);
+		ok = ReadResponseBlock(reader, script.arena, rB);
+	}
+	if (ok && reader.AtEnd()) {
+		return true;
+	}
+
+	for (ResponseBlock* rB : script.responseBlocks) {
+		rB->Release();
+	}
+	script.responseBlocks.clear();
+	return false;
+}
+
+bool LoadCompiledScript(const char* text, size_t size, Script& script)
+{
+	if (!core->config.CacheScripts || !PrepareScriptDir()) return false;
+
+	path_t path = CompiledScriptPath(ScriptSource(text, size));
+	// it may have been stored and dropped from the script cache again this session
+	if (!core->cacheWriter.Wait(path)) return false;
+	FileStream* file = FileStream::OpenFile(path);
+	if (!file) return false;
+
+	std::string data(file->Size(), '\0');
+	bool ok = file->Read(&data[0], data.size()) == strret_t(data.size());
+	delete file;
+	return ok && ReadCompiledScript(data.data(), data.size(), text, size, script);
+}
+
+void StoreCompiledScript(const char* text, size_t size, const Script& script)
+{
+	if (!core->config.CacheScripts || !PrepareScriptDir()) return;
+
+	std::string data = WriteCompiledScript(script, text, size);
+	void* buffer = malloc(data.size());
+	memcpy(buffer, data.data(), data.size());
+	path_t path = CompiledScriptPath(ScriptSource(text, size));
+	core->cacheWriter.Write(path, new MemoryStream(path, buffer, data.size()));
+}
+
+}
@@ -0,0 +1,56 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef COMPILEDSCRIPT_H
+#define COMPILEDSCRIPT_H
+
+#include "exports.h"
+
+#include "System/VFS.h"
+
+#include <string>
+
+namespace GemRB {
+
+class Script;
+
+/**
+ * The parsed form of BCS scripts, which loads without any text parsing.
+ *
+ * It is stored in its own directory in the cache, in a file named after a
+ * hash of the script text, so override and modded scripts get their own
+ * entries. The text size and hash are checked on load too. Since the parsing
+ * depends on the game's trigger and action tables, the directory is emptied
+ * when those change. The CacheScripts option turns it off.
+ */
+// ClearCache keeps it, its cleanup is done here
+extern GEM_EXPORT const path_t CompiledScriptDir;
+
+// fills the empty script from the cached form of text, if there is one
+GEM_EXPORT bool LoadCompiledScript(const char* text, size_t size, Script& script);
+GEM_EXPORT void StoreCompiledScript(const char* text, size_t size, const Script& script);
+
+// the serialization itself, tied to the script text
+GEM_EXPORT std::string WriteCompiledScript(const Script& script, const char* text, size_t size);
+GEM_EXPORT bool ReadCompiledScript(const char* data, size_t size, const char* text, size_t textSize, Script& script);
+
+}
+
+#endif
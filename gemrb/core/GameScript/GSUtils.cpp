@@ -1738,6 +1738,8 @@ Action* ParamCopy(const Action* parameters)
 	newAction->pointParameter = parameters->pointParameter;
 	newAction->string0Parameter = parameters->string0Parameter;
 	newAction->string1Parameter = parameters->string1Parameter;
+	newAction->symbol0 = parameters->symbol0;
+	newAction->symbol1 = parameters->symbol1;
 	for (int c = 0; c < 3; c++) {
 		newAction->objects[c] = ObjectCopy(parameters->objects[c]);
 	}
@@ -1754,6 +1756,8 @@ Action* ParamCopyNoOverride(const Action* parameters)
 	newAction->pointParameter = parameters->pointParameter;
 	newAction->string0Parameter = parameters->string0Parameter;
 	newAction->string1Parameter = parameters->string1Parameter;
+	newAction->symbol0 = parameters->symbol0;
+	newAction->symbol1 = parameters->symbol1;
 	newAction->objects[0] = nullptr;
 	newAction->objects[1] = ObjectCopy(parameters->objects[1]);
 	newAction->objects[2] = ObjectCopy(parameters->objects[2]);
@@ -1768,10 +1772,14 @@ void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value,
 		auto lookup = vars.find(key);
 
 		if (lookup != vars.cend()) {
+			if (lookup->second == value) return;
 			lookup->second = value;
 		} else if (!NoCreate) {
 			vars[key] = value;
+		} else {
+			return;
 		}
+		core->GetGame()->VariablesChanged();
 	};
 
 	if (context.IsEmpty()) {
@@ -1869,6 +1877,135 @@ ieDword CheckVariable(const Scriptable* Sender, const StringParam& VarName, VarC
 	return 0;
 }
 
+// the same split into scope and name as in CheckVariable and SetVariable
+static void ResolveVariable(const StringParam& VarName, const VarContext& context, VariableSymbol& symbol)
+{
+	VarContext scope = context;
+	symbol.nameOffset = 0;
+	if (scope.IsEmpty()) {
+		symbol.nameOffset = 6;
+		//some HoW triggers use a : to separate the scope from the variable name
+		if (VarName[6] == ':') {
+			symbol.nameOffset++;
+		}
+		scope.Format("{:.6}", VarName);
+	}
+
+	if (scope == "MYAREA") {
+		symbol.scope = VarScope::Area;
+	} else if (scope == "LOCALS") {
+		symbol.scope = VarScope::Locals;
+	} else if (scope == "KAPUTZ") {
+		symbol.scope = VarScope::Kaputz;
+	} else if (scope == "GLOBAL") {
+		symbol.scope = VarScope::Global;
+	} else {
+		symbol.scope = VarScope::Named;
+	}
+
+	VariableSpace space = symbol.scope == VarScope::Locals ? VariableSpace::Local : VariableSpace::Shared;
+	symbol.id = InternVariable(ieVariable { &VarName[symbol.nameOffset] }, space);
+}
+
+void SetVariable(Scriptable* Sender, const StringParam& VarName, VariableSymbol& symbol, ieDword value, const VarContext& context)
+{
+	if (symbol.scope == VarScope::Unresolved) {
+		ResolveVariable(VarName, context, symbol);
+	}
+
+	Game* game = core->GetGame();
+	Scriptable* owner = nullptr;
+	ieVarsMap* vars = nullptr;
+	VariableSlots* slots = nullptr;
+	VariableSpace space = VariableSpace::Shared;
+	switch (symbol.scope) {
+		case VarScope::Area:
+			owner = Sender->GetCurrentArea();
+			break;
+		case VarScope::Locals:
+			owner = Sender;
+			space = VariableSpace::Local;
+			break;
+		case VarScope::Kaputz:
+			if (HasKaputz) {
+				vars = &game->kaputz;
+				slots = &game->kaputzSlots;
+			}
+			break;
+		case VarScope::Global:
+			owner = game;
+			break;
+		default:
+			break;
+	}
+	if (owner) {
+		vars = &owner->locals;
+		slots = &owner->localSlots;
+	}
+	if (!vars) {
+		SetVariable(Sender, VarName, value, context);
+		return;
+	}
+	ScriptDebugLog(DebugMode::VARIABLES, "Setting variable(\"{}{}\", {})", context, VarName, value);
+
+	const char* name = &VarName[symbol.nameOffset];
+	ieDword* slot = slots->Get(*vars, space, symbol.id, name, false);
+	if (slot) {
+		if (*slot == value) return;
+		*slot = value;
+	} else if (!NoCreate) {
+		*slots->Get(*vars, space, symbol.id, name, true) = value;
+	} else {
+		return;
+	}
+	game->VariablesChanged();
+}
+
+ieDword CheckVariable(const Scriptable* Sender, const StringParam& VarName, VariableSymbol& symbol, const VarContext& context, bool* valid)
+{
+	if (symbol.scope == VarScope::Unresolved) {
+		ResolveVariable(VarName, context, symbol);
+	}
+
+	const Game* game = core->GetGame();
+	const Scriptable* owner = nullptr;
+	const ieVarsMap* vars = nullptr;
+	VariableSlots* slots = nullptr;
+	VariableSpace space = VariableSpace::Shared;
+	switch (symbol.scope) {
+		case VarScope::Area:
+			owner = Sender->GetCurrentArea();
+			break;
+		case VarScope::Locals:
+			owner = Sender;
+			space = VariableSpace::Local;
+			break;
+		case VarScope::Kaputz:
+			if (HasKaputz) {
+				vars = &game->kaputz;
+				slots = &game->kaputzSlots;
+			}
+			break;
+		case VarScope::Global:
+			owner = game;
+			break;
+		default:
+			break;
+	}
+	if (owner) {
+		vars = &owner->locals;
+		slots = &owner->localSlots;
+	}
+	if (!vars) {
+		return CheckVariable(Sender, VarName, context, valid);
+	}
+
+	const ieDword* value = slots->Find(*vars, space, symbol.id, &VarName[symbol.nameOffset]);
+	if (!value) return 0;
+	ScriptDebugLog(DebugMode::VARIABLES, "CheckVariable {}{}: {}", context, VarName, *value);
+	return *value;
+}
+
 Point CheckPointVariable(const Scriptable* Sender, const StringParam& VarName, const VarContext& Context, bool* valid)
 {
 	ieDword val = CheckVariable(Sender, VarName, Context, valid);
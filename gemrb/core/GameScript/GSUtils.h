@@ -142,8 +142,12 @@ bool CreateMovementEffect(Actor* actor, const ResRef& area, const Point& positio
 GEM_EXPORT void MoveBetweenAreasCore(Actor* actor, const ResRef& area, const Point& position, int face, bool adjust);
 GEM_EXPORT ieDword CheckVariable(const Scriptable* Sender, const StringParam& VarName, VarContext Context = {}, bool* valid = nullptr);
 GEM_EXPORT Point CheckPointVariable(const Scriptable* Sender, const StringParam& VarName, const VarContext& Context = {}, bool* valid = nullptr);
+// like the above, but scope and name are only worked out once and kept in symbol, which belongs to VarName
+GEM_EXPORT void SetVariable(Scriptable* Sender, const StringParam& VarName, VariableSymbol& symbol, ieDword value, const VarContext& Context = {});
+GEM_EXPORT ieDword CheckVariable(const Scriptable* Sender, const StringParam& VarName, VariableSymbol& symbol, const VarContext& Context = {}, bool* valid = nullptr);
 GEM_EXPORT bool VariableExists(const Scriptable* Sender, const StringParam& VarName, const VarContext& Context);
 Action* GenerateActionCore(const char* src, const char* str, unsigned short actionID);
+void ClearActionTemplates();
 Trigger* GenerateTriggerCore(const char* src, const char* str, int trIndex, int negate);
 GEM_EXPORT unsigned int GetSpellDistance(const ResRef& spellRes, Scriptable* Sender, const Point& target = Point());
 unsigned int GetItemDistance(const ResRef& itemres, int header, float_t angle);
@@ -51,8 +51,10 @@
 #include "TableMgr.h"
 
 #include "GUI/GameControl.h"
+#include "GameScript/CompiledScript.h"
 #include "GameScript/GSUtils.h"
 #include "GameScript/Matching.h"
+#include "Streams/MemoryStream.h"
 
 namespace GemRB {
 
@@ -88,11 +90,11 @@ static const TriggerLink triggernames[] = {
 	{ "assign", GameScript::Assign, 0 },
 	{ "atlocation", GameScript::AtLocation, 0 },
 	{ "attackedby", GameScript::AttackedBy, 0 },
-	{ "becamevisible", GameScript::BecameVisible, 0 },
+	{ "becamevisible", GameScript::BecameVisible, TF_EVENTS },
 	{ "beeninparty", GameScript::BeenInParty, 0 },
-	{ "bitcheck", GameScript::BitCheck, TF_MERGESTRINGS },
-	{ "bitcheckexact", GameScript::BitCheckExact, TF_MERGESTRINGS },
-	{ "bitglobal", GameScript::BitGlobal_Trigger, TF_MERGESTRINGS },
+	{ "bitcheck", GameScript::BitCheck, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "bitcheckexact", GameScript::BitCheckExact, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "bitglobal", GameScript::BitGlobal_Trigger, TF_MERGESTRINGS | TF_VARIABLES },
 	{ "bouncingspelllevel", GameScript::BouncingSpellLevel, 0 },
 	{ "breakingpoint", GameScript::BreakingPoint, 0 },
 	{ "buttondisabled", GameScript::ButtonDisabled, 0 },
@@ -124,8 +126,8 @@ static const TriggerLink triggernames[] = {
 	{ "classlevel", GameScript::ClassLevel, 0 }, //pst
 	{ "classlevelgt", GameScript::ClassLevelGT, 0 },
 	{ "classlevellt", GameScript::ClassLevelLT, 0 },
-	{ "clicked", GameScript::Clicked, 0 },
-	{ "closed", GameScript::Closed, 0 },
+	{ "clicked", GameScript::Clicked, TF_EVENTS },
+	{ "closed", GameScript::Closed, TF_EVENTS },
 	{ "combatcounter", GameScript::CombatCounter, 0 },
 	{ "combatcountergt", GameScript::CombatCounterGT, 0 },
 	{ "combatcounterlt", GameScript::CombatCounterLT, 0 },
@@ -141,16 +143,16 @@ static const TriggerLink triggernames[] = {
 	{ "dead", GameScript::Dead, 0 },
 	{ "delay", GameScript::Delay, 0 },
 	{ "detect", GameScript::Detect, 0 }, //so far i see no difference
-	{ "detected", GameScript::Detected, 0 }, //trap or secret door detected
-	{ "die", GameScript::Die, 0 },
-	{ "died", GameScript::Died, 0 },
+	{ "detected", GameScript::Detected, TF_EVENTS }, //trap or secret door detected
+	{ "die", GameScript::Die, TF_EVENTS },
+	{ "died", GameScript::Died, TF_EVENTS },
 	{ "difficulty", GameScript::Difficulty, 0 },
 	{ "difficultygt", GameScript::DifficultyGT, 0 },
 	{ "difficultylt", GameScript::DifficultyLT, 0 },
-	{ "disarmed", GameScript::Disarmed, 0 },
-	{ "disarmfailed", GameScript::DisarmFailed, 0 },
+	{ "disarmed", GameScript::Disarmed, TF_EVENTS },
+	{ "disarmfailed", GameScript::DisarmFailed, TF_EVENTS },
 	{ "e", GameScript::E, 0 },
-	{ "entered", GameScript::Entered, 0 },
+	{ "entered", GameScript::Entered, TF_EVENTS },
 	{ "entirepartyonmap", GameScript::EntirePartyOnMap, 0 },
 	{ "exists", GameScript::Exists, 0 },
 	{ "extendedstatecheck", GameScript::ExtendedStateCheck, 0 },
@@ -159,32 +161,32 @@ static const TriggerLink triggernames[] = {
 	{ "extraproficiencylt", GameScript::ExtraProficiencyLT, 0 },
 	{ "eval", GameScript::Eval, 0 },
 	{ "faction", GameScript::Faction, 0 },
-	{ "failedtoopen", GameScript::OpenFailed, 0 },
+	{ "failedtoopen", GameScript::OpenFailed, TF_EVENTS },
 	{ "fallenpaladin", GameScript::FallenPaladin, 0 },
 	{ "fallenranger", GameScript::FallenRanger, 0 },
-	{ "false", GameScript::False, 0 },
+	{ "false", GameScript::False, TF_PURE },
 	{ "forcemarkedspell", GameScript::ForceMarkedSpell_Trigger, 0 },
 	{ "frame", GameScript::Frame, 0 },
-	{ "g", GameScript::G_Trigger, 0 },
+	{ "g", GameScript::G_Trigger, TF_VARIABLES },
 	{ "gender", GameScript::Gender, 0 },
 	{ "general", GameScript::General, 0 },
-	{ "ggt", GameScript::GGT_Trigger, 0 },
-	{ "glt", GameScript::GLT_Trigger, 0 },
-	{ "global", GameScript::Global, TF_MERGESTRINGS },
-	{ "globalandglobal", GameScript::GlobalAndGlobal_Trigger, TF_MERGESTRINGS },
-	{ "globalband", GameScript::BitCheck, TF_MERGESTRINGS },
-	{ "globalbandglobal", GameScript::GlobalBAndGlobal_Trigger, TF_MERGESTRINGS },
-	{ "globalbandglobalexact", GameScript::GlobalBAndGlobalExact, TF_MERGESTRINGS },
-	{ "globalbitglobal", GameScript::GlobalBitGlobal_Trigger, TF_MERGESTRINGS },
-	{ "globalequalsglobal", GameScript::GlobalsEqual, TF_MERGESTRINGS }, //this is the same
-	{ "globalgt", GameScript::GlobalGT, TF_MERGESTRINGS },
-	{ "globalgtglobal", GameScript::GlobalGTGlobal, TF_MERGESTRINGS },
-	{ "globallt", GameScript::GlobalLT, TF_MERGESTRINGS },
-	{ "globalltglobal", GameScript::GlobalLTGlobal, TF_MERGESTRINGS },
-	{ "globalorglobal", GameScript::GlobalOrGlobal_Trigger, TF_MERGESTRINGS },
-	{ "globalsequal", GameScript::GlobalsEqual, 0 },
-	{ "globalsgt", GameScript::GlobalsGT, 0 },
-	{ "globalslt", GameScript::GlobalsLT, 0 },
+	{ "ggt", GameScript::GGT_Trigger, TF_VARIABLES },
+	{ "glt", GameScript::GLT_Trigger, TF_VARIABLES },
+	{ "global", GameScript::Global, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalandglobal", GameScript::GlobalAndGlobal_Trigger, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalband", GameScript::BitCheck, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalbandglobal", GameScript::GlobalBAndGlobal_Trigger, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalbandglobalexact", GameScript::GlobalBAndGlobalExact, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalbitglobal", GameScript::GlobalBitGlobal_Trigger, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalequalsglobal", GameScript::GlobalsEqual, TF_MERGESTRINGS | TF_VARIABLES }, //this is the same
+	{ "globalgt", GameScript::GlobalGT, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalgtglobal", GameScript::GlobalGTGlobal, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globallt", GameScript::GlobalLT, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalltglobal", GameScript::GlobalLTGlobal, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalorglobal", GameScript::GlobalOrGlobal_Trigger, TF_MERGESTRINGS | TF_VARIABLES },
+	{ "globalsequal", GameScript::GlobalsEqual, TF_VARIABLES },
+	{ "globalsgt", GameScript::GlobalsGT, TF_VARIABLES },
+	{ "globalslt", GameScript::GlobalsLT, TF_VARIABLES },
 	{ "globaltimerexact", GameScript::GlobalTimerExact, 0 },
 	{ "globaltimerexpired", GameScript::GlobalTimerExpired, 0 },
 	{ "globaltimernotexpired", GameScript::GlobalTimerNotExpired, 0 },
@@ -193,9 +195,9 @@ static const TriggerLink triggernames[] = {
 	{ "happiness", GameScript::Happiness, 0 },
 	{ "happinessgt", GameScript::HappinessGT, 0 },
 	{ "happinesslt", GameScript::HappinessLT, 0 },
-	{ "harmlessclosed", GameScript::HarmlessClosed, 0 }, //pst
-	{ "harmlessentered", GameScript::HarmlessEntered, 0 }, //pst
-	{ "harmlessopened", GameScript::HarmlessOpened, 0 }, //pst
+	{ "harmlessclosed", GameScript::HarmlessClosed, TF_EVENTS }, //pst
+	{ "harmlessentered", GameScript::HarmlessEntered, TF_EVENTS }, //pst
+	{ "harmlessopened", GameScript::HarmlessOpened, TF_EVENTS }, //pst
 	{ "hasbounceeffects", GameScript::HasBounceEffects, 0 },
 	{ "hasdlc", GameScript::HasDLC, 0 },
 	{ "hasimmunityeffects", GameScript::HasImmunityEffects, 0 },
@@ -218,11 +220,11 @@ static const TriggerLink triggernames[] = {
 	{ "havespellparty", GameScript::HaveSpellParty, 0 },
 	{ "havespellres", GameScript::HaveSpell, 0 }, //they share the same ID
 	{ "haveusableweaponequipped", GameScript::HaveUsableWeaponEquipped, 0 },
-	{ "heard", GameScript::Heard, 0 },
+	{ "heard", GameScript::Heard, TF_EVENTS },
 	{ "help", GameScript::Help_Trigger, 0 },
 	{ "helpex", GameScript::HelpEX, 0 },
-	{ "hitby", GameScript::HitBy, 0 },
-	{ "hotkey", GameScript::HotKey, 0 },
+	{ "hitby", GameScript::HitBy, TF_EVENTS },
+	{ "hotkey", GameScript::HotKey, TF_EVENTS },
 	{ "hp", GameScript::HP, 0 },
 	{ "hpgt", GameScript::HPGT, 0 },
 	{ "hplost", GameScript::HPLost, 0 },
@@ -280,13 +282,13 @@ static const TriggerLink triggernames[] = {
 	{ "isweaponranged", GameScript::IsWeaponRanged, 0 },
 	{ "isweather", GameScript::IsWeather, 0 }, //gemrb extension
 	{ "itemisidentified", GameScript::ItemIsIdentified, 0 },
-	{ "joins", GameScript::Joins, 0 },
-	{ "killed", GameScript::Killed, 0 },
+	{ "joins", GameScript::Joins, TF_EVENTS },
+	{ "killed", GameScript::Killed, TF_EVENTS },
 	{ "kit", GameScript::Kit, 0 },
 	{ "knowspell", GameScript::KnowSpell, 0 }, // gemrb specific, but also reused for ees
 	{ "lastmarkedobject", GameScript::LastMarkedObject_Trigger, 0 },
 	{ "lastpersontalkedto", GameScript::LastPersonTalkedTo, 0 }, //pst
-	{ "leaves", GameScript::Leaves, 0 },
+	{ "leaves", GameScript::Leaves, TF_EVENTS },
 	{ "level", GameScript::Level, 0 },
 	{ "levelgt", GameScript::LevelGT, 0 },
 	{ "levelinclass", GameScript::LevelInClass, 0 }, //iwd2
@@ -296,9 +298,9 @@ static const TriggerLink triggernames[] = {
 	{ "levelparty", GameScript::LevelParty, 0 },
 	{ "levelpartygt", GameScript::LevelPartyGT, 0 },
 	{ "levelpartylt", GameScript::LevelPartyLT, 0 },
-	{ "localsequal", GameScript::LocalsEqual, 0 },
-	{ "localsgt", GameScript::LocalsGT, 0 },
-	{ "localslt", GameScript::LocalsLT, 0 },
+	{ "localsequal", GameScript::LocalsEqual, TF_VARIABLES },
+	{ "localsgt", GameScript::LocalsGT, TF_VARIABLES },
+	{ "localslt", GameScript::LocalsLT, TF_VARIABLES },
 	{ "los", GameScript::LOS, 0 },
 	{ "lt", GameScript::LT, 0 },
 	{ "modalstate", GameScript::ModalState, 0 },
@@ -310,7 +312,7 @@ static const TriggerLink triggernames[] = {
 	{ "movementrategt", GameScript::MovementRateGT, 0 },
 	{ "movementratelt", GameScript::MovementRateLT, 0 },
 	{ "name", GameScript::CalledByName, 0 }, //this is the same too?
-	{ "namelessbitthedust", GameScript::NamelessBitTheDust, 0 },
+	{ "namelessbitthedust", GameScript::NamelessBitTheDust, TF_EVENTS },
 	{ "nearbydialog", GameScript::NearbyDialog, 0 },
 	{ "nearbydialogue", GameScript::NearbyDialog, 0 },
 	{ "nearlocation", GameScript::NearLocation, 0 },
@@ -332,9 +334,9 @@ static const TriggerLink triggernames[] = {
 	{ "numcreaturevsparty", GameScript::NumCreatureVsParty, 0 },
 	{ "numcreaturevspartygt", GameScript::NumCreatureVsPartyGT, 0 },
 	{ "numcreaturevspartylt", GameScript::NumCreatureVsPartyLT, 0 },
-	{ "numdead", GameScript::NumDead, 0 },
-	{ "numdeadgt", GameScript::NumDeadGT, 0 },
-	{ "numdeadlt", GameScript::NumDeadLT, 0 },
+	{ "numdead", GameScript::NumDead, TF_VARIABLES },
+	{ "numdeadgt", GameScript::NumDeadGT, TF_VARIABLES },
+	{ "numdeadlt", GameScript::NumDeadLT, TF_VARIABLES },
 	{ "numimmunetospelllevel", GameScript::NumImmuneToSpellLevel, 0 },
 	{ "numimmunetospelllevelgt", GameScript::NumImmuneToSpellLevelGT, 0 },
 	{ "numimmunetospelllevellt", GameScript::NumImmuneToSpellLevelLT, 0 },
@@ -372,13 +374,13 @@ static const TriggerLink triggernames[] = {
 	{ "objitemcounteq", GameScript::NumItems, 0 },
 	{ "objitemcountgt", GameScript::NumItemsGT, 0 },
 	{ "objitemcountlt", GameScript::NumItemsLT, 0 },
-	{ "oncreation", GameScript::OnCreation, 0 },
+	{ "oncreation", GameScript::OnCreation, TF_EVENTS },
 	{ "onisland", GameScript::OnIsland, 0 },
 	{ "onscreen", GameScript::OnScreen, 0 },
-	{ "opened", GameScript::Opened, 0 },
-	{ "openfailed", GameScript::OpenFailed, 0 },
+	{ "opened", GameScript::Opened, TF_EVENTS },
+	{ "openfailed", GameScript::OpenFailed, TF_EVENTS },
 	{ "openstate", GameScript::OpenState, 0 },
-	{ "or", GameScript::Or, 0 },
+	{ "or", GameScript::Or, TF_PURE },
 	{ "originalclass", GameScript::OriginalClass, 0 },
 	{ "outofammo", GameScript::OutOfAmmo, 0 },
 	{ "ownsfloatermessage", GameScript::OwnsFloaterMessage, 0 },
@@ -396,13 +398,13 @@ static const TriggerLink triggernames[] = {
 	{ "partylevelvs", GameScript::NumCreatureVsParty, 0 },
 	{ "partylevelvsgt", GameScript::NumCreatureVsPartyGT, 0 },
 	{ "partylevelvslt", GameScript::NumCreatureVsPartyLT, 0 },
-	{ "partymemberdied", GameScript::PartyMemberDied, 0 },
-	{ "partyrested", GameScript::PartyRested, 0 },
+	{ "partymemberdied", GameScript::PartyMemberDied, TF_EVENTS },
+	{ "partyrested", GameScript::PartyRested, TF_EVENTS },
 	{ "pccanseepoint", GameScript::PCCanSeePoint, 0 },
 	{ "pcinstore", GameScript::PCInStore, 0 },
 	{ "personalspacedistance", GameScript::PersonalSpaceDistance, 0 },
-	{ "picklockfailed", GameScript::PickLockFailed, 0 },
-	{ "pickpocketfailed", GameScript::PickpocketFailed, 0 },
+	{ "picklockfailed", GameScript::PickLockFailed, TF_EVENTS },
+	{ "pickpocketfailed", GameScript::PickpocketFailed, TF_EVENTS },
 	{ "proficiency", GameScript::Proficiency, 0 },
 	{ "proficiencygt", GameScript::ProficiencyGT, 0 },
 	{ "proficiencylt", GameScript::ProficiencyLT, 0 },
@@ -418,7 +420,7 @@ static const TriggerLink triggernames[] = {
 	{ "realglobaltimerexact", GameScript::RealGlobalTimerExact, 0 },
 	{ "realglobaltimerexpired", GameScript::RealGlobalTimerExpired, 0 },
 	{ "realglobaltimernotexpired", GameScript::RealGlobalTimerNotExpired, 0 },
-	{ "receivedorder", GameScript::ReceivedOrder, 0 },
+	{ "receivedorder", GameScript::ReceivedOrder, TF_EVENTS },
 	{ "reputation", GameScript::Reputation, 0 },
 	{ "reputationgt", GameScript::ReputationGT, 0 },
 	{ "reputationlt", GameScript::ReputationLT, 0 },
@@ -427,7 +429,7 @@ static const TriggerLink triggernames[] = {
 	{ "reserved2", nullptr, 0 },
 	{ "reserved3", nullptr, 0 },
 	{ "reset", GameScript::Reset, 0 },
-	{ "said", GameScript::False, 0 },
+	{ "said", GameScript::False, TF_PURE },
 	{ "school", GameScript::School, 0 }, //similar to kit
 	{ "secretdoordetected", GameScript::SecretDoorDetected, 0 },
 	{ "see", GameScript::See, 0 },
@@ -436,12 +438,12 @@ static const TriggerLink triggernames[] = {
 	{ "setmarkedspell", GameScript::SetMarkedSpell_Trigger, 0 },
 	{ "setspelltarget", GameScript::SetSpellTarget, 0 },
 	{ "specifics", GameScript::Specifics, 0 },
-	{ "spellcast", GameScript::SpellCast, 0 },
-	{ "spellcastinnate", GameScript::SpellCastInnate, 0 },
-	{ "spellcastonme", GameScript::SpellCastOnMe, 0 },
-	{ "spellcastpriest", GameScript::SpellCastPriest, 0 },
+	{ "spellcast", GameScript::SpellCast, TF_EVENTS },
+	{ "spellcastinnate", GameScript::SpellCastInnate, TF_EVENTS },
+	{ "spellcastonme", GameScript::SpellCastOnMe, TF_EVENTS },
+	{ "spellcastpriest", GameScript::SpellCastPriest, TF_EVENTS },
 	{ "statecheck", GameScript::StateCheck, 0 },
-	{ "stealfailed", GameScript::StealFailed, 0 },
+	{ "stealfailed", GameScript::StealFailed, TF_EVENTS },
 	{ "storehasitem", GameScript::StoreHasItem, 0 },
 	{ "storymodeon", GameScript::StoryModeOn, 0 },
 	{ "stuffglobalrandom", GameScript::StuffGlobalRandom, 0 }, //hm, this is a trigger
@@ -452,7 +454,7 @@ static const TriggerLink triggernames[] = {
 	{ "summoninglimitlt", GameScript::SummoningLimitLT, 0 },
 	{ "switch", GameScript::Switch, 0 },
 	{ "systemvariable", GameScript::SystemVariable_Trigger, 0 }, //gemrb
-	{ "targetunreachable", GameScript::TargetUnreachable, 0 },
+	{ "targetunreachable", GameScript::TargetUnreachable, TF_EVENTS },
 	{ "team", GameScript::Team, 0 },
 	{ "time", GameScript::Time, 0 },
 	{ "timegt", GameScript::TimeGT, 0 },
@@ -464,31 +466,31 @@ static const TriggerLink triggernames[] = {
 	{ "timestopcountergt", GameScript::TimeStopCounterGT, 0 },
 	{ "timestopcounterlt", GameScript::TimeStopCounterLT, 0 },
 	{ "timestopobject", GameScript::TimeStopObject, 0 },
-	{ "tookdamage", GameScript::TookDamage, 0 },
+	{ "tookdamage", GameScript::TookDamage, TF_EVENTS },
 	{ "totalitemcnt", GameScript::TotalItemCnt, 0 }, //iwd2
 	{ "totalitemcntexclude", GameScript::TotalItemCntExclude, 0 }, //iwd2
 	{ "totalitemcntexcludegt", GameScript::TotalItemCntExcludeGT, 0 }, //iwd2
 	{ "totalitemcntexcludelt", GameScript::TotalItemCntExcludeLT, 0 }, //iwd2
 	{ "totalitemcntgt", GameScript::TotalItemCntGT, 0 }, //iwd2
 	{ "totalitemcntlt", GameScript::TotalItemCntLT, 0 }, //iwd2
-	{ "traptriggered", GameScript::TrapTriggered, 0 },
-	{ "trigger", GameScript::TriggerTrigger, 0 },
-	{ "triggerclick", GameScript::Clicked, 0 }, //not sure
+	{ "traptriggered", GameScript::TrapTriggered, TF_EVENTS },
+	{ "trigger", GameScript::TriggerTrigger, TF_EVENTS },
+	{ "triggerclick", GameScript::Clicked, TF_EVENTS }, //not sure
 	{ "triggersetglobal", GameScript::TriggerSetGlobal, 0 }, //iwd2, but never used
-	{ "true", GameScript::True, 0 },
-	{ "turnedby", GameScript::TurnedBy, 0 },
-	{ "unlocked", GameScript::Unlocked, 0 },
+	{ "true", GameScript::True, TF_PURE },
+	{ "turnedby", GameScript::TurnedBy, TF_EVENTS },
+	{ "unlocked", GameScript::Unlocked, TF_EVENTS },
 	{ "unselectablevariable", GameScript::UnselectableVariable, 0 },
 	{ "unselectablevariablegt", GameScript::UnselectableVariableGT, 0 },
 	{ "unselectablevariablelt", GameScript::UnselectableVariableLT, 0 },
 	{ "unusable", GameScript::Unusable, 0 },
 	{ "usedexit", GameScript::UsedExit, 0 }, //pst unhardcoded trigger for protagonist teleport
 	{ "vacant", GameScript::Vacant, 0 },
-	{ "walkedtotrigger", GameScript::WalkedToTrigger, 0 },
-	{ "wasindialog", GameScript::WasInDialog, 0 },
+	{ "walkedtotrigger", GameScript::WalkedToTrigger, TF_EVENTS },
+	{ "wasindialog", GameScript::WasInDialog, TF_EVENTS },
 	{ "weaponcandamage", GameScript::WeaponCanDamage, 0 },
 	{ "weaponeffectivevs", GameScript::WeaponEffectiveVs, 0 },
-	{ "xor", GameScript::Xor, TF_MERGESTRINGS },
+	{ "xor", GameScript::Xor, TF_MERGESTRINGS | TF_VARIABLES },
 	{ "xp", GameScript::XP, 0 },
 	{ "xpgt", GameScript::XPGT, 0 },
 	{ "xplt", GameScript::XPLT, 0 },
@@ -1324,6 +1326,7 @@ static void CleanupIEScript()
 	objectsTable.reset();
 	overrideActionsTable.reset();
 	overrideTriggersTable.reset();
+	ClearActionTemplates();
 }
 
 static void printFunction(std::string& buffer, const std::string& str, int value)
@@ -1807,6 +1810,7 @@ void InitializeIEScript()
 }
 
 /********************** GameScript *******************************/
+
 GameScript::GameScript(const ResRef& resref, Scriptable* MySelf,
 		       int ScriptLevel, bool AIScript)
 	: MySelf(MySelf), Name(resref), scriptlevel(ScriptLevel)
@@ -1833,24 +1837,33 @@ Script* GameScript::CacheScript(const ResRef& resRef, bool AIScript)
 		return NULL;
 	}
 
+	// the parser reads single characters, so it is much faster from memory
+	strpos_t size = stream->Remains();
+	void* data = malloc(size);
+	size = std::max<strret_t>(stream->Read(data, size), 0);
+	MemoryStream text(stream->originalfile, data, size);
+	delete stream;
+
 	std::string line;
-	stream->ReadLine(line, 10);
+	text.ReadLine(line, 10);
 	if (line.compare(0, 2, "SC") != 0) {
 		Log(WARNING, "GameScript", "Not a Compiled Script file");
-		delete stream;
 		return nullptr;
 	}
 
 	auto newScript = BcsCache.SetAt(resRef).first;
+	if (LoadCompiledScript(text.GetBuffer(), size, *newScript)) {
+		return newScript;
+	}
 
 	while (true) {
-		ResponseBlock* rB = ReadResponseBlock(stream);
+		ResponseBlock* rB = ReadResponseBlock(&text, newScript->arena);
 		if (!rB)
 			break;
 		newScript->responseBlocks.push_back(rB);
-		stream->ReadLine(line, 10);
+		text.ReadLine(line, 10);
 	}
-	delete stream;
+	StoreCompiledScript(text.GetBuffer(), size, *newScript);
 	return newScript;
 }
 
@@ -1878,9 +1891,26 @@ bool GameScript::Update(bool* continuing, bool* done)
 	if (continuing) continueExecution = *continuing;
 
 	RandomNumValue = RAND<int>();
+	// skip reevaluating false conditions whose inputs haven't changed since (see TF_TRACKED)
+	const bool incrementalTriggers = core->config.IncrementalTriggers;
+	if (incrementalTriggers) {
+		// MYAREA variables are resolved through the current area
+		if (cachedArea != MySelf->GetCurrentArea() || cachedConditions.size() != script->responseBlocks.size()) {
+			cachedConditions.assign(script->responseBlocks.size(), {});
+			cachedArea = MySelf->GetCurrentArea();
+		}
+	} else {
+		// the option can be toggled while running, so don't keep outdated results
+		cachedConditions.clear();
+	}
 	for (size_t a = 0; a < script->responseBlocks.size(); a++) {
 		ResponseBlock* rB = script->responseBlocks[a];
-		if (!rB->condition->Evaluate(MySelf)) {
+		if (incrementalTriggers && IsCachedFalse(a)) {
+			continue;
+		}
+		short inputs = 0;
+		if (!rB->condition->Evaluate(MySelf, incrementalTriggers ? &inputs : nullptr)) {
+			if (incrementalTriggers) CacheCondition(a, inputs);
 			continue;
 		}
 
@@ -1932,6 +1962,31 @@ bool GameScript::Update(bool* continuing, bool* done)
 	return continueExecution;
 }
 
+// a false condition stays false as long as nothing its triggers read changes,
+// which we can only tell for the tracked inputs; the evaluation stops at the
+// first false trigger, so skipping it also doesn't skip any untracked triggers
+bool GameScript::IsCachedFalse(size_t block) const
+{
+	const CachedCondition& cached = cachedConditions[block];
+	if (!cached.valid) return false;
+	if (cached.variablesEpoch != core->GetGame()->GetVariablesEpoch()) return false;
+	return !cached.events || !MySelf->HasTriggers();
+}
+
+void GameScript::CacheCondition(size_t block, short inputs)
+{
+	CachedCondition& cached = cachedConditions[block];
+	cached.valid = false;
+	if (inputs & TF_UNTRACKED) return;
+
+	cached.events = inputs & TF_EVENTS;
+	// the trigger list only has fixed contents when empty
+	if (cached.events && MySelf->HasTriggers()) return;
+
+	cached.valid = true;
+	cached.variablesEpoch = core->GetGame()->GetVariablesEpoch();
+}
+
 //IE simply takes the first action's object for cutscene object
 //then adds these actions to its queue:
 // SetInterrupt(false), <actions>, SetInterrupt(true)
@@ -2026,7 +2081,7 @@ int GameScript::EvaluateString(Scriptable* Sender, const char* String)
 	return 0;
 }
 
-bool Condition::Evaluate(Scriptable* Sender) const
+bool Condition::Evaluate(Scriptable* Sender, short* inputs) const
 {
 	int ORcount = 0;
 	unsigned int result = 0;
@@ -2041,6 +2096,10 @@ bool Condition::Evaluate(Scriptable* Sender) const
 		//was already True() ... but this sane approach was only used in iwd2!
 		if (!core->HasFeature(GFFlags::EFFICIENT_OR) || !ORcount || !subresult) {
 			result = tR->Evaluate(Sender);
+			if (inputs) {
+				short tf = tR->triggerID < MAX_TRIGGERS ? triggerflags[tR->triggerID] & TF_TRACKED : 0;
+				*inputs |= tf ? tf : TF_UNTRACKED;
+			}
 		}
 		if (result > 1) {
 			//we started an Or() block
@@ -25,6 +25,7 @@
 
 #include "Debug.h"
 
+#include "GameScript/ScriptArena.h"
 #include "GameScript/Targets.h"
 #include "Logging/Logging.h"
 #include "Scriptable/Actor.h"
@@ -133,7 +134,7 @@ protected:
 	}
 };
 
-class GEM_EXPORT Object : protected Canary {
+class GEM_EXPORT Object : protected Canary, public ArenaNode {
 public:
 	int objectFields[MAX_OBJECT_FIELDS] {}; // eg. [PC.0.0.UNDEAD]
 	int objectFilters[MAX_NESTING] {}; // eg. Myself or LastTargetedBy(LastAttackerOf(Player1))
@@ -157,7 +158,23 @@ public:
 	bool isNull() const;
 };
 
-class GEM_EXPORT Trigger final : protected Canary {
+enum class VarScope : uint8_t {
+	Unresolved,
+	Area, // MYAREA
+	Locals,
+	Kaputz,
+	Global,
+	Named // an area given by name, eg. AR1324
+};
+
+// scope and name of a variable parameter, resolved when first used, see CheckVariable
+struct VariableSymbol {
+	uint32_t id = 0;
+	VarScope scope = VarScope::Unresolved;
+	uint8_t nameOffset = 0; // where the name starts in the string parameter
+};
+
+class GEM_EXPORT Trigger final : protected Canary, public ArenaNode {
 public:
 	Trigger() noexcept
 		: string0Parameter(), string1Parameter() {};
@@ -190,6 +207,9 @@ public:
 		ResRef resref1Parameter;
 	};
 
+	mutable VariableSymbol symbol0;
+	mutable VariableSymbol symbol1;
+
 	std::string dump() const;
 
 	void Release()
@@ -198,7 +218,7 @@ public:
 	}
 };
 
-class GEM_EXPORT Condition final : protected Canary {
+class GEM_EXPORT Condition final : protected Canary, public ArenaNode {
 public:
 	~Condition() noexcept override
 	{
@@ -213,7 +233,8 @@ public:
 	{
 		delete this;
 	}
-	bool Evaluate(Scriptable* Sender) const;
+	// if inputs is set, it collects the TF_TRACKED flags of the evaluated triggers (or TF_UNTRACKED)
+	bool Evaluate(Scriptable* Sender, short* inputs = nullptr) const;
 
 	std::vector<Trigger*> triggers;
 };
@@ -259,6 +280,9 @@ public:
 		ResRef resref1Parameter;
 	};
 
+	VariableSymbol symbol0;
+	VariableSymbol symbol1;
+
 	uint32_t flags = 0;
 
 private:
@@ -295,7 +319,7 @@ public:
 	}
 };
 
-class GEM_EXPORT Response final : protected Canary {
+class GEM_EXPORT Response final : protected Canary, public ArenaNode {
 public:
 	Response() noexcept = default;
 	~Response() noexcept override
@@ -320,7 +344,7 @@ public:
 	std::vector<Action*> actions;
 };
 
-class GEM_EXPORT ResponseSet final : protected Canary {
+class GEM_EXPORT ResponseSet final : protected Canary, public ArenaNode {
 public:
 	~ResponseSet() final
 	{
@@ -338,7 +362,7 @@ public:
 	std::vector<Response*> responses;
 };
 
-class GEM_EXPORT ResponseBlock final : protected Canary {
+class GEM_EXPORT ResponseBlock final : protected Canary, public ArenaNode {
 public:
 	ResponseBlock() noexcept = default;
 	~ResponseBlock() noexcept override
@@ -374,6 +398,9 @@ public:
 	}
 
 	std::vector<ResponseBlock*> responseBlocks;
+	// holds the nodes of the script, except for the actions and their objects,
+	// since those are refcounted and can outlive the script in action queues
+	ScriptArena arena;
 
 	void Release()
 	{
@@ -391,6 +418,12 @@ using IDSFunction = int (*)(const Actor*, int parameter);
 #define TF_SAVED        2 //trigger is in svtriobj.ids
 #define TF_MERGESTRINGS 8 //same value as actions' mergestring
 #define TF_HAS_OBJECT   16 // whether it has an object parameter
+// what the result depends on, used to skip unchanged false conditions, see GameScript::Update
+#define TF_PURE         32 // only the trigger parameters
+#define TF_VARIABLES    64 // script variables
+#define TF_EVENTS       128 // the trigger list of the sender, always false if it is empty
+#define TF_TRACKED      (TF_PURE | TF_VARIABLES | TF_EVENTS)
+#define TF_UNTRACKED    256 // anything else, only used when collecting the inputs of a condition
 
 struct TriggerLink {
 	const char* Name;
@@ -508,9 +541,11 @@ public:
 
 private: //Internal Functions
 	Script* CacheScript(const ResRef& ResRef, bool AIScript);
-	ResponseBlock* ReadResponseBlock(DataStream* stream);
-	ResponseSet* ReadResponseSet(DataStream* stream);
-	Response* ReadResponse(DataStream* stream);
+	bool IsCachedFalse(size_t block) const;
+	void CacheCondition(size_t block, short inputs);
+	ResponseBlock* ReadResponseBlock(DataStream* stream, ScriptArena& arena);
+	ResponseSet* ReadResponseSet(DataStream* stream, ScriptArena& arena);
+	Response* ReadResponse(DataStream* stream, ScriptArena& arena);
 	static int InParty(Scriptable* Sender, const Trigger* parameters, bool allowdead);
 
 	// Internal variables
@@ -520,6 +555,14 @@ private: //Internal Functions
 	size_t lastResponseBlock = -1;
 	int scriptlevel;
 
+	struct CachedCondition {
+		bool valid = false;
+		bool events = false; // was evaluated with an empty trigger list
+		unsigned int variablesEpoch = 0;
+	};
+	std::vector<CachedCondition> cachedConditions;
+	const Map* cachedArea = nullptr;
+
 public: //Script Functions
 	static int ID_Alignment(const Actor* actor, int parameter);
 	static int ID_Allegiance(const Actor* actor, int parameter);
@@ -197,17 +197,20 @@ static Targets* EvaluateObject(const Map* map, const Scriptable* Sender, const O
 	}
 
 	Targets* tgts = NULL;
+	bool skipSender = !core->HasFeature(GFFlags::AREA_OVERRIDE);
 
 	//we need to get a subset of actors from the large array
-	//if this gets slow, we will need some index tables
-	int i = map->GetActorCount(true);
-	while (i--) {
-		Actor* ac = map->GetActor(i, true);
+	//the index tables give us only the actors in the matching EA, class ... buckets
+	std::vector<Actor*> candidates;
+	bool indexed = map->GetActorIndex().GetCandidates(oC, candidates);
+	int i = indexed ? int(candidates.size()) : map->GetActorCount(true);
+	for (int j = 0; j < i; j++) {
+		Actor* ac = indexed ? candidates[j] : map->GetActor(i - j - 1, true);
 		if (!ac) continue; // is this check really needed?
 		// don't return Sender in IDS targeting!
 		// unless it's pst, which relies on it in 3012cut2-3012cut7.bcs
 		// FIXME: stop abusing old GF flags
-		if (!core->HasFeature(GFFlags::AREA_OVERRIDE) && ac == Sender) continue;
+		if (skipSender && ac == Sender) continue;
 
 		bool filtered = false;
 		if (!DoObjectIDSCheck(oC, ac, &filtered)) {
@@ -59,11 +59,12 @@ static void ParseString(const char*& src, char* tmp)
 	if (*src) src++;
 }
 
-static Object* DecodeObject(const std::string& line)
+// objects of actions go on the heap (no arena), like the actions themselves
+static Object* DecodeObject(const std::string& line, ScriptArena* arena)
 {
 	const char* cursor = line.c_str();
 
-	Object* oB = new Object();
+	Object* oB = arena ? new (*arena) Object() : new Object();
 	for (int i = 0; i < ObjectFieldsCount; i++) {
 		oB->objectFields[i] = ParseInt(cursor);
 	}
@@ -115,7 +116,7 @@ static Object* DecodeObject(const std::string& line)
 	return oB;
 }
 
-static Trigger* ReadTrigger(DataStream* stream)
+static Trigger* ReadTrigger(DataStream* stream, ScriptArena& arena)
 {
 	std::string line;
 	stream->ReadLine(line);
@@ -124,7 +125,7 @@ static Trigger* ReadTrigger(DataStream* stream)
 	}
 
 	stream->ReadLine(line);
-	Trigger* tR = new Trigger();
+	Trigger* tR = new (arena) Trigger();
 	// this exists only in PST?
 	if (HasTriggerPoint) {
 		sscanf(line.data(), "%hu %d %d %d %d [%d,%d] \"%[^\"]\" \"%[^\"]\" OB",
@@ -142,7 +143,7 @@ static Trigger* ReadTrigger(DataStream* stream)
 	tR->triggerID &= 0x3fff;
 
 	stream->ReadLine(line);
-	tR->objectParameter = DecodeObject(line);
+	tR->objectParameter = DecodeObject(line, &arena);
 	if (triggerflags[tR->triggerID] & TF_HAS_OBJECT && !tR->objectParameter) tR->flags |= TF_MISSING_OBJECT;
 	tR->flags |= TF_PRECOMPILED;
 
@@ -155,7 +156,7 @@ static Trigger* ReadTrigger(DataStream* stream)
 	return tR;
 }
 
-static Condition* ReadCondition(DataStream* stream)
+static Condition* ReadCondition(DataStream* stream, ScriptArena& arena)
 {
 	std::string line;
 	stream->ReadLine(line, 10);
@@ -163,10 +164,10 @@ static Condition* ReadCondition(DataStream* stream)
 		return nullptr;
 	}
 
-	Condition* cO = new Condition();
+	Condition* cO = new (arena) Condition();
 	Object* triggerer = nullptr;
 	while (true) {
-		Trigger* tR = ReadTrigger(stream);
+		Trigger* tR = ReadTrigger(stream, arena);
 		if (!tR) {
 			if (triggerer) delete triggerer;
 			break;
@@ -194,7 +195,7 @@ static Condition* ReadCondition(DataStream* stream)
 	return cO;
 }
 
-ResponseBlock* GameScript::ReadResponseBlock(DataStream* stream)
+ResponseBlock* GameScript::ReadResponseBlock(DataStream* stream, ScriptArena& arena)
 {
 	std::string line;
 	stream->ReadLine(line, 10);
@@ -202,13 +203,13 @@ ResponseBlock* GameScript::ReadResponseBlock(DataStream* stream)
 		return nullptr;
 	}
 
-	ResponseBlock* rB = new ResponseBlock();
-	rB->condition = ReadCondition(stream);
-	rB->responseSet = ReadResponseSet(stream);
+	ResponseBlock* rB = new (arena) ResponseBlock();
+	rB->condition = ReadCondition(stream, arena);
+	rB->responseSet = ReadResponseSet(stream, arena);
 	return rB;
 }
 
-ResponseSet* GameScript::ReadResponseSet(DataStream* stream)
+ResponseSet* GameScript::ReadResponseSet(DataStream* stream, ScriptArena& arena)
 {
 	std::string line;
 	stream->ReadLine(line, 10);
@@ -216,9 +217,9 @@ ResponseSet* GameScript::ReadResponseSet(DataStream* stream)
 		return nullptr;
 	}
 
-	ResponseSet* rS = new ResponseSet();
+	ResponseSet* rS = new (arena) ResponseSet();
 	while (true) {
-		Response* rE = ReadResponse(stream);
+		Response* rE = ReadResponse(stream, arena);
 		if (!rE) break;
 		rS->responses.push_back(rE);
 	}
@@ -227,7 +228,7 @@ ResponseSet* GameScript::ReadResponseSet(DataStream* stream)
 
 // this is the border of the GameScript object (all subsequent functions are library functions)
 // we can't make this a library function, because scriptlevel is set here
-Response* GameScript::ReadResponse(DataStream* stream)
+Response* GameScript::ReadResponse(DataStream* stream, ScriptArena& arena)
 {
 	std::string line;
 	stream->ReadLine(line);
@@ -235,7 +236,7 @@ Response* GameScript::ReadResponse(DataStream* stream)
 		return nullptr;
 	}
 
-	Response* rE = new Response();
+	Response* rE = new (arena) Response();
 	rE->weight = 0;
 	stream->ReadLine(line, 1024);
 	char* poi;
@@ -251,7 +252,7 @@ Response* GameScript::ReadResponse(DataStream* stream)
 		aC->actionID = strtounsigned<uint16_t>(line.c_str(), nullptr, 10);
 		for (int i = 0; i < 3; i++) {
 			stream->ReadLine(line, 1024);
-			Object* oB = DecodeObject(line);
+			Object* oB = DecodeObject(line, nullptr);
 			aC->objects[i] = oB;
 			if (i != 2) {
 				stream->ReadLine(line, 1024);
@@ -23,9 +23,34 @@
 #include "GSUtils.h"
 #include "GameScript.h"
 #include "Interface.h"
+#include "LRUCache.h"
+
+#include <memory>
 
 namespace GemRB {
 
+// parsing depends only on the ids tables, so the action strings the engine
+// keeps generating by itself (eg. "Attack()" or "MoveToPoint()") are compiled
+// once and then just copied
+struct ActionTemplate {
+	std::unique_ptr<Action> action;
+
+	explicit ActionTemplate(Action* action)
+		: action(action) {}
+
+	void evictionNotice() const { /* No need. */ }
+};
+
+struct EvictLeastRecent {
+	bool operator()(const ActionTemplate&) const
+	{
+		return true;
+	}
+};
+
+// dialog actions are mostly one-offs, so only the recently used ones are kept
+static constexpr size_t MAX_ACTION_TEMPLATES = 1024;
+static LRUCache<ActionTemplate, EvictLeastRecent> actionTemplates { MAX_ACTION_TEMPLATES };
 
 // we need this because some special characters like _ or * are also accepted
 inline bool IsMySymbol(const char letter)
@@ -513,11 +538,27 @@ Trigger* GenerateTrigger(std::string string)
 	return trigger;
 }
 
+static Action* CloneAction(const Action* templ)
+{
+	Action* action = ParamCopy(templ);
+	action->flags = templ->flags;
+	return action;
+}
+
+void ClearActionTemplates()
+{
+	actionTemplates.Clear();
+}
+
 Action* GenerateAction(std::string actionString)
 {
 	Action* action = nullptr;
 
 	StringToLower(actionString);
+	const ActionTemplate* cached = actionTemplates.LookupAndTouch(actionString);
+	if (cached) {
+		return CloneAction(cached->action.get());
+	}
 	ScriptDebugLog(DebugMode::ACTIONS, "Compiling: '{}'", actionString);
 
 	auto len = actionString.find_first_of('(') + 1; //including (
@@ -552,6 +593,7 @@ Action* GenerateAction(std::string actionString)
 		action->flags |= ACF_MISSING_OBJECT;
 	}
 
+	actionTemplates.SetAt(actionString, CloneAction(action));
 	return action;
 }
 
@@ -0,0 +1,84 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ScriptArena.h"
+
+#include <new>
+
+namespace GemRB {
+
+// every node is preceded by a tag saying where it lives, padded to keep the alignment
+static constexpr size_t TAG_SIZE = alignof(std::max_align_t);
+static constexpr char HEAP_NODE = 'H';
+static constexpr char ARENA_NODE = 'A';
+
+static size_t Aligned(size_t size)
+{
+	return (size + TAG_SIZE - 1) & ~(TAG_SIZE - 1);
+}
+
+void* ScriptArena::Allocate(size_t size)
+{
+	size = Aligned(size);
+	total += size;
+	if (size > BLOCK_SIZE / 4) {
+		// a block of its own, so the current one stays open for the small nodes
+		auto pos = blocks.empty() ? blocks.end() : blocks.end() - 1;
+		return blocks.emplace(pos, new char[size])->get();
+	}
+
+	if (used + size > BLOCK_SIZE) {
+		blocks.emplace_back(new char[BLOCK_SIZE]);
+		used = 0;
+	}
+	void* ptr = blocks.back().get() + used;
+	used += size;
+	return ptr;
+}
+
+void* ArenaNode::operator new(size_t size)
+{
+	char* mem = static_cast<char*>(::operator new(TAG_SIZE + size));
+	mem[0] = HEAP_NODE;
+	return mem + TAG_SIZE;
+}
+
+void* ArenaNode::operator new(size_t size, ScriptArena& arena)
+{
+	char* mem = static_cast<char*>(arena.Allocate(TAG_SIZE + size));
+	mem[0] = ARENA_NODE;
+	return mem + TAG_SIZE;
+}
+
+void ArenaNode::operator delete(void* ptr) noexcept
+{
+	if (!ptr) return;
+	char* mem = static_cast<char*>(ptr) - TAG_SIZE;
+	if (mem[0] == HEAP_NODE) {
+		::operator delete(mem);
+	}
+}
+
+void ArenaNode::operator delete(void*, ScriptArena&) noexcept
+{
+	// the arena frees it
+}
+
+}
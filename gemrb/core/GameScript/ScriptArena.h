@@ -0,0 +1,75 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SCRIPTARENA_H
+#define SCRIPTARENA_H
+
+#include "exports.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * Memory for the nodes of a parsed script, handed out in big blocks.
+ *
+ * A script has thousands of triggers, objects and responses, which would
+ * otherwise all be separate heap allocations. Everything is freed at once
+ * when the arena goes away, so it has to outlive the nodes placed in it.
+ * The actions and the vectors linking the nodes, like Condition::triggers
+ * and Response::actions, are still separate heap allocations.
+ */
+class GEM_EXPORT ScriptArena {
+public:
+	ScriptArena() noexcept = default;
+	ScriptArena(const ScriptArena&) = delete;
+	ScriptArena& operator=(const ScriptArena&) = delete;
+
+	void* Allocate(size_t size);
+	size_t Size() const { return total; }
+
+private:
+	static constexpr size_t BLOCK_SIZE = 16384;
+
+	std::vector<std::unique_ptr<char[]>> blocks;
+	size_t used = BLOCK_SIZE; // of the last block
+	size_t total = 0;
+};
+
+/**
+ * Base of the script nodes that can be placed in a ScriptArena.
+ *
+ * They can be created on the heap as well, and are released the same way in
+ * both cases: delete only gives heap memory back, arena memory is left alone.
+ */
+class GEM_EXPORT ArenaNode {
+public:
+	static void* operator new(size_t size);
+	static void* operator new(size_t size, ScriptArena& arena);
+	static void operator delete(void* ptr) noexcept;
+	// only used if a constructor throws
+	static void operator delete(void* ptr, ScriptArena& arena) noexcept;
+};
+
+}
+
+#endif
@@ -524,7 +524,7 @@ int GameScript::BitCheck(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid && value & parameters->int0Parameter) return 1;
 	return 0;
 }
@@ -533,7 +533,7 @@ int GameScript::BitCheckExact(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
 		ieDword tmp = (ieDword) parameters->int0Parameter;
 		if ((value & tmp) == tmp) return 1;
@@ -547,7 +547,7 @@ int GameScript::BitGlobal_Trigger(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
 		HandleBitMod(value, parameters->int0Parameter, BitOp(parameters->int1Parameter));
 		if (value != 0) return 1;
@@ -559,10 +559,10 @@ int GameScript::GlobalOrGlobal_Trigger(Scriptable* Sender, const Trigger* parame
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
 		if (value1) return 1;
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid && value2) return 1;
 	}
 	return 0;
@@ -572,9 +572,9 @@ int GameScript::GlobalAndGlobal_Trigger(Scriptable* Sender, const Trigger* param
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid && value1) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid && value2) return 1;
 	}
 	return 0;
@@ -584,9 +584,9 @@ int GameScript::GlobalBAndGlobal_Trigger(Scriptable* Sender, const Trigger* para
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid && (value1 & value2) != 0) return 1;
 	}
 	return 0;
@@ -596,9 +596,9 @@ int GameScript::GlobalBAndGlobalExact(Scriptable* Sender, const Trigger* paramet
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid && (value1 & value2) == value2) return 1;
 	}
 	return 0;
@@ -608,9 +608,9 @@ int GameScript::GlobalBitGlobal_Trigger(Scriptable* Sender, const Trigger* param
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid) {
 			HandleBitMod(value1, value2, BitOp(parameters->int1Parameter));
 			if (value1 != 0) return 1;
@@ -623,7 +623,7 @@ int GameScript::GlobalBitGlobal_Trigger(Scriptable* Sender, const Trigger* param
 //i just assume it sets a global in the trigger block
 int GameScript::TriggerSetGlobal(Scriptable* Sender, const Trigger* parameters)
 {
-	SetVariable(Sender, parameters->string0Parameter, parameters->int0Parameter);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->int0Parameter);
 	return 1;
 }
 
@@ -632,7 +632,7 @@ int GameScript::Xor(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid && (value ^ parameters->int0Parameter) != 0) return 1;
 	return 0;
 }
@@ -642,7 +642,7 @@ int GameScript::NumDead(Scriptable* Sender, const Trigger* parameters)
 	ieDword value;
 
 	if (core->HasFeature(GFFlags::HAS_KAPUTZ)) {
-		value = CheckVariable(Sender, parameters->string0Parameter, "KAPUTZ");
+		value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "KAPUTZ");
 	} else {
 		ieVariable VariableName;
 		VariableName.Format(Interface::GetDeathVarFormat(), parameters->string0Parameter);
@@ -656,7 +656,7 @@ int GameScript::NumDeadGT(Scriptable* Sender, const Trigger* parameters)
 	ieDword value;
 
 	if (core->HasFeature(GFFlags::HAS_KAPUTZ)) {
-		value = CheckVariable(Sender, parameters->string0Parameter, "KAPUTZ");
+		value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "KAPUTZ");
 	} else {
 		ieVariable VariableName;
 		VariableName.Format(Interface::GetDeathVarFormat(), parameters->string0Parameter);
@@ -670,7 +670,7 @@ int GameScript::NumDeadLT(Scriptable* Sender, const Trigger* parameters)
 	ieDword value;
 
 	if (core->HasFeature(GFFlags::HAS_KAPUTZ)) {
-		value = CheckVariable(Sender, parameters->string0Parameter, "KAPUTZ");
+		value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "KAPUTZ");
 	} else {
 		ieVariable VariableName;
 		VariableName.Format(Interface::GetDeathVarFormat(), parameters->string0Parameter);
@@ -681,7 +681,7 @@ int GameScript::NumDeadLT(Scriptable* Sender, const Trigger* parameters)
 
 int GameScript::G_Trigger(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
+	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
 	return (value == parameters->int0Parameter);
 }
 
@@ -689,7 +689,7 @@ int GameScript::Global(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid && value == parameters->int0Parameter) {
 		return 1;
 	}
@@ -698,7 +698,7 @@ int GameScript::Global(Scriptable* Sender, const Trigger* parameters)
 
 int GameScript::GLT_Trigger(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
+	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
 	return (value < parameters->int0Parameter);
 }
 
@@ -706,14 +706,14 @@ int GameScript::GlobalLT(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid && value < parameters->int0Parameter) return 1;
 	return 0;
 }
 
 int GameScript::GGT_Trigger(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
+	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
 	return (value > parameters->int0Parameter);
 }
 
@@ -721,7 +721,7 @@ int GameScript::GlobalGT(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid && value > parameters->int0Parameter) return 1;
 	return 0;
 }
@@ -730,9 +730,9 @@ int GameScript::GlobalLTGlobal(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
-		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid && value1 < value2) return 1;
 	}
 	return 0;
@@ -742,9 +742,9 @@ int GameScript::GlobalGTGlobal(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, {}, &valid);
 	if (valid) {
-		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, {}, &valid);
+		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, {}, &valid);
 		if (valid && value1 > value2) return 1;
 	}
 	return 0;
@@ -752,43 +752,43 @@ int GameScript::GlobalGTGlobal(Scriptable* Sender, const Trigger* parameters)
 
 int GameScript::GlobalsEqual(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "GLOBAL");
 	return (value1 == value2);
 }
 
 int GameScript::GlobalsGT(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "GLOBAL");
 	return (value1 > value2);
 }
 
 int GameScript::GlobalsLT(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "GLOBAL");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "GLOBAL");
 	return (value1 < value2);
 }
 
 int GameScript::LocalsEqual(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "LOCALS");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "LOCALS");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "LOCALS");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "LOCALS");
 	return (value1 == value2);
 }
 
 int GameScript::LocalsGT(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "LOCALS");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "LOCALS");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "LOCALS");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "LOCALS");
 	return (value1 > value2);
 }
 
 int GameScript::LocalsLT(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "LOCALS");
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "LOCALS");
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, "LOCALS");
+	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, parameters->symbol1, "LOCALS");
 	return (value1 < value2);
 }
 
@@ -796,7 +796,7 @@ int GameScript::RealGlobalTimerExact(Scriptable* Sender, const Trigger* paramete
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter, &valid);
 	if (valid && value1) {
 		ieDword value2 = core->GetGame()->RealTime;
 		if (value1 == value2) return 1;
@@ -808,7 +808,7 @@ int GameScript::RealGlobalTimerExpired(Scriptable* Sender, const Trigger* parame
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter, &valid);
 	if (valid && value1 && value1 < core->GetGame()->RealTime) return 1;
 	return 0;
 }
@@ -817,7 +817,7 @@ int GameScript::RealGlobalTimerNotExpired(Scriptable* Sender, const Trigger* par
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter, &valid);
 	if (valid && value1 && value1 > core->GetGame()->RealTime) return 1;
 	return 0;
 }
@@ -826,7 +826,7 @@ int GameScript::GlobalTimerExact(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter, &valid);
 	if (valid && value1 == core->GetGame()->GameTime) return 1;
 	return 0;
 }
@@ -835,7 +835,7 @@ int GameScript::GlobalTimerExpired(Scriptable* Sender, const Trigger* parameters
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter, &valid);
 	if (valid && (core->HasFeature(GFFlags::ZERO_TIMER_IS_VALID) || value1)) {
 		if (value1 < core->GetGame()->GameTime) return 1;
 	}
@@ -847,7 +847,7 @@ int GameScript::GlobalTimerNotExpired(Scriptable* Sender, const Trigger* paramet
 {
 	bool valid = true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid);
+	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter, &valid);
 	if (valid && value1 && value1 > core->GetGame()->GameTime) return 1;
 	return 0;
 }
@@ -3726,7 +3726,7 @@ int GameScript::StuffGlobalRandom(Scriptable* Sender, const Trigger* parameters)
 	} else {
 		Value = RandomNumValue;
 	}
-	SetVariable(Sender, parameters->string0Parameter, Value, parameters->resref1Parameter);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, Value, parameters->resref1Parameter);
 	return 1;
 }
 
@@ -4173,7 +4173,7 @@ int GameScript::SystemVariable_Trigger(Scriptable* Sender, const Trigger* parame
 			return 0;
 	}
 
-	SetVariable(Sender, parameters->string0Parameter, value);
+	SetVariable(Sender, parameters->string0Parameter, parameters->symbol0, value);
 	return 1;
 }
 
@@ -4838,7 +4838,7 @@ int GameScript::AreaCheckAllegiance(Scriptable* Sender, const Trigger* parameter
 
 int GameScript::Switch(Scriptable* Sender, const Trigger* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter);
+	ieDword value = CheckVariable(Sender, parameters->string0Parameter, parameters->symbol0, parameters->string1Parameter);
 	Sender->weightsAsCases = static_cast<unsigned char>(value);
 	return 0;
 }
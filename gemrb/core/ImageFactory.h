@@ -35,7 +35,8 @@ private:
 public:
 	ImageFactory(const ResRef& resref, Holder<Sprite2D> bitmap);
 
-	Holder<Sprite2D> GetSprite2D() const { return bitmap; }
+	Holder<Sprite2D> GetSprite2D() const { return Share(bitmap); }
+	size_t GetMemorySize() const override { return sizeof(*this) + (bitmap ? sizeof(Sprite2D) + bitmap->GetMemorySize() : 0); }
 };
 
 }
@@ -34,6 +34,7 @@
 #include "Debug.h"
 #include "DialogHandler.h"
 #include "DialogMgr.h"
+#include "DirectoryIndex.h"
 #include "DisplayMessage.h"
 #include "EffectQueue.h"
 #include "Factory.h"
@@ -44,6 +45,7 @@
 #include "MapMgr.h"
 #include "MoviePlayer.h"
 #include "MusicMgr.h"
+#include "PhaseTimer.h"
 #include "PluginLoader.h"
 #include "PluginMgr.h"
 #include "ProjectileServer.h"
@@ -53,6 +55,7 @@
 #include "SaveGameMgr.h"
 #include "ScriptedAnimation.h"
 #include "SymbolMgr.h"
+#include "TaskPool.h"
 #include "TileMap.h"
 #include "WorldMapMgr.h"
 
@@ -63,12 +66,20 @@
 #include "GUI/Label.h"
 #include "GUI/TextArea.h"
 #include "GUI/WindowManager.h"
+#include "GameScript/CompiledScript.h"
 #include "GameScript/GameScript.h"
 #include "Scriptable/Container.h"
+#include "Streams/FileCache.h"
 #include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
 #include "System/FileFilters.h"
+#if defined(SUPPORTS_MEMSTREAM)
+	#include "Streams/MappedFileMemoryStream.h"
+#endif
 #include "Video/Video.h"
 
+#include <atomic>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -90,6 +101,34 @@ static void ThrowException(const std::string& msg)
 	throw CIE(msg);
 }
 
+// the tlk importer reads mapped files in place instead of seeking around
+static DataStream* OpenTLK(const path_t& path)
+{
+#if defined(SUPPORTS_MEMSTREAM)
+	auto file = new MappedFileMemoryStream { path };
+	if (file->isOk()) {
+		return file;
+	}
+	delete file;
+#endif
+	return FileStream::OpenFile(path);
+}
+
+// touches every page of a mapped file, so the later reads don't wait for the disk
+static void PageIn(const DataStream* stream)
+{
+	const auto* mem = dynamic_cast<const MemoryStream*>(stream);
+	if (!mem) return;
+
+	const char* data = mem->GetBuffer();
+	char sum = 0;
+	for (strpos_t pos = 0; pos < mem->Size(); pos += 4096) {
+		sum ^= data[pos];
+	}
+	volatile char sink = sum;
+	(void) sink;
+}
+
 struct AbilityTables {
 	using AbilityTable = std::vector<ieWordSigned>;
 
@@ -224,9 +263,30 @@ Interface::Interface(CoreSettings&& cfg)
 	: config(std::move(cfg))
 {
 	Log(MESSAGE, "Core", "GemRB core version v" VERSION_GEMRB " loading ...");
+	PhaseTimer startup("startup");
+	startup.Begin("setup");
 
 	core = this;
 
+	// the stages that share nothing with the rest run on these, until their results are needed
+	std::unique_ptr<DataStream> tlkFiles[2];
+	TaskPool startupTasks(2);
+
+	// the files are only opened and paged in, the importer needs the plugins and the encoding
+	path_t tlkPaths[2] = { PathJoin(config.GamePath, "dialog.tlk"), PathJoin(config.GamePath, "dialogf.tlk") };
+	path_t tlkLanguagePaths[2] = { PathJoin(config.GamePath, config.GameLanguagePath, "dialog.tlk"), PathJoin(config.GamePath, config.GameLanguagePath, "dialogf.tlk") };
+	TaskPool::TaskID tlkTask = startupTasks.Add([&tlkFiles, tlkPaths, tlkLanguagePaths]() {
+		for (int i = 0; i < 2; ++i) {
+			DataStream* fs = OpenTLK(tlkPaths[i]);
+			if (!fs) {
+				// EE multi language deployment
+				fs = OpenTLK(tlkLanguagePaths[i]);
+			}
+			PageIn(fs);
+			tlkFiles[i].reset(fs);
+		}
+	});
+
 	SetDebugMode(DebugMode(config.debugMode));
 
 #if defined(WIN32)
@@ -251,13 +311,16 @@ Interface::Interface(CoreSettings&& cfg)
 	if (StupidityDetector(config.CachePath)) {
 		ThrowException(fmt::format("Cache path {} doesn't exist, not a folder or contains alien files!", config.CachePath));
 	}
-	if (!config.KeepCache) DelTree(config.CachePath, false);
+	// decompressed archives are verified on use, so they can stay
+	if (!config.KeepCache) ClearCache();
 
 	vars = std::move(config.vars);
 	// for simple GUIScript access
 	vars.Set("MaxPartySize", config.MaxPartySize);
 
+	startup.Begin("plugins");
 	LoadPlugins();
+	startup.Begin("video");
 	InitVideo();
 
 	// ask the driver if a touch device is in use
@@ -266,54 +329,54 @@ Interface::Interface(CoreSettings&& cfg)
 	Control::ActionRepeatDelay = config.ActionRepeatDelay;
 	GameControl::DebugFlags = config.DebugFlags;
 
+	startup.Begin("search path");
 	Log(MESSAGE, "Core", "Initializing search path...");
 	if (!IsAvailable(PLUGIN_RESOURCE_DIRECTORY)) {
 		ThrowException("no DirectoryImporter!");
 	}
 
-	path_t path = config.CachePath;
-	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY)) {
-		ThrowException("The cache path couldn't be registered, please check!");
-	}
+	// the sources are opened in parallel, but searched in this order
+	std::vector<ResourceManager::SourceDesc> sources;
+	sources.push_back({ config.CachePath, "Cache", PLUGIN_RESOURCE_DIRECTORY });
 
 	for (const auto& modPath : config.ModPath) {
-		gamedata->AddSource(modPath, "Mod paths", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+		sources.push_back({ modPath, "Mod paths", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 	}
 
-	path = PathJoin(config.GemRBOverridePath, "override", config.GameType);
+	path_t path = PathJoin(config.GemRBOverridePath, "override", config.GameType);
 	if (config.GameType == "auto") {
-		gamedata->AddSource(path, "GemRB Override", PLUGIN_RESOURCE_NULL);
+		sources.push_back({ path, "GemRB Override", PLUGIN_RESOURCE_NULL });
 	} else {
-		gamedata->AddSource(path, "GemRB Override", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+		sources.push_back({ path, "GemRB Override", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 	}
 
 	path = PathJoin(config.GemRBOverridePath, "override", "shared");
-	gamedata->AddSource(path, "shared GemRB Override", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+	sources.push_back({ path, "shared GemRB Override", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 
 	path = PathJoin(config.GamePath, config.GameOverridePath);
-	gamedata->AddSource(path, "Override", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+	sources.push_back({ path, "Override", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 
 	// GAME sounds are intentionally not cached, in IWD there are directory structures,
 	// that are not cacheable, also it is totally pointless (this fixed charsounds in IWD)
 	path = PathJoin(config.GamePath, config.GameSoundsPath);
-	gamedata->AddSource(path, "Sounds", PLUGIN_RESOURCE_DIRECTORY);
+	sources.push_back({ path, "Sounds", PLUGIN_RESOURCE_DIRECTORY });
 
 	path = PathJoin(config.GamePath, config.GameMoviesPath);
-	gamedata->AddSource(path, "Movies", PLUGIN_RESOURCE_DIRECTORY);
+	sources.push_back({ path, "Movies", PLUGIN_RESOURCE_DIRECTORY });
 
 	path = PathJoin(config.GamePath, config.GameScriptsPath);
-	gamedata->AddSource(path, "Scripts", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+	sources.push_back({ path, "Scripts", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 
 	path = PathJoin(config.GamePath, config.GamePortraitsPath);
-	gamedata->AddSource(path, "Portraits", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+	sources.push_back({ path, "Portraits", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 
 	path = PathJoin(config.GamePath, config.GameDataPath);
-	gamedata->AddSource(path, "Data", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+	sources.push_back({ path, "Data", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 
 	// accommodating silly installers that create a data/Data/.* structure
 	path = PathJoin(config.GamePath, config.GameDataPath, "Data");
 	if (DirExists(path)) {
-		gamedata->AddSource(path, "Data", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+		sources.push_back({ path, "Data", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 	}
 
 	// IWD2 movies are on the CD but not in the BIF
@@ -322,36 +385,45 @@ Interface::Interface(CoreSettings&& cfg)
 		for (size_t j = 0; j < config.CD[i].size(); j++) {
 			path = PathJoin(config.CD[i][j], config.GameDataPath);
 			if (DirExists(path)) {
-				gamedata->AddSource(path, description, PLUGIN_RESOURCE_CACHEDDIRECTORY);
+				sources.push_back({ path, description, PLUGIN_RESOURCE_CACHEDDIRECTORY });
 			}
 		}
 	}
 
 	Log(MESSAGE, "Core", "Initializing KEY Importer...");
+	size_t chitinSource = sources.size();
 	path_t ChitinPath = PathJoin(config.GamePath, "chitin.key");
-	if (!gamedata->AddSource(ChitinPath, "chitin.key", PLUGIN_RESOURCE_KEY)) {
-		Log(FATAL, "Core", "Failed to load \"chitin.key\"");
-		Log(ERROR, "Core", "This means:\n- you set the GamePath config variable incorrectly,\n\
-- you passed a bad game path to GemRB on the command line,\n\
-- you are not running GemRB from within a game dir,\n\
-- or the game is running (Windows only).");
-		ThrowException("The path must point to a game directory with a readable chitin.key file.");
-	}
+	sources.push_back({ ChitinPath, "chitin.key", PLUGIN_RESOURCE_KEY });
 
 	// most of the old gemrb override files can be found here,
 	// so they have a lower priority than the game files and can more easily be modded
 	path = PathJoin(config.GemRBUnhardcodedPath, "unhardcoded", config.GameType);
 	if (config.GameType == "auto") {
-		gamedata->AddSource(path, "GemRB Unhardcoded data", PLUGIN_RESOURCE_NULL);
+		sources.push_back({ path, "GemRB Unhardcoded data", PLUGIN_RESOURCE_NULL });
 	} else {
-		gamedata->AddSource(path, "GemRB Unhardcoded data", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+		sources.push_back({ path, "GemRB Unhardcoded data", PLUGIN_RESOURCE_CACHEDDIRECTORY });
 	}
 	path = PathJoin(config.GemRBUnhardcodedPath, "unhardcoded", "shared");
-	gamedata->AddSource(path, "shared GemRB Unhardcoded data", PLUGIN_RESOURCE_CACHEDDIRECTORY);
+	sources.push_back({ path, "shared GemRB Unhardcoded data", PLUGIN_RESOURCE_CACHEDDIRECTORY });
+
+	std::vector<bool> added = gamedata->AddSources(sources);
+	DirectoryIndex::Flush();
+	if (!added[0]) {
+		ThrowException("The cache path couldn't be registered, please check!");
+	}
+	if (!added[chitinSource]) {
+		Log(FATAL, "Core", "Failed to load \"chitin.key\"");
+		Log(ERROR, "Core", "This means:\n- you set the GamePath config variable incorrectly,\n\
+- you passed a bad game path to GemRB on the command line,\n\
+- you are not running GemRB from within a game dir,\n\
+- or the game is running (Windows only).");
+		ThrowException("The path must point to a game directory with a readable chitin.key file.");
+	}
 
 	if (!config.UseAsLibrary) {
 		fogRenderer = std::make_unique<FogRenderer>(config.SpriteFoW);
 
+		startup.Begin("gui script");
 		Log(MESSAGE, "Core", "Initializing GUI Script Engine...");
 		SetNextScript("Start"); // Start is the first script executed
 		guiscript = MakePluginHolder<ScriptEngine>(IE_GUI_SCRIPT_CLASS_ID);
@@ -372,6 +444,14 @@ Interface::Interface(CoreSettings&& cfg)
 	// Purposely add the font directory last since we will only ever need it at engine load time.
 	if (config.CustomFontPath[0]) gamedata->AddSource(config.CustomFontPath, "CustomFonts", PLUGIN_RESOURCE_DIRECTORY);
 
+	// the search path is complete, so the tables of the later stages can be found and read meanwhile
+	TaskPool::TaskID tablesTask = startupTasks.Add([]() {
+		gamedata->PrefetchTables({ ResRef("defsound"), ResRef("fonts"), ResRef("colors"), ResRef("itemtype"),
+					   ResRef("itemdata"), ResRef("slottype"), ResRef("randitem"), ResRef("gametime"),
+					   ResRef("dmginfo"), ResRef("script") });
+	});
+
+	startup.Begin("game options");
 	Log(MESSAGE, "Core", "Reading Game Options...");
 	LoadGemRBINI();
 
@@ -437,6 +517,7 @@ Interface::Interface(CoreSettings&& cfg)
 	strtok(&tmp[0], ".");
 	GameNameResRef = tmp;
 
+	startup.Begin("encoding");
 	Log(MESSAGE, "Core", "Reading Encoding Table...");
 	if (!LoadEncoding() && config.Encoding != "default") {
 		Log(ERROR, "Core", "Cannot load encoding from {}.", config.Encoding);
@@ -445,60 +526,53 @@ Interface::Interface(CoreSettings&& cfg)
 	Log(MESSAGE, "Core", "Creating Projectile Server...");
 	projserv = new ProjectileServer();
 
+	startup.Begin("strings");
 	Log(MESSAGE, "Core", "Checking for Dialogue Manager...");
 	strings = MakePluginHolder<StringMgr>(IE_TLK_CLASS_ID);
 	Log(MESSAGE, "Core", "Loading Dialog.tlk file...");
-	path_t strpath = PathJoin(config.GamePath, "dialog.tlk");
-	FileStream* fs = FileStream::OpenFile(strpath);
-
-	if (!fs) {
-		// EE multi language deployment
-		strpath = PathJoin(config.GamePath, config.GameLanguagePath, "dialog.tlk");
-		fs = FileStream::OpenFile(strpath);
-
-		if (!fs) {
-			ThrowException("Cannot find Dialog.tlk.");
-		}
+	startupTasks.Wait(tlkTask);
+	if (!tlkFiles[0]) {
+		ThrowException("Cannot find Dialog.tlk.");
 	}
-	strings->Open(fs);
+	strings->Open(tlkFiles[0].release());
 
 	// does the language use an extra tlk?
 	if (strings->HasAltTLK()) {
 		strings2 = MakePluginHolder<StringMgr>(IE_TLK_CLASS_ID);
 		Log(MESSAGE, "Core", "Loading DialogF.tlk file...");
-		strpath = PathJoin(config.GamePath, "dialogf.tlk");
-		fs = FileStream::OpenFile(strpath);
-		if (!fs) {
-			// try EE-style paths
-			strpath = PathJoin(config.GamePath, config.GameLanguagePath, "dialogf.tlk");
-			fs = FileStream::OpenFile(strpath);
-		}
-		if (!fs) {
+		if (!tlkFiles[1]) {
 			Log(ERROR, "Core", "Cannot find DialogF.tlk. Let us know which translation you are using.");
 			Log(ERROR, "Core", "Falling back to main TLK file, so female text may be wrong!");
 			strings2 = strings;
 		} else {
-			strings2->Open(fs);
+			strings2->Open(tlkFiles[1].release());
 		}
 	}
+	// or unused, if there's no need for it
+	tlkFiles[1] = nullptr;
 
+	startup.Begin("palettes");
 	Log(MESSAGE, "Core", "Loading palettes...");
 	LoadPalette<16>(Palette16, palettes16);
 	LoadPalette<32>(Palette32, palettes32);
 	LoadPalette<256>(Palette256, palettes256);
 	Log(MESSAGE, "Core", "Palettes loaded.");
 
+	startup.Begin("stock sounds");
 	Log(MESSAGE, "Core", "Initializing stock sounds...");
 	if (!gamedata->ReadResRefTable(ResRef("defsound"), gamedata->defaultSounds)) {
 		ThrowException("Cannot find defsound.2da.");
 	}
 
 	if (!config.UseAsLibrary) {
+		startup.Begin("sprites");
 		LoadSprites();
+		startup.Begin("fonts");
 		LoadFonts();
 		gamedata->PreloadColors();
 	}
 
+	startup.Begin("window manager");
 	Log(MESSAGE, "Core", "Initializing string constants...");
 	displaymsg = new DisplayMessage();
 
@@ -516,13 +590,15 @@ Interface::Interface(CoreSettings&& cfg)
 
 	QuitFlag = QF_CHANGESCRIPT;
 
+	startup.Begin("audio");
 	InitAudio();
 
+	startup.Begin("ini files");
 	if (HasFeature(GFFlags::HAS_PARTY_INI)) {
 		Log(MESSAGE, "Core", "Loading precreated teams setup...");
 		INIparty = MakePluginHolder<DataFileMgr>(IE_INI_CLASS_ID);
 		path_t tINIparty = PathJoin(config.GamePath, "Party.ini");
-		fs = FileStream::OpenFile(tINIparty);
+		FileStream* fs = FileStream::OpenFile(tINIparty);
 
 		if (!INIparty->Open(std::unique_ptr<DataStream> { fs })) {
 			Log(WARNING, "Core", "Failed to load precreated teams.");
@@ -537,7 +613,7 @@ Interface::Interface(CoreSettings&& cfg)
 		Log(MESSAGE, "Core", "Loading beasts definition File...");
 		INIbeasts = MakePluginHolder<DataFileMgr>(IE_INI_CLASS_ID);
 		path_t tINIbeasts = PathJoin(config.GamePath, "beast.ini");
-		fs = FileStream::OpenFile(tINIbeasts);
+		FileStream* fs = FileStream::OpenFile(tINIbeasts);
 
 		if (!INIbeasts->Open(std::unique_ptr<DataStream> { fs })) {
 			Log(WARNING, "Core", "Failed to load beast definitions.");
@@ -553,6 +629,7 @@ Interface::Interface(CoreSettings&& cfg)
 		}
 	}
 
+	startup.Begin("tables");
 	Log(MESSAGE, "Core", "Initializing Inventory Management...");
 	InitItemTypes();
 
@@ -576,10 +653,12 @@ Interface::Interface(CoreSettings&& cfg)
 		Log(WARNING, "Core", "Reading damage type table...");
 	}
 
+	startup.Begin("game script");
 	Log(MESSAGE, "Core", "Reading game script tables...");
 	InitializeIEScript();
 
 	if (!config.UseAsLibrary) {
+		startup.Begin("keymaps");
 		Log(MESSAGE, "Core", "Initializing keymap tables...");
 		keymap = new KeyMap();
 		ret = keymap->InitializeKeyMap("keymap.ini", "keymap");
@@ -588,7 +667,13 @@ Interface::Interface(CoreSettings&& cfg)
 		}
 	}
 
+	// the unused tables mustn't linger in the prefetcher
+	startupTasks.Wait(tablesTask);
+	gamedata->DropPrefetched();
+
+	startup.Stop();
 	Log(MESSAGE, "Core", "Core Initialization Complete!");
+	startup.Report(config.StartupProfile);
 
 #ifdef HAVE_REALPATH
 	if (unhardcodedTypePath[0] == '.') {
@@ -602,7 +687,7 @@ Interface::Interface(CoreSettings&& cfg)
 #endif
 	// dump the potentially changed unhardcoded path to a file that weidu looks at automatically to get our search paths
 	path_t pathString = fmt::format("GemRB_Data_Path = {}", unhardcodedTypePath);
-	strpath = PathJoin(config.GamePath, "gemrb_path.txt");
+	path_t strpath = PathJoin(config.GamePath, "gemrb_path.txt");
 	FileStream* pathFile = new FileStream();
 	// don't abort if something goes wrong, since it should never happen and it's not critical
 	if (pathFile->Create(strpath)) {
@@ -646,8 +731,10 @@ Interface::~Interface() noexcept
 	delete gamedata;
 	gamedata = nullptr;
 
-	// Removing all stuff from Cache, except bifs
-	if (!config.KeepCache) DelTree(config.CachePath, true);
+	// Removing all stuff from Cache, except bifs and the directory index
+	DirectoryIndex::Flush();
+	cacheWriter.WaitAll();
+	if (!config.KeepCache) ClearCache();
 }
 
 GameControl* Interface::StartGameControl()
@@ -2461,7 +2548,10 @@ void Interface::LoadGame(Holder<SaveGame> sg, int ver_override)
 	WorldMapArray* newWorldmap = nullptr;
 
 	LoadProgress(10);
-	if (!config.KeepCache) DelTree(config.CachePath, true);
+	// the prefetched area belongs to the old game, and its lookup uses the cache and the area extractor
+	gamedata->DropPrefetched(true);
+	cacheWriter.WaitAll();
+	if (!config.KeepCache) ClearCache();
 	LoadProgress(15);
 
 	saveGameAREExtractor = SaveGameAREExtractor(sg);
@@ -3043,6 +3133,10 @@ bool Interface::StupidityDetector(const path_t& path) const
 			if (name[0] == '.' && name[1] == '.' && name[2] == '\0') {
 				continue;
 			}
+			// our own
+			if (name == CompiledScriptDir) {
+				continue;
+			}
 			Log(ERROR, "Interface", "**contains another dir**");
 			return true; //a directory in there???
 		}
@@ -3640,10 +3734,12 @@ Effect* Interface::GetEffect(const ResRef& resname, int level, const Point& p)
 }
 
 // dealing with saved games
-int Interface::SwapoutArea(Map* map) const
+int Interface::SwapoutArea(Map* map)
 {
 	auto RemoveFromCache = [&](const ResRef& resref, SClass_ID classID) {
 		path_t filename = PathJoinExt(config.CachePath, resref, TypeExt(classID));
+		// an earlier swap out could still be writing it
+		cacheWriter.Wait(filename);
 		UnlinkFile(filename);
 	};
 
@@ -3661,16 +3757,17 @@ int Interface::SwapoutArea(Map* map) const
 	}
 	int size = mm->GetStoredFileSize(map);
 	if (size > 0) {
-		//created streams are always autofree (close file on destruct)
-		//this one will be destructed when we return from here
-		FileStream str;
-
-		str.Create(map->GetScriptName().c_str(), IE_ARE_CLASS_ID);
-		int ret = mm->PutArea(&str, map);
+		// the map goes away, so serialize it now, but leave the disk to the cache writer
+		path_t filename = PathJoinExt(config.CachePath, map->GetScriptName().c_str(), TypeExt(IE_ARE_CLASS_ID));
+		auto str = std::make_unique<MemoryStream>(filename, nullptr, 0);
+		int ret = mm->PutArea(str.get(), map);
 		if (ret < 0) {
 			Log(WARNING, "Core", "Area removed: {}",
 			    map->GetScriptName());
 			RemoveFromCache(map->GetScriptRef(), IE_ARE_CLASS_ID);
+		} else {
+			str->Rewind();
+			cacheWriter.Write(filename, str.release());
 		}
 	} else {
 		Log(WARNING, "Core", "Area removed: {}",
@@ -3782,7 +3879,7 @@ static bool IsBlobSaveItem(const path_t& path)
 	return areExt != path_t::npos && areExt == pathLength - 4;
 }
 
-int Interface::CompressSave(const path_t& folder, bool overrideRunning)
+int Interface::CompressSave(const path_t& folder, bool overrideRunning, bool fast)
 {
 	FileStream str;
 
@@ -3795,6 +3892,11 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 	ai->CreateArchive(&str);
 
 	tick_t startTime = GetMilliseconds();
+	// swapped out areas have to be on disk before the cache is archived
+	if (!cacheWriter.WaitAll()) {
+		return GEM_ERROR;
+	}
+
 	// If we override the savegame we are running to fetch AREs from, it has already dumped
 	// itself as "ares.blb" into the cache folder. Otherwise, just copy directly.
 	if (!overrideRunning && saveGameAREExtractor.copyRetainedAREs(&str) == GEM_ERROR) {
@@ -3802,6 +3904,14 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 		return GEM_ERROR;
 	}
 
+	// the files are only opened while they are worked on, so there are never many open at once
+	struct SaveEntry {
+		path_t path;
+		bool blob = false;
+		std::unique_ptr<DataStream> compressed;
+	};
+	std::vector<SaveEntry> entries;
+
 	dir.SetFlags(DirectoryIterator::Files);
 	//.tot and .toh should be saved last, because they are updated when an .are is saved
 	int priority = 2;
@@ -3810,19 +3920,13 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 			const path_t& name = dir.GetName();
 			if (SavedExtension(name) == priority) {
 				path_t dtmp = dir.GetFullPath();
-				FileStream fs;
-				if (!fs.Open(dtmp)) {
-					Log(ERROR, "Interface", "Failed to open \"{}\".", dtmp);
-				}
+				bool blob = IsBlobSaveItem(dtmp);
+				if (blob && !overrideRunning) continue;
 
-				if (IsBlobSaveItem(dtmp)) {
-					if (overrideRunning) {
-						saveGameAREExtractor.updateSaveGame(str.GetPos());
-						ai->AddToSaveGameCompressed(&str, &fs);
-					}
-				} else {
-					ai->AddToSaveGame(&str, &fs);
-				}
+				SaveEntry entry;
+				entry.path = std::move(dtmp);
+				entry.blob = blob;
+				entries.push_back(std::move(entry));
 			}
 		} while (++dir);
 		//reopen list for the second round
@@ -3832,6 +3936,49 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 		}
 	}
 
+	// the entries are compressed independently, so spread them over some threads
+	// and only assemble the archive in order afterwards
+	Compressor::Level level = fast ? Compressor::Level::Fast : Compressor::Level::Best;
+	std::atomic<size_t> nextEntry { 0 };
+	auto compressEntries = [&entries, &nextEntry, level]() {
+		PluginHolder<ArchiveImporter> archiver = MakePluginHolder<ArchiveImporter>(IE_SAV_CLASS_ID);
+		for (size_t i = nextEntry++; i < entries.size(); i = nextEntry++) {
+			SaveEntry& entry = entries[i];
+			if (entry.blob) continue;
+			// failures are reported when assembling
+			std::unique_ptr<DataStream> file(FileStream::OpenFile(entry.path));
+			if (!file) continue;
+			entry.compressed = std::make_unique<MemoryStream>(entry.path, nullptr, 0);
+			archiver->AddToSaveGame(entry.compressed.get(), file.get(), level);
+			entry.compressed->Rewind();
+		}
+	};
+	size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), entries.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(compressEntries);
+	}
+	compressEntries();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (auto& entry : entries) {
+		std::unique_ptr<DataStream> file;
+		if (entry.blob) {
+			file.reset(FileStream::OpenFile(entry.path));
+		}
+		DataStream* contents = entry.blob ? file.get() : entry.compressed.get();
+		if (!contents) {
+			Log(ERROR, "Interface", "Failed to open \"{}\".", entry.path);
+			continue;
+		}
+		if (entry.blob) {
+			saveGameAREExtractor.updateSaveGame(str.GetPos());
+		}
+		ai->AddToSaveGameCompressed(&str, contents);
+	}
+
 	tick_t endTime = GetMilliseconds();
 	Log(WARNING, "Core", "{} ms (compressing SAV file)", endTime - startTime);
 	return GEM_OK;
@@ -47,6 +47,7 @@
 #include "Audio/Playback.h"
 #include "GUI/Control.h"
 #include "GUI/Tooltip.h"
+#include "Streams/CacheWriter.h"
 #include "Strings/StringConversion.h"
 #include "Strings/StringMap.h"
 
@@ -371,6 +372,7 @@ public:
 	int EventFlag = EF_CONTROL;
 	Holder<SaveGame> LoadGameIndex;
 	SaveGameAREExtractor saveGameAREExtractor;
+	CacheWriter cacheWriter;
 	int VersionOverride = 0;
 	size_t SlotTypes = 0; // this is the same as the inventory size
 	ResRef GlobalScript = "BALDUR";
@@ -590,7 +592,7 @@ public:
 	int ApplyEffectQueue(EffectQueue* fxqueue, Actor* actor, Scriptable* caster, Point p) const;
 	Effect* GetEffect(const ResRef& resname, int level, const Point& p);
 	/** dumps an area object to the cache */
-	int SwapoutArea(Map* map) const;
+	int SwapoutArea(Map* map);
 	/** saves (exports a character to the characters folder */
 	int WriteCharacter(StringView name, const Actor* actor) const;
 	/** saves the game object to the destination folder */
@@ -598,7 +600,7 @@ public:
 	/** saves the worldmap object to the destination folder */
 	int WriteWorldMap(const path_t& folder);
 	/** saves the .are and .sto files to the destination folder */
-	int CompressSave(const path_t& folder, bool overrideRunning);
+	int CompressSave(const path_t& folder, bool overrideRunning, bool fast = false);
 	/** toggles the pause. returns either PAUSE_ON or PAUSE_OFF to reflect the script state after toggling. */
 	PauseState TogglePause() const;
 	/** returns true the passed pause setting was applied. false otherwise. */
@@ -159,6 +159,7 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	};
 
 	CONFIG_INT("Bpp", config.Bpp);
+	CONFIG_INT("CacheScripts", config.CacheScripts);
 	CONFIG_INT("CaseSensitive", config.CaseSensitive);
 	CONFIG_INT("DoubleClickDelay", config.DoubleClickDelay);
 	CONFIG_INT("DrawFPS", config.DrawFPS);
@@ -168,11 +169,14 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	CONFIG_INT("GCDebug", config.DebugFlags);
 	CONFIG_INT("GUIEnhancements", config.GUIEnhancements);
 	CONFIG_INT("Height", config.Height);
+	CONFIG_INT("IncrementalTriggers", config.IncrementalTriggers);
+	CONFIG_INT("IndexDirectories", config.IndexDirectories);
 	CONFIG_INT("KeepCache", config.KeepCache);
 	CONFIG_INT("MaxPartySize", config.MaxPartySize);
 	config.MaxPartySize = std::min(std::max(1, config.MaxPartySize), 10);
 	CONFIG_INT("MouseFeedback", config.MouseFeedback);
 	CONFIG_INT("MultipleQuickSaves", config.MultipleQuickSaves);
+	CONFIG_INT("FastQuickSaves", config.FastQuickSaves);
 	CONFIG_INT("UseAsLibrary", config.UseAsLibrary);
 	CONFIG_INT("RepeatKeyDelay", config.ActionRepeatDelay);
 	CONFIG_INT("SaveAsOriginal", config.SaveAsOriginal);
@@ -220,6 +224,7 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	// Path configuration
 	CONFIG_PATH("GemRBPath", config.GemRBPath);
 	CONFIG_PATH("CachePath", config.CachePath);
+	CONFIG_PATH("StartupProfile", config.StartupProfile);
 
 	// AppImage doesn't support relative urls at all
 	// we set the path to the data dir to cover unhardcoded and co,
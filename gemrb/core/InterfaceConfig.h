@@ -62,6 +62,7 @@ struct CoreSettings {
 	path_t GameMoviesPath = "movies";
 	path_t SavePath;
 	path_t CachePath = "./Cache2";
+	path_t StartupProfile; // where to write the startup timings as JSON, if anywhere
 	std::vector<path_t> CD[MAX_CD];
 	std::vector<path_t> ModPath;
 	path_t CustomFontPath = "/usr/share/fonts/TTF";
@@ -104,7 +105,11 @@ struct CoreSettings {
 	int GUIEnhancements = 23;
 
 	bool KeepCache = false;
+	bool IndexDirectories = true; // keep the listings of cached directories between runs
+	bool CacheScripts = true; // keep the parsed scripts between runs
+	bool IncrementalTriggers = true; // skip script conditions that can't have changed
 	bool MultipleQuickSaves = false;
+	bool FastQuickSaves = true; // compress quick and auto saves faster, but less
 	bool UseAsLibrary = false;
 	// once GemRB own format is working well, this might be set to 0
 	int SaveAsOriginal = 1; // if true, saves files in compatible mode
@@ -0,0 +1,115 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "LOSCache.h"
+
+#include "Map.h"
+
+#include <cstdlib>
+
+namespace GemRB {
+
+LOSCache::LOSCache()
+	: slots(new std::atomic<uint64_t>[SLOT_COUNT])
+{
+	Clear();
+}
+
+void LOSCache::Clear()
+{
+	for (size_t i = 0; i < SLOT_COUNT; i++) {
+		slots[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void LOSCache::Invalidate()
+{
+	epoch++;
+	if (epoch > EPOCH_MASK) {
+		// wrapped, so old slots could match again
+		Clear();
+		epoch = 1;
+	}
+}
+
+bool LOSCache::MakeKey(const SearchmapPoint& s, const SearchmapPoint& d, uint64_t& key)
+{
+	constexpr int limit = 1 << COORD_BITS;
+	for (int coord : { s.x, s.y, d.x, d.y }) {
+		if (coord < 0 || coord >= limit) return false;
+	}
+	key = uint64_t(s.x) | uint64_t(s.y) << COORD_BITS | uint64_t(d.x) << (2 * COORD_BITS) | uint64_t(d.y) << (3 * COORD_BITS);
+	return true;
+}
+
+size_t LOSCache::GetSlot(uint64_t key)
+{
+	// fibonacci hashing, the coordinates alone cluster badly
+	return size_t((key * 0x9E3779B97F4A7C15ULL) >> (64 - SLOT_BITS));
+}
+
+bool LOSCache::WalkLine(const TileProps& props, const SearchmapPoint& s, const SearchmapPoint& d)
+{
+	// bresenham, only integer steps
+	int dx = std::abs(d.x - s.x);
+	int dy = -std::abs(d.y - s.y);
+	int sx = s.x < d.x ? 1 : -1;
+	int sy = s.y < d.y ? 1 : -1;
+	int err = dx + dy;
+	SearchmapPoint p = s;
+	while (p != d) {
+		int err2 = 2 * err;
+		if (err2 >= dy) {
+			err += dy;
+			p.x += sx;
+		}
+		if (err2 <= dx) {
+			err += dx;
+			p.y += sy;
+		}
+
+		PathMapFlags flags = props.QuerySearchMap(p);
+		if (bool(flags & (PathMapFlags::SIDEWALL | PathMapFlags::DOOR_OPAQUE))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool LOSCache::IsVisible(const TileProps& props, const SearchmapPoint& s, const SearchmapPoint& d) const
+{
+	uint64_t key;
+	if (!enabled || !MakeKey(s, d, key)) {
+		return WalkLine(props, s, d);
+	}
+
+	std::atomic<uint64_t>& slot = slots[GetSlot(key)];
+	uint64_t tag = key | epoch << KEY_BITS;
+	uint64_t value = slot.load(std::memory_order_relaxed);
+	if ((value & ~VISIBLE_BIT) == tag) {
+		return value & VISIBLE_BIT;
+	}
+
+	bool visible = WalkLine(props, s, d);
+	slot.store(tag | (visible ? VISIBLE_BIT : 0), std::memory_order_relaxed);
+	return visible;
+}
+
+}
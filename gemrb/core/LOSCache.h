@@ -0,0 +1,85 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef LOS_CACHE_H
+#define LOS_CACHE_H
+
+#include "exports.h"
+
+#include "PathFinder.h"
+
+#include <atomic>
+#include <memory>
+
+namespace GemRB {
+
+class TileProps;
+
+/**
+ * Line of sight results between pairs of searchmap cells.
+ *
+ * Only the wall and opaque door bits of the searchmap block sight, so a
+ * result stays valid until a door changes them. Instead of tracking which
+ * lines a door crosses, any such change bumps the epoch, which invalidates
+ * everything at once.
+ *
+ * The table is direct mapped with a fixed size, so colliding lines just
+ * evict each other. Every slot is a single atomic word, since the path
+ * workers of Map::FindPaths also check sight.
+ */
+class GEM_EXPORT LOSCache {
+public:
+	static constexpr int SLOT_BITS = 15;
+	static constexpr size_t SLOT_COUNT = size_t(1) << SLOT_BITS;
+
+	// turning this off makes IsVisible walk every line
+	bool enabled = true;
+
+	LOSCache();
+
+	// the searchmap changed in a way that could affect sight, eg. a door
+	void Invalidate();
+	bool IsVisible(const TileProps& props, const SearchmapPoint& s, const SearchmapPoint& d) const;
+
+	// the uncached check: walks the cells between s and d, excluding s
+	static bool WalkLine(const TileProps& props, const SearchmapPoint& s, const SearchmapPoint& d);
+
+private:
+	// a slot packs the 4 coordinates, the epoch and the result
+	static constexpr int COORD_BITS = 12;
+	static constexpr int EPOCH_BITS = 15;
+	static constexpr int KEY_BITS = 4 * COORD_BITS;
+	static constexpr uint64_t KEY_MASK = (uint64_t(1) << KEY_BITS) - 1;
+	static constexpr uint64_t EPOCH_MASK = (uint64_t(1) << EPOCH_BITS) - 1;
+	static constexpr uint64_t VISIBLE_BIT = uint64_t(1) << (KEY_BITS + EPOCH_BITS);
+
+	std::unique_ptr<std::atomic<uint64_t>[]> slots;
+	// 0 is never used, so empty slots can't match
+	uint64_t epoch = 1;
+
+	void Clear();
+	// false if a coordinate doesn't fit in the key
+	static bool MakeKey(const SearchmapPoint& s, const SearchmapPoint& d, uint64_t& key);
+	static size_t GetSlot(uint64_t key);
+};
+
+}
+
+#endif
@@ -23,7 +23,9 @@
 
 #include "Strings/StringView.h"
 
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -31,12 +33,12 @@ namespace GemRB {
 
 struct VarEntry;
 
-/* Not thread-safe, PRED is an eviction predicate */
-template<typename T, class PRED>
+/* Not thread-safe, PRED is an eviction predicate, string keys are passed as views */
+template<typename T, class PRED, typename KEY = std::string>
 class LRUCache {
 public:
-	using key_t = std::string;
-	using public_key_t = StringView;
+	using key_t = KEY;
+	using public_key_t = std::conditional_t<std::is_same<KEY, std::string>::value, StringView, KEY>;
 
 private:
 	/* Queue items are placed into a doubly-linked list, the front element is the LRU. */
@@ -72,16 +74,12 @@ private:
 public:
 	explicit LRUCache(size_t size)
 		: cacheSize(size) {}
+	LRUCache(const LRUCache&) = delete;
 	~LRUCache()
 	{
-		auto next = front;
-
-		while (next != nullptr) {
-			auto _next = next->next;
-			delete next;
-			next = _next;
-		}
+		Clear();
 	}
+	LRUCache& operator=(const LRUCache&) = delete;
 
 	template<typename... ARGS>
 	void SetAt(const public_key_t& key, ARGS&&... args)
@@ -93,7 +91,7 @@ public:
 		auto insertion =
 			map.emplace(
 				std::piecewise_construct,
-				std::forward_as_tuple(key.c_str()),
+				std::forward_as_tuple(MakeKey(key)),
 				std::forward_as_tuple(std::forward<ARGS>(args)...));
 
 		if (!insertion.second) {
@@ -117,29 +115,32 @@ public:
 
 	const T* Lookup(const public_key_t& key) const
 	{
-		std::string _key { key.c_str() };
-		auto lookup = map.find(_key);
+		auto lookup = map.find(MakeKey(key));
 
 		return lookup != map.cend() ? &lookup->second.value : nullptr;
 	}
 
 	bool Touch(const public_key_t& key)
 	{
-		std::string _key { key.c_str() };
-		auto lookup = map.find(_key);
+		return LookupAndTouch(key) != nullptr;
+	}
+
+	/* Lookup and Touch with a single search */
+	const T* LookupAndTouch(const public_key_t& key)
+	{
+		auto lookup = map.find(MakeKey(key));
 
 		if (lookup != map.cend()) {
 			moveToBack(lookup->second.queueItem);
-			return true;
+			return &lookup->second.value;
 		}
 
-		return false;
+		return nullptr;
 	}
 
 	bool Remove(const public_key_t& key)
 	{
-		std::string _key { key.c_str() };
-		auto lookup = map.find(_key);
+		auto lookup = map.find(MakeKey(key));
 
 		if (lookup != map.cend()) {
 			unlink(lookup->second.queueItem);
@@ -152,7 +153,31 @@ public:
 		return false;
 	}
 
+	void Clear()
+	{
+		auto next = front;
+
+		while (next != nullptr) {
+			auto _next = next->next;
+			delete next;
+			next = _next;
+		}
+		front = nullptr;
+		back = nullptr;
+		map.clear();
+	}
+
 private:
+	static key_t MakeKey(const StringView& key)
+	{
+		return key_t { key.c_str() };
+	}
+
+	static const key_t& MakeKey(const key_t& key)
+	{
+		return key;
+	}
+
 	void evict()
 	{
 		auto next = front;
@@ -178,6 +203,9 @@ private:
 		item->prev = back;
 		if (item->prev != nullptr) {
 			item->prev->next = item;
+		} else {
+			// it was the only item
+			this->front = item;
 		}
 		this->back = item;
 	}
@@ -53,8 +53,10 @@
 #include "Scriptable/InfoPoint.h"
 #include "Video/Video.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <climits>
 #include <unordered_map>
 #include <utility>
 
@@ -441,10 +443,13 @@ Map::Map(TileMap* tm, TileProps props, Holder<Sprite2D> sm)
 {
 	area = this;
 	MasterArea = core->GetGame()->MasterArea(scriptName);
+	pathClusters.Reset(tileProps.GetSize());
 }
 
 Map::~Map(void)
 {
+	WaitForPaths();
+
 	//close the current container if it was owned by this map, this avoids a crash
 	const Container* c = core->GetCurrentContainer();
 	if (c && c->GetCurrentArea() == this) {
@@ -488,7 +493,11 @@ Map::~Map(void)
 
 void Map::SetTileMapProps(TileProps props)
 {
+	WaitForPaths();
 	tileProps = std::move(props);
+	pathClusters.Reset(tileProps.GetSize());
+	losCache.Invalidate();
+	searchMapEpoch++;
 }
 
 const MapReverbProperties& Map::GetReverbProperties() const
@@ -641,6 +650,32 @@ void Map::UseExit(Actor* actor, InfoPoint* ip)
 	}
 }
 
+void Map::PrefetchExits() const
+{
+	// roughly a screen, so the area can be read while the party walks up
+	static constexpr int prefetchDistance = 640;
+
+	const InfoPoint* nearest = nullptr;
+	unsigned int nearestDistance = prefetchDistance * prefetchDistance;
+	for (const auto& ip : TMap->GetInfoPoints()) {
+		if (ip->Type != ST_TRAVEL || ip->Destination.IsEmpty()) continue;
+
+		Point exit = ip->BBox.Center();
+		for (const auto& actor : actors) {
+			if (!actor->InParty) continue;
+			unsigned int distance = SquaredDistance(actor->Pos, exit);
+			if (distance < nearestDistance) {
+				nearestDistance = distance;
+				nearest = ip;
+			}
+		}
+	}
+
+	if (nearest) {
+		gamedata->PrefetchArea(nearest->Destination);
+	}
+}
+
 //Draw two overlapped animations to achieve the original effect
 //PlayOnce makes sure that if we stop drawing them, they will go away
 void Map::DrawPortal(const InfoPoint* ip, int enable)
@@ -668,7 +703,13 @@ void Map::DrawPortal(const InfoPoint* ip, int enable)
 
 void Map::UpdateScripts()
 {
+	// the searches dispatched since the last update, before anyone moves
+	DeliverPaths();
 	traversabilityCache.MarkNewFrame();
+	// catch any stat changes that didn't go through Actor::SetStat
+	actorIndex.Refresh();
+	// and any moves that didn't go through SetPos
+	actorGrid.Refresh();
 
 	bool has_pcs = false;
 	for (const auto& actor : actors) {
@@ -884,6 +925,12 @@ void Map::UpdateScripts()
 		ip->Update();
 	}
 
+	// a second between checks is still plenty of warning
+	if (has_pcs && time >= nextExitPrefetch) {
+		nextExitPrefetch = time + core->Time.defaultTicksPerSec;
+		PrefetchExits();
+	}
+
 	UpdateSpawns();
 	GenerateQueues();
 	SortQueues();
@@ -934,12 +981,21 @@ void Map::DoStepForActor(Actor* actor, ieDword time) const
 
 void Map::BlockSearchMapFor(const Movable* actor) const
 {
+	WaitForPaths();
 	auto flag = actor->IsPC() ? PathMapFlags::PC : PathMapFlags::NPC;
 	tileProps.PaintSearchMap(actor->SMPos, actor->circleSize, flag);
 }
 
+// the cells painted by BlockSearchMapFor, rounded up to the enclosing square
+Region Map::SearchMapFootprint(const Movable* actor) const
+{
+	int radius = Clamp<int>(actor->circleSize, 1, MAX_CIRCLESIZE) - 1;
+	return Region(actor->SMPos.x - radius, actor->SMPos.y - radius, 2 * radius + 1, 2 * radius + 1);
+}
+
 void Map::ClearSearchMapFor(const Movable* actor) const
 {
+	WaitForPaths();
 	std::vector<Actor*> nearActors = GetAllActorsInRadius(actor->Pos, GA_NO_SELF | GA_NO_DEAD | GA_NO_LOS | GA_NO_UNSCHEDULED, MAX_CIRCLE_SIZE * 3, actor);
 	tileProps.PaintSearchMap(actor->SMPos, actor->circleSize, PathMapFlags::UNMARKED);
 
@@ -1202,8 +1258,7 @@ void Map::DrawMap(const Region& viewport, FogRenderer& fogRenderer, uint32_t dFl
 	// draw reticles before actors
 	core->GetGameControl()->DrawTargetReticles();
 
-	const auto& viewportWalls = WallsIntersectingRegion(viewport, false);
-	RedrawScreenStencil(viewport, viewportWalls.first);
+	RedrawScreenStencil(viewport);
 	VideoDriver->SetStencilBuffer(wallStencil);
 
 	//draw all background animations first
@@ -1874,7 +1929,8 @@ int Map::CountSummons(ieDword flags, ieDword sex) const
 bool Map::AnyEnemyNearPoint(const Point& p) const
 {
 	ieDword gametime = core->GetGame()->GameTime;
-	for (const Actor* actor : actors) {
+	std::vector<Actor*> nearby;
+	for (const Actor* actor : GetActorsNear(p, SPAWN_RANGE, nearby)) {
 		if (!actor->Schedule(gametime, true)) {
 			continue;
 		}
@@ -1950,7 +2006,9 @@ void Map::MarkVisited(const Actor* actor) const
 		if (!key.Format("{}_visited", scriptName)) {
 			Log(ERROR, "Map", "Area {} has a too long script name for generating _visited globals!", scriptName);
 		}
-		core->GetGame()->locals[key] = 1;
+		Game* game = core->GetGame();
+		game->locals[key] = 1;
+		game->VariablesChanged();
 	}
 }
 
@@ -1960,6 +2018,8 @@ void Map::AddActor(Actor* actor, bool init)
 	actor->AreaName = scriptName;
 	if (!HasActor(actor)) {
 		actors.push_back(actor);
+		actorIndex.AddActor(actor);
+		actorGrid.AddActor(actor);
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -1988,6 +2048,8 @@ bool Map::AnyPCSeesEnemy() const
 void Map::DeleteActor(size_t idx)
 {
 	Actor* actor = actors[idx];
+	actorIndex.RemoveActor(actor);
+	actorGrid.RemoveActor(actor);
 	if (actor) {
 		actor->Stop(); // just in case
 		Game* game = core->GetGame();
@@ -2134,9 +2196,18 @@ std::vector<Scriptable*> Map::GetScriptablesInRect(const Point& p, unsigned int
 	return neighbours;
 }
 
+const std::vector<Actor*>& Map::GetActorsNear(const Point& p, unsigned int radius, std::vector<Actor*>& buffer) const
+{
+	if (actorGrid.GetCandidates(p, radius, buffer)) {
+		return buffer;
+	}
+	return actors;
+}
+
 Actor* Map::GetActor(const Point& p, int flags, const Movable* checker) const
 {
-	for (auto actor : actors) {
+	std::vector<Actor*> nearby;
+	for (auto actor : GetActorsNear(p, 0, nearby)) {
 		if (!actor->IsOver(p))
 			continue;
 		if (!actor->ValidTarget(flags, checker)) {
@@ -2149,7 +2220,8 @@ Actor* Map::GetActor(const Point& p, int flags, const Movable* checker) const
 
 Actor* Map::GetActorInRadius(const Point& p, int flags, unsigned int radius, const Scriptable* checker) const
 {
-	for (auto actor : actors) {
+	std::vector<Actor*> nearby;
+	for (auto actor : GetActorsNear(p, radius, nearby)) {
 		if (PersonalDistance(p, actor) > radius)
 			continue;
 		if (!actor->ValidTarget(flags, checker)) {
@@ -2163,7 +2235,9 @@ Actor* Map::GetActorInRadius(const Point& p, int flags, unsigned int radius, con
 std::vector<Actor*> Map::GetAllActorsInRadius(const Point& p, int flags, unsigned int radius, const Scriptable* see) const
 {
 	std::vector<Actor*> neighbours;
-	for (auto actor : actors) {
+	std::vector<Actor*> nearby;
+	// the range is in feet, which are at most 16 pixels, see Feet2Pixels
+	for (auto actor : GetActorsNear(p, std::min(radius, UINT_MAX / 16) * 16, nearby)) {
 		if (!WithinRange(actor, p, radius)) {
 			continue;
 		}
@@ -2404,8 +2478,10 @@ Actor* Map::GetActorByScriptName(const ieVariable& name) const
 std::vector<Actor*> Map::GetActorsInRect(const Region& rgn, int excludeFlags) const
 {
 	std::vector<Actor*> actorlist;
-	actorlist.reserve(actors.size());
-	for (auto actor : actors) {
+	std::vector<Actor*> nearby;
+	const std::vector<Actor*>& candidates = actorGrid.GetCandidates(rgn, nearby) ? nearby : actors;
+	actorlist.reserve(candidates.size());
+	for (auto actor : candidates) {
 		if (!actor->ValidTarget(excludeFlags))
 			continue;
 		if (!rgn.PointInside(actor->Pos) && !actor->IsOver(rgn.origin)) // imagine drawing a tiny box inside the circle, but not over the center
@@ -2660,16 +2736,20 @@ PathMapFlags Map::GetBlockedInLineTile(const SearchmapPoint& s, const SearchmapP
 }
 
 // PathMapFlags::SIDEWALL obstructs LOS, while PathMapFlags::IMPASSABLE doesn't
-bool Map::IsVisibleLOS(const Point& s, const Point& d, const Actor* caller) const
+// this used to be GetBlockedInLine, which differs from the cached walk in a few ways:
+// - the caller only scaled its step size by the actor speed, so it is ignored now
+// - its steps were up to two cells (or pixels) long, so it could miss a thin wall
+//   or cut a corner; the walk checks every cell on the line exactly once
+// - the navmap version works on whole cells, so the offset inside them is lost
+// MapTest.LOSMatchesBlockedInLine keeps the differences rare (about 1% of the lines)
+bool Map::IsVisibleLOS(const Point& s, const Point& d, const Actor* /*caller*/) const
 {
-	PathMapFlags ret = GetBlockedInLine(s, d, false, caller);
-	return !bool(ret & PathMapFlags::SIDEWALL);
+	return losCache.IsVisible(tileProps, SearchmapPoint(s), SearchmapPoint(d));
 }
 
-bool Map::IsVisibleLOS(const SearchmapPoint& s, const SearchmapPoint& d, const Actor* caller) const
+bool Map::IsVisibleLOS(const SearchmapPoint& s, const SearchmapPoint& d, const Actor* /*caller*/) const
 {
-	PathMapFlags ret = GetBlockedInLineTile(s, d, false, caller);
-	return !bool(ret & PathMapFlags::SIDEWALL);
+	return losCache.IsVisible(tileProps, s, d);
 }
 
 // Used by the pathfinder, so PathMapFlags::IMPASSABLE obstructs walkability
@@ -2687,25 +2767,140 @@ bool Map::IsWalkableTo(const SearchmapPoint& s, const SearchmapPoint& d, bool ac
 	return bool(ret & mask);
 }
 
-void Map::RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls)
+// GetBlockedInLine with stopOnImpassable, for the walk of the request's caller
+bool Map::IsWalkableFor(const PathRequest& request, const NavmapPoint& s, const NavmapPoint& d) const
+{
+	PathMapFlags ret = PathMapFlags::IMPASSABLE;
+	NavmapPoint p = s;
+	SearchmapPoint sms { s };
+	while (p != d) {
+		float_t dx = d.x - p.x;
+		float_t dy = d.y - p.y;
+		NormalizeDeltas(dx, dy, request.stepFactor);
+		p.x += dx;
+		p.y += dy;
+		SearchmapPoint smp { p };
+		if (sms == smp) continue;
+
+		const PathMapFlags blockStatus = request.caller ? GetBlockedInRadiusFor(request, smp) : GetBlockedTile(smp);
+		if (blockStatus == PathMapFlags::IMPASSABLE) {
+			return false;
+		}
+		ret |= blockStatus;
+	}
+	if (bool(ret & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR | PathMapFlags::SIDEWALL))) {
+		ret &= ~PathMapFlags::PASSABLE;
+	}
+	if (bool(ret & PathMapFlags::DOOR_OPAQUE)) {
+		ret = PathMapFlags::SIDEWALL;
+	}
+
+	PathMapFlags mask = PathMapFlags::PASSABLE | (request.flags & PF_ACTORS_ARE_BLOCKING ? PathMapFlags::UNMARKED : PathMapFlags::ACTOR);
+	return bool(ret & mask);
+}
+
+// GetBlockedInRadiusTile, except that the caller doesn't block itself: the queued
+// searches run while it's still on the searchmap, unlike the ones from FindPath
+PathMapFlags Map::GetBlockedInRadiusFor(const PathRequest& request, const SearchmapPoint& tp) const
+{
+	uint16_t size = Clamp<uint16_t>(request.size, 2, MAX_CIRCLESIZE);
+	uint16_t r = size - 2;
+	if (request.footprint.size.IsInvalid() || !Region(tp.x - r, tp.y - r, 2 * r + 1, 2 * r + 1).IntersectsRegion(request.footprint)) {
+		return GetBlockedInRadiusTile(tp, request.size);
+	}
+
+	PathMapFlags ret = PathMapFlags::IMPASSABLE;
+	std::vector<BasePoint> points;
+	if (r == 0) {
+		points.push_back(tp);
+		points.push_back(tp);
+	} else {
+		points = PlotCircle(tp, r);
+	}
+	for (size_t i = 0; i < points.size(); i += 2) {
+		const BasePoint& p1 = points[i];
+		const BasePoint& p2 = points[i + 1];
+		for (int x = p2.x; x <= p1.x; ++x) {
+			SearchmapPoint smp(x, p1.y);
+			PathMapFlags flags = tileProps.QuerySearchMap(smp);
+			if (request.footprint.PointInside(Point(x, p1.y))) {
+				flags &= ~PathMapFlags::ACTOR;
+			}
+			if (bool(flags & PathMapFlags::TRAVEL)) {
+				flags |= PathMapFlags::PASSABLE;
+			}
+			if (bool(flags & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR))) {
+				flags &= ~PathMapFlags::PASSABLE;
+			}
+			if (bool(flags & PathMapFlags::DOOR_OPAQUE)) {
+				flags = PathMapFlags::SIDEWALL;
+			}
+			if (flags == PathMapFlags::IMPASSABLE) {
+				return PathMapFlags::IMPASSABLE;
+			}
+			ret |= flags;
+		}
+	}
+
+	if (bool(ret & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR | PathMapFlags::SIDEWALL))) {
+		ret &= ~PathMapFlags::PASSABLE;
+	}
+	if (bool(ret & PathMapFlags::DOOR_OPAQUE)) {
+		ret = PathMapFlags::SIDEWALL;
+	}
+	return ret;
+}
+
+void Map::RedrawScreenStencil(const Region& vp)
 {
-	if (stencilViewport == vp) {
-		assert(wallStencil);
+	if (wallStencil && stencilViewport == vp && stencilWallGeneration == wallGeneration) {
 		return;
 	}
 
+	// when scrolling, shift the old contents and only draw the uncovered strips
+	Point delta = stencilViewport.origin - vp.origin;
+	bool scrolled = wallStencil && stencilWallGeneration == wallGeneration && stencilViewport.size == vp.size &&
+		std::abs(delta.x) < vp.w && std::abs(delta.y) < vp.h && wallStencil->Scroll(delta);
+
 	stencilViewport = vp;
+	stencilWallGeneration = wallGeneration;
 
-	if (wallStencil == nullptr) {
-		// FIXME: this should be forced 8bit*4 color format
-		// but currently that is forcing some performance killing conversion issues on some platforms
-		// for now things will break if we use 16 bit color settings
-		wallStencil = VideoDriver->CreateBuffer(Region(Point(), vp.size), Video::BufferFormat::DISPLAY_ALPHA);
+	if (!scrolled) {
+		if (wallStencil == nullptr || wallStencil->Size() != vp.size) {
+			// FIXME: this should be forced 8bit*4 color format
+			// but currently that is forcing some performance killing conversion issues on some platforms
+			// for now things will break if we use 16 bit color settings
+			wallStencil = VideoDriver->CreateBuffer(Region(Point(), vp.size), Video::BufferFormat::DISPLAY_ALPHA);
+		}
+
+		wallStencil->Clear();
+		DrawStencil(wallStencil, vp, WallsIntersectingRegion(vp, false).first);
+		return;
 	}
 
-	wallStencil->Clear();
+	// in stencil coordinates
+	std::vector<Region> strips;
+	if (delta.x > 0) {
+		strips.emplace_back(0, 0, delta.x, vp.h);
+	} else if (delta.x < 0) {
+		strips.emplace_back(vp.w + delta.x, 0, -delta.x, vp.h);
+	}
+	if (delta.y > 0) {
+		strips.emplace_back(0, 0, vp.w, delta.y);
+	} else if (delta.y < 0) {
+		strips.emplace_back(0, vp.h + delta.y, vp.w, -delta.y);
+	}
 
-	DrawStencil(wallStencil, vp, walls);
+	// the clip keeps the walls from overdrawing the shifted part
+	const Region oldClip = VideoDriver->GetScreenClip();
+	for (const Region& strip : strips) {
+		VideoDriver->SetScreenClip(&strip);
+		VideoDriver->PushDrawingBuffer(wallStencil);
+		VideoDriver->DrawRect(strip, Color(), true);
+		VideoDriver->PopDrawingBuffer();
+		DrawStencil(wallStencil, vp, WallsIntersectingRegion(Region(strip.origin + vp.origin, strip.size), false).first);
+	}
+	VideoDriver->SetScreenClip(&oldClip);
 }
 
 void Map::DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const
@@ -2949,6 +3144,8 @@ void Map::RemoveActor(Actor* actor)
 			ClearSearchMapFor(actor);
 			actor->SetMap(nullptr);
 			actor->AreaName.Reset();
+			actorIndex.RemoveActor(actor);
+			actorGrid.RemoveActor(actor);
 			actors.erase(actors.begin() + i);
 			return;
 		}
@@ -3486,6 +3683,8 @@ Size Map::GetSize() const
 void Map::FillExplored(bool explored)
 {
 	ExploredBitmap.fill(explored ? 0xff : 0x00);
+	// the standing actors have to uncover their surroundings again
+	fogDirty = true;
 }
 
 void Map::ExploreTile(const FogPoint& fogP, bool fogOnly)
@@ -3499,13 +3698,21 @@ void Map::ExploreTile(const FogPoint& fogP, bool fogOnly)
 	if (!fogOnly) {
 		VisibleBitmap[fogP] = true;
 	}
+	fogDirty = true;
 }
 
-void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
+void Map::TraceVisibility(const SearchmapPoint& pos, int range, int los, std::vector<int>& visible, std::vector<int>& fogOnlyTiles) const
 {
 	SearchmapPoint tile;
 	FogPoint fogTile;
 	const Explore& explore = Explore::Get();
+	const Size fogSize = FogMapSize();
+
+	auto addTile = [&](bool fogOnly) {
+		if (!fogSize.PointInside(fogTile)) return;
+		int idx = fogTile.y * fogSize.w + fogTile.x;
+		(fogOnly ? fogOnlyTiles : visible).push_back(idx);
+	};
 
 	if (range > Explore::MaxVisibility) {
 		range = Explore::MaxVisibility;
@@ -3521,7 +3728,7 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 			fogTile = FogPoint(tile);
 
 			if (!los) {
-				ExploreTile(fogTile, fogOnly);
+				addTile(fogOnly);
 				continue;
 			}
 
@@ -3543,18 +3750,42 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 				Pass--;
 				if (!Pass) break;
 			}
-			ExploreTile(fogTile, fogOnly);
+			addTile(fogOnly);
 		}
 	}
+
+	// neighbouring rays mostly cover the same (much bigger) fog tiles
+	for (auto tiles : { &visible, &fogOnlyTiles }) {
+		std::sort(tiles->begin(), tiles->end());
+		tiles->erase(std::unique(tiles->begin(), tiles->end()), tiles->end());
+	}
+}
+
+void Map::ApplyFogTiles(const std::vector<int>& visible, const std::vector<int>& fogOnly)
+{
+	for (int idx : visible) {
+		ExploredBitmap[idx] = true;
+		VisibleBitmap[idx] = true;
+	}
+	for (int idx : fogOnly) {
+		ExploredBitmap[idx] = true;
+	}
+}
+
+void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
+{
+	std::vector<int> visible;
+	std::vector<int> fogOnly;
+	TraceVisibility(pos, range, los, visible, fogOnly);
+	ApplyFogTiles(visible, fogOnly);
+	fogDirty = true;
 }
 
 void Map::UpdateFog()
 {
 	TRACY(ZoneScoped);
-	// don't reset in cutscenes just in case the PST ExploreMapChunk action was ran
-	if (!core->InCutSceneMode()) {
-		VisibleBitmap.fill(0);
-	}
+	fogPass++;
+	bool changed = false;
 
 	std::set<Spawn*> potentialSpawns;
 	for (const auto actor : actors) {
@@ -3565,7 +3796,20 @@ void Map::UpdateFog()
 
 		int vis2 = actor->GetVisualRange();
 		if ((state & STATE_BLIND) || (vis2 < 2)) vis2 = 2; //can see only themselves
-		ExploreMapChunk(actor->SMPos, vis2 + actor->GetAnims()->GetCircleSize(), 1);
+		int range = vis2 + actor->GetAnims()->GetCircleSize();
+
+		// only retrace the sight of actors that moved or changed
+		FogFootprint& footprint = fogFootprints[actor];
+		if (footprint.epoch != searchMapEpoch || footprint.pos != actor->SMPos || footprint.range != range) {
+			footprint.epoch = searchMapEpoch;
+			footprint.pos = actor->SMPos;
+			footprint.range = range;
+			footprint.visible.clear();
+			footprint.fogOnly.clear();
+			TraceVisibility(actor->SMPos, range, 1, footprint.visible, footprint.fogOnly);
+			changed = true;
+		}
+		footprint.pass = fogPass;
 
 		Spawn* sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
 		if (sp) {
@@ -3573,6 +3817,29 @@ void Map::UpdateFog()
 		}
 	}
 
+	for (auto it = fogFootprints.begin(); it != fogFootprints.end();) {
+		if (it->second.pass == fogPass) {
+			++it;
+			continue;
+		}
+		it = fogFootprints.erase(it);
+		changed = true;
+	}
+
+	// a party standing still sees the same as before
+	if (changed || fogDirty) {
+		// don't reset in cutscenes just in case the PST ExploreMapChunk action was ran
+		bool cutscene = core->InCutSceneMode();
+		if (!cutscene) {
+			VisibleBitmap.fill(0);
+		}
+		for (const auto& footprint : fogFootprints) {
+			ApplyFogTiles(footprint.second.visible, footprint.second.fogOnly);
+		}
+		// whatever stayed uncovered has to be cleared after the cutscene
+		fogDirty = cutscene;
+	}
+
 	for (Spawn* spawn : potentialSpawns) {
 		TriggerSpawn(spawn);
 	}
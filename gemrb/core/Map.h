@@ -23,9 +23,13 @@
 
 #include "exports.h"
 
+#include "ActorGrid.h"
+#include "ActorIndex.h"
 #include "Bitmap.h"
 #include "FogRenderer.h"
+#include "LOSCache.h"
 #include "MapReverb.h"
+#include "PathClusterGraph.h"
 #include "PathFinder.h"
 #include "Polygon.h"
 #include "TableMgr.h"
@@ -417,9 +421,33 @@ private:
 
 	friend class TraversabilityCache;
 	TraversabilityCache traversabilityCache;
+	ActorIndex actorIndex;
+	ActorGrid actorGrid;
+	LOSCache losCache;
+
+	// the fog tiles an exploring actor uncovers, kept until it moves or its sight changes
+	struct FogFootprint {
+		SearchmapPoint pos;
+		int range = 0;
+		unsigned int epoch = 0;
+		unsigned int pass = 0; // the last UpdateFog that used it
+		std::vector<int> visible; // fog bitmap indices, explored too
+		std::vector<int> fogOnly; // only explored, eg. through outdoor doors
+	};
+	std::unordered_map<const Actor*, FogFootprint> fogFootprints;
+	// bumped when the searchmap changes, invalidating all footprints
+	unsigned int searchMapEpoch = 1;
+	unsigned int fogPass = 0;
+	// set when the fog bitmaps were touched outside of the footprints
+	bool fogDirty = true;
+	PathClusterGraph pathClusters;
+	ieDword nextExitPrefetch = 0;
 
 	VideoBufferPtr wallStencil = nullptr;
 	Region stencilViewport;
+	// bumped when walls get enabled or disabled, so the stencils know they are stale
+	unsigned int wallGeneration = 0;
+	unsigned int stencilWallGeneration = 0;
 
 	std::unordered_map<const void*, std::pair<VideoBufferPtr, Region>> objectStencils;
 
@@ -505,9 +533,11 @@ public:
 	{
 		wallGroups = std::move(walls);
 	}
-	void ResetStencilViewport()
+	// forces the stencils to be redrawn, eg. after a door toggled its walls
+	void WallsChanged()
 	{
-		stencilViewport = Region();
+		wallGeneration++;
+		objectStencils.clear();
 	}
 	bool BehindWall(const Point&, const Region&) const;
 	void Shout(const Actor* actor, int shoutID, bool global) const;
@@ -562,6 +592,11 @@ public:
 	bool HasActor(const Actor* actor) const;
 	bool SpawnsAlive() const;
 	void RemoveActor(Actor* actor);
+	const ActorIndex& GetActorIndex() const { return actorIndex; }
+	void UpdateActorIndex(const Actor* actor) { actorIndex.UpdateActor(actor); }
+	void SetActorIndexEnabled(bool enabled) { actorIndex.enabled = enabled; }
+	void UpdateActorGrid(const Actor* actor) { actorGrid.UpdateActor(actor); }
+	void SetActorGridEnabled(bool enabled) { actorGrid.enabled = enabled; }
 	Actor* GetRandomEnemySeen(const Actor* origin) const;
 
 	int GetActorCount(bool any) const;
@@ -640,6 +675,29 @@ public:
 	Path GetLinePath(const Point& start, const Point& dest, int speed, orient_t Orientation, int flags) const;
 	/* Finds the path which leads to near d */
 	Path FindPath(const Point& s, const Point& d, unsigned int size, unsigned int minDistance = 0, int flags = PF_SIGHT, const Actor* caller = nullptr);
+	/* Runs several FindPath searches on worker threads, storing the results in the requests */
+	void FindPaths(std::vector<PathRequest>& requests);
+	/* Queues a search for request.caller, which gets the result with SetPlannedPath from DeliverPaths */
+	void QueuePath(PathRequest&& request);
+	bool IsPathQueued(const Actor* mover) const;
+	/* Starts the queued searches on worker threads, without waiting for them */
+	void DispatchPaths();
+	/* Hands the dispatched searches over to their movers, waiting for any still running */
+	void DeliverPaths();
+	/* Waits for the dispatched searches, call before changing anything they look at */
+	void WaitForPaths() const;
+	/* Builds the hierarchical pathfinding data, call once the area is loaded */
+	void BuildPathClusters() { pathClusters.Update(tileProps); }
+	/* Marks the hierarchical pathfinding data around p as outdated, call after changing the searchmap */
+	void SearchMapChanged(const SearchmapPoint& p)
+	{
+		WaitForPaths();
+		pathClusters.Invalidate(p);
+		losCache.Invalidate();
+		searchMapEpoch++;
+	}
+	void SetLOSCacheEnabled(bool enabled) { losCache.enabled = enabled; }
+	void SetHierarchicalPathing(bool enabled) { pathClusters.enabled = enabled; }
 
 	bool IsVisible(const Point& p) const;
 	bool IsExplored(const Point& p) const;
@@ -647,6 +705,8 @@ public:
 	bool IsVisibleLOS(const SearchmapPoint& s, const SearchmapPoint& d, const Actor* caller) const;
 	bool IsWalkableTo(const Point& s, const Point& d, bool actorsAreBlocking, const Actor* caller) const;
 	bool IsWalkableTo(const SearchmapPoint& s, const SearchmapPoint& d, bool actorsAreBlocking, const Actor* caller) const;
+	PathMapFlags GetBlockedInLine(const NavmapPoint& s, const NavmapPoint& d, bool stopOnImpassable, const Actor* caller = nullptr) const;
+	PathMapFlags GetBlockedInLineTile(const SearchmapPoint& s, const SearchmapPoint& d, bool stopOnImpassable, const Actor* caller = nullptr) const;
 
 	/* returns edge direction of map boundary, only worldmap regions */
 	WMPDirection WhichEdge(const NavmapPoint& s) const;
@@ -705,7 +765,7 @@ private:
 	Actor* GetNextActor(int& q, size_t& index) const;
 	Container* GetNextPile(size_t& index) const;
 
-	void RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls);
+	void RedrawScreenStencil(const Region& vp);
 	void DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const;
 	WallPolygonSet WallsIntersectingRegion(Region, bool includeDisabled = false, const Point* loc = nullptr) const;
 
@@ -730,20 +790,42 @@ private:
 	Priority SetPriority(Actor* actor, bool& hostilesNew, ieDword gameTime) const;
 	//Actor* GetRoot(int priority, int &index);
 	void DeleteActor(size_t idx);
+	// collects the fog tiles seen from pos, without touching the bitmaps
+	void TraceVisibility(const SearchmapPoint& pos, int range, int los, std::vector<int>& visible, std::vector<int>& fogOnly) const;
+	void ApplyFogTiles(const std::vector<int>& visible, const std::vector<int>& fogOnly);
+	// the actors that could be within radius pixels of p, in actor list order
+	const std::vector<Actor*>& GetActorsNear(const Point& p, unsigned int radius, std::vector<Actor*>& buffer) const;
 	//actor uses travel region
 	void UseExit(Actor* pc, InfoPoint* ip);
+	// starts reading the destination of the travel region closest to the party, if it is near
+	void PrefetchExits() const;
 	//separated position adjustment, so their order could be randomised
 	bool AdjustPositionX(SearchmapPoint& goal, const Size& radius, int size = -1) const;
 	bool AdjustPositionY(SearchmapPoint& goal, const Size& radius, int size = -1) const;
 
 	void UpdateSpawns() const;
-	PathMapFlags GetBlockedInLine(const NavmapPoint& s, const NavmapPoint& d, bool stopOnImpassable, const Actor* caller = nullptr) const;
-	PathMapFlags GetBlockedInLineTile(const SearchmapPoint& s, const SearchmapPoint& d, bool stopOnImpassable, const Actor* caller = nullptr) const;
 	void AddProjectile(Projectile* pro);
 
 	// same as GetBlocked, but in TileCoords
 	PathMapFlags GetBlockedTile(const SearchmapPoint&, int size) const;
 	PathMapFlags GetBlockedInRadiusTile(const SearchmapPoint&, uint16_t size, bool stopOnImpassable = true) const;
+
+	// the game thread part of FindPath, returns false if there's nothing to search for
+	bool PreparePathSearch(PathRequest& request);
+	// the rest, which only reads the map, so it can run on any thread
+	void SearchPath(PathRequest& request) const;
+	// the plain Theta* search, only leaving the clusters set in corridor (if given) once they lead nowhere
+	Path ThetaStarSearch(const PathRequest& request, const std::vector<bool>* corridor, unsigned int& expanded) const;
+	// IsWalkableTo for the searches, using only what PreparePathSearch stored in the request
+	bool IsWalkableFor(const PathRequest& request, const NavmapPoint& s, const NavmapPoint& d) const;
+	PathMapFlags GetBlockedInRadiusFor(const PathRequest& request, const SearchmapPoint& p) const;
+	Region SearchMapFootprint(const Movable* actor) const;
+
+	// the searches dispatched together, shared with the workers running them
+	struct PathBatch;
+	std::vector<PathRequest> queuedPaths;
+	std::vector<ieDword> queuedPathMovers; // global IDs, the movers may be gone by the dispatch
+	std::vector<std::shared_ptr<PathBatch>> pathBatches;
 };
 
 }
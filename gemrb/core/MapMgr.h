@@ -27,8 +27,13 @@
 #ifndef MAPMGR_H
 #define MAPMGR_H
 
+#include "SClassID.h"
+
 #include "Plugin.h"
 
+#include <utility>
+#include <vector>
+
 namespace GemRB {
 
 class Map;
@@ -42,6 +47,8 @@ class GEM_EXPORT MapMgr : public ImporterBase {
 public:
 	virtual bool ChangeMap(Map* map, bool day_or_night) = 0;
 	virtual Map* GetMap(const ResRef& ResRef, bool day_or_night) = 0;
+	// lists the resources GetMap will most likely need, for prefetching
+	virtual void ListResources(std::vector<std::pair<ResRef, SClass_ID>>& resources) const = 0;
 
 	virtual int GetStoredFileSize(Map* map) = 0;
 	virtual int PutArea(DataStream* stream, const Map* map) const = 0;
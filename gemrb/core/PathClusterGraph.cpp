@@ -0,0 +1,295 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// Hierarchical pathfinding, see Botea et al., 2004 (Near optimal hierarchical path-finding)
+// Instead of refining the abstract path piece by piece, we only use it to limit
+// the Theta* search in Map::FindPath to the clusters along it, which keeps the
+// any-angle paths and all the special cases (minimum distance, sight) intact.
+
+#include "PathClusterGraph.h"
+
+#include "Map.h"
+
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace GemRB {
+
+// long spans get an entrance at each end, so we can cut the corners
+constexpr int LONG_ENTRANCE = 6;
+
+bool PathClusterGraph::IsWalkable(PathMapFlags flags)
+{
+	// like Map::GetBlockedTile, but without the actors, which move around too much
+	if (bool(flags & PathMapFlags::DOOR)) return false;
+	return bool(flags & (PathMapFlags::PASSABLE | PathMapFlags::TRAVEL));
+}
+
+void PathClusterGraph::Reset(const Size& size)
+{
+	mapSize = size;
+	gridSize = Size((size.w + CLUSTER_SIZE - 1) / CLUSTER_SIZE, (size.h + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+	clusters.clear();
+	clusters.resize(gridSize.Area());
+	for (int y = 0; y < gridSize.h; y++) {
+		for (int x = 0; x < gridSize.w; x++) {
+			Region& bounds = clusters[y * gridSize.w + x].bounds;
+			bounds.x = x * CLUSTER_SIZE;
+			bounds.y = y * CLUSTER_SIZE;
+			bounds.w = std::min(CLUSTER_SIZE, size.w - bounds.x);
+			bounds.h = std::min(CLUSTER_SIZE, size.h - bounds.y);
+		}
+	}
+	dirty = !clusters.empty();
+}
+
+void PathClusterGraph::Invalidate(const SearchmapPoint& p)
+{
+	if (!mapSize.PointInside(p)) return;
+
+	int cx = p.x / CLUSTER_SIZE;
+	int cy = p.y / CLUSTER_SIZE;
+	clusters[cy * gridSize.w + cx].dirty = true;
+	// cells on the border also decide the entrances of the neighbour
+	if (p.x % CLUSTER_SIZE == 0 && cx > 0) {
+		clusters[cy * gridSize.w + cx - 1].dirty = true;
+	}
+	if (p.x % CLUSTER_SIZE == CLUSTER_SIZE - 1 && cx + 1 < gridSize.w) {
+		clusters[cy * gridSize.w + cx + 1].dirty = true;
+	}
+	if (p.y % CLUSTER_SIZE == 0 && cy > 0) {
+		clusters[(cy - 1) * gridSize.w + cx].dirty = true;
+	}
+	if (p.y % CLUSTER_SIZE == CLUSTER_SIZE - 1 && cy + 1 < gridSize.h) {
+		clusters[(cy + 1) * gridSize.w + cx].dirty = true;
+	}
+	dirty = true;
+}
+
+void PathClusterGraph::Update(const TileProps& props)
+{
+	if (!dirty) return;
+
+	for (Cluster& cluster : clusters) {
+		if (!cluster.dirty) continue;
+		BuildCluster(cluster, props);
+		cluster.dirty = false;
+	}
+	dirty = false;
+}
+
+size_t PathClusterGraph::GetNodeCount() const
+{
+	size_t count = 0;
+	for (const Cluster& cluster : clusters) {
+		count += cluster.nodes.size();
+	}
+	return count;
+}
+
+void PathClusterGraph::BuildCluster(Cluster& cluster, const TileProps& props) const
+{
+	const Region& bounds = cluster.bounds;
+	cluster.walkable.assign(bounds.size.Area(), false);
+	for (int y = 0; y < bounds.h; y++) {
+		for (int x = 0; x < bounds.w; x++) {
+			SearchmapPoint p(bounds.x + x, bounds.y + y);
+			cluster.walkable[y * bounds.w + x] = IsWalkable(props.QuerySearchMap(p));
+		}
+	}
+
+	// both sides of a border scan it in the same direction, so they agree on the entrances
+	cluster.nodes.clear();
+	const SearchmapPoint origin(bounds.x, bounds.y);
+	const SearchmapPoint last(bounds.x + bounds.w - 1, bounds.y + bounds.h - 1);
+	AddEntrances(cluster, props, origin, SearchmapPoint(1, 0), SearchmapPoint(0, -1), bounds.w);
+	AddEntrances(cluster, props, SearchmapPoint(last.x, origin.y), SearchmapPoint(0, 1), SearchmapPoint(1, 0), bounds.h);
+	AddEntrances(cluster, props, SearchmapPoint(origin.x, last.y), SearchmapPoint(1, 0), SearchmapPoint(0, 1), bounds.w);
+	AddEntrances(cluster, props, origin, SearchmapPoint(0, 1), SearchmapPoint(-1, 0), bounds.h);
+
+	std::vector<int> distances;
+	for (Node& node : cluster.nodes) {
+		node.edges.clear();
+		LocalDistances(cluster, node.pos, distances);
+		for (size_t i = 0; i < cluster.nodes.size(); i++) {
+			const SearchmapPoint& other = cluster.nodes[i].pos;
+			int distance = distances[(other.y - bounds.y) * bounds.w + other.x - bounds.x];
+			if (distance <= 0) continue;
+			node.edges.push_back({ uint16_t(i), uint16_t(distance) });
+		}
+	}
+}
+
+void PathClusterGraph::AddEntrances(Cluster& cluster, const TileProps& props, const SearchmapPoint& first, const SearchmapPoint& step, const SearchmapPoint& out, int length) const
+{
+	if (!mapSize.PointInside(first + out)) return;
+
+	const Region& bounds = cluster.bounds;
+	auto isOpen = [&](int i) {
+		SearchmapPoint p = first + step * i;
+		return cluster.walkable[(p.y - bounds.y) * bounds.w + p.x - bounds.x] && IsWalkable(props.QuerySearchMap(p + out));
+	};
+	auto addNode = [&](int i) {
+		if (cluster.nodes.size() >= size_t(MAX_CLUSTER_NODES)) return;
+		Node node;
+		node.pos = first + step * i;
+		node.across = node.pos + out;
+		cluster.nodes.push_back(std::move(node));
+	};
+
+	int spanStart = -1;
+	for (int i = 0; i <= length; i++) {
+		bool open = i < length && isOpen(i);
+		if (open && spanStart < 0) {
+			spanStart = i;
+		} else if (!open && spanStart >= 0) {
+			int spanEnd = i - 1;
+			if (spanEnd - spanStart + 1 < LONG_ENTRANCE) {
+				addNode(spanStart + (spanEnd - spanStart) / 2);
+			} else {
+				addNode(spanStart);
+				addNode(spanEnd);
+			}
+			spanStart = -1;
+		}
+	}
+}
+
+void PathClusterGraph::LocalDistances(const Cluster& cluster, const SearchmapPoint& origin, std::vector<int>& distances)
+{
+	const Region& bounds = cluster.bounds;
+	distances.assign(bounds.size.Area(), -1);
+	int originIdx = (origin.y - bounds.y) * bounds.w + origin.x - bounds.x;
+	if (!cluster.walkable[originIdx]) return;
+
+	// plain 4-way flood fill, the same moves the full search makes
+	std::deque<int> open;
+	distances[originIdx] = 0;
+	open.push_back(originIdx);
+	while (!open.empty()) {
+		int idx = open.front();
+		open.pop_front();
+		int x = idx % bounds.w;
+		int y = idx / bounds.w;
+		const int children[] = { x > 0 ? idx - 1 : -1, x + 1 < bounds.w ? idx + 1 : -1, y > 0 ? idx - bounds.w : -1, y + 1 < bounds.h ? idx + bounds.w : -1 };
+		for (int child : children) {
+			if (child < 0 || distances[child] >= 0 || !cluster.walkable[child]) continue;
+			distances[child] = distances[idx] + 1;
+			open.push_back(child);
+		}
+	}
+}
+
+int PathClusterGraph::FindNode(int clusterIdx, const SearchmapPoint& pos) const
+{
+	const std::vector<Node>& nodes = clusters[clusterIdx].nodes;
+	for (size_t i = 0; i < nodes.size(); i++) {
+		if (nodes[i].pos == pos) return int(i);
+	}
+	return -1;
+}
+
+bool PathClusterGraph::FindCorridor(const SearchmapPoint& start, const SearchmapPoint& goal, std::vector<bool>& corridor) const
+{
+	if (!enabled || dirty || clusters.empty()) return false;
+	if (!mapSize.PointInside(start) || !mapSize.PointInside(goal)) return false;
+	// neighbouring clusters are close enough for the plain search
+	if (std::abs(start.x / CLUSTER_SIZE - goal.x / CLUSTER_SIZE) <= 1 && std::abs(start.y / CLUSTER_SIZE - goal.y / CLUSTER_SIZE) <= 1) {
+		return false;
+	}
+
+	const int startIdx = GetClusterIndex(start);
+	const int goalIdx = GetClusterIndex(goal);
+	const Cluster& startCluster = clusters[startIdx];
+	const Cluster& goalCluster = clusters[goalIdx];
+	std::vector<int> startDistances;
+	std::vector<int> goalDistances;
+	LocalDistances(startCluster, start, startDistances);
+	LocalDistances(goalCluster, goal, goalDistances);
+
+	// node ids are cluster * MAX_CLUSTER_NODES + node, with the goal itself added at the end
+	const int goalId = int(clusters.size()) * MAX_CLUSTER_NODES;
+	std::vector<int> costs(goalId + 1, std::numeric_limits<int>::max());
+	std::vector<int> parents(goalId + 1, -1);
+	using Entry = std::pair<int, int>; // estimated total cost, id
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+	auto estimate = [&goal](const SearchmapPoint& p) {
+		return std::abs(p.x - goal.x) + std::abs(p.y - goal.y);
+	};
+	auto push = [&](int id, int parent, int cost, const SearchmapPoint& pos) {
+		if (cost >= costs[id]) return;
+		costs[id] = cost;
+		parents[id] = parent;
+		open.emplace(cost + estimate(pos), id);
+	};
+	auto localDistance = [](const Cluster& cluster, const std::vector<int>& distances, const SearchmapPoint& p) {
+		return distances[(p.y - cluster.bounds.y) * cluster.bounds.w + p.x - cluster.bounds.x];
+	};
+
+	for (size_t i = 0; i < startCluster.nodes.size(); i++) {
+		const SearchmapPoint& pos = startCluster.nodes[i].pos;
+		int distance = localDistance(startCluster, startDistances, pos);
+		if (distance < 0) continue;
+		push(startIdx * MAX_CLUSTER_NODES + int(i), -1, distance, pos);
+	}
+
+	while (!open.empty()) {
+		Entry entry = open.top();
+		open.pop();
+		int id = entry.second;
+		if (id == goalId) break;
+
+		int clusterIdx = id / MAX_CLUSTER_NODES;
+		const Cluster& cluster = clusters[clusterIdx];
+		const Node& node = cluster.nodes[id % MAX_CLUSTER_NODES];
+		// outdated entry, the node was reached cheaper since
+		if (entry.first > costs[id] + estimate(node.pos)) continue;
+
+		if (clusterIdx == goalIdx) {
+			int distance = localDistance(goalCluster, goalDistances, node.pos);
+			if (distance >= 0) {
+				push(goalId, id, costs[id] + distance, goal);
+			}
+		}
+		for (const Edge& edge : node.edges) {
+			push(clusterIdx * MAX_CLUSTER_NODES + edge.node, id, costs[id] + edge.cost, cluster.nodes[edge.node].pos);
+		}
+		int acrossIdx = GetClusterIndex(node.across);
+		int acrossNode = FindNode(acrossIdx, node.across);
+		if (acrossNode >= 0) {
+			push(acrossIdx * MAX_CLUSTER_NODES + acrossNode, id, costs[id] + 1, node.across);
+		}
+	}
+
+	if (parents[goalId] < 0) return false;
+
+	corridor.assign(clusters.size(), false);
+	for (int id = parents[goalId]; id >= 0; id = parents[id]) {
+		corridor[id / MAX_CLUSTER_NODES] = true;
+	}
+	corridor[startIdx] = true;
+	corridor[goalIdx] = true;
+	return true;
+}
+
+}
@@ -0,0 +1,115 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef PATH_CLUSTER_GRAPH_H
+#define PATH_CLUSTER_GRAPH_H
+
+#include "exports.h"
+
+#include "PathFinder.h"
+#include "Region.h"
+
+#include <vector>
+
+namespace GemRB {
+
+class TileProps;
+
+/**
+ * Abstract graph over the static searchmap for hierarchical pathfinding (HPA*).
+ *
+ * The searchmap is split into square clusters. Walkable spans crossing the
+ * border of two clusters are entrances, with a node on each side, and the
+ * nodes of a cluster are linked by their local walking distances.
+ * Long routes are first planned on this small graph, giving the corridor of
+ * clusters that the full search then keeps to.
+ *
+ * Only the area and door bits of the searchmap are considered, so actors
+ * and big creatures can still block a corridor; the search has to go on
+ * past it in that case.
+ */
+class GEM_EXPORT PathClusterGraph {
+public:
+	static constexpr int CLUSTER_SIZE = 16; // in searchmap cells
+
+	// turning this off makes FindCorridor always fail, so the full searchmap is searched
+	bool enabled = true;
+
+	// drops the graph, rebuilding it for a searchmap of mapSize on the next Update
+	void Reset(const Size& mapSize);
+	// marks the clusters affected by a change of the searchmap at p, eg. by a door
+	void Invalidate(const SearchmapPoint& p);
+	// rebuilds the invalidated clusters
+	void Update(const TileProps& props);
+	// whether the next Update has anything to do
+	bool NeedsUpdate() const { return dirty; }
+
+	/**
+	 * Plans a route from start to goal on the abstract graph and marks the
+	 * clusters it passes in corridor (indexed like GetClusterIndex).
+	 * Returns false if the graph is of no help: the points are too close
+	 * or there is no abstract route.
+	 */
+	bool FindCorridor(const SearchmapPoint& start, const SearchmapPoint& goal, std::vector<bool>& corridor) const;
+
+	int GetClusterIndex(const SearchmapPoint& p) const
+	{
+		return p.y / CLUSTER_SIZE * gridSize.w + p.x / CLUSTER_SIZE;
+	}
+	size_t GetNodeCount() const;
+
+private:
+	// a border can have at most 8 entrances: single open cells with gaps between them
+	static constexpr int MAX_CLUSTER_NODES = 4 * CLUSTER_SIZE / 2;
+
+	struct Edge {
+		uint16_t node;
+		uint16_t cost;
+	};
+
+	struct Node {
+		SearchmapPoint pos;
+		SearchmapPoint across; // the matching node cell in the neighbouring cluster
+		std::vector<Edge> edges; // to the other nodes of the cluster
+	};
+
+	struct Cluster {
+		Region bounds;
+		std::vector<bool> walkable; // static passability of the cluster cells
+		std::vector<Node> nodes;
+		bool dirty = true;
+	};
+
+	Size mapSize;
+	Size gridSize; // in clusters
+	std::vector<Cluster> clusters;
+	bool dirty = false;
+
+	static bool IsWalkable(PathMapFlags flags);
+	void BuildCluster(Cluster& cluster, const TileProps& props) const;
+	void AddEntrances(Cluster& cluster, const TileProps& props, const SearchmapPoint& first, const SearchmapPoint& step, const SearchmapPoint& out, int length) const;
+	// walking distances from origin to each cell of the cluster, -1 if unreachable
+	static void LocalDistances(const Cluster& cluster, const SearchmapPoint& origin, std::vector<int>& distances);
+	int FindNode(int clusterIdx, const SearchmapPoint& pos) const;
+};
+
+}
+
+#endif
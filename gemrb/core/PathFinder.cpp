@@ -45,8 +45,15 @@
 #include "Logging/Logging.h"
 #include "Scriptable/Actor.h"
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace GemRB {
 
@@ -220,23 +227,279 @@ PathNode Map::GetLineEnd(const Point& p, int steps, orient_t orient) const
 	return lineEnd;
 }
 
+// the search storage, kept between runs to avoid memory allocations;
+// each run we just clear it, which is keeping the underlying allocated memory at hand
+struct PathScratch {
+	BucketPriorityQueue open;
+	std::vector<bool> isClosed;
+	std::vector<NavmapPoint> parents;
+	std::vector<unsigned short> distFromStart;
+	std::vector<bool> corridor;
+	std::vector<NavmapPoint> deferred; // cells with neighbours outside the corridor
+};
+
+// one per thread, so searches can run in parallel (the queue is too big to be thread_local itself)
+static PathScratch& GetPathScratch()
+{
+	thread_local std::unique_ptr<PathScratch> scratch;
+	if (!scratch) {
+		scratch = std::make_unique<PathScratch>();
+	}
+	return *scratch;
+}
+
+// a small pool of persistent threads (so they keep their scratch) for the map searches
+class PathWorkers {
+public:
+	PathWorkers()
+	{
+		// one core is left for the game thread
+		unsigned int count = std::min(std::thread::hardware_concurrency(), MAX_PATH_WORKERS + 1);
+		for (unsigned int i = 1; i < count; i++) {
+			threads.emplace_back([this] { WorkerLoop(); });
+		}
+	}
+	PathWorkers(const PathWorkers&) = delete;
+	~PathWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> l(mutex);
+			running = false;
+		}
+		wake.notify_all();
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+	PathWorkers& operator=(const PathWorkers&) = delete;
+
+	// runs the task on the next free worker, or right away if there are none
+	void Post(std::function<void()> task)
+	{
+		if (threads.empty()) {
+			task();
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> l(mutex);
+			tasks.push_back(std::move(task));
+		}
+		wake.notify_one();
+	}
+
+private:
+	static constexpr unsigned int MAX_PATH_WORKERS = 7;
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::deque<std::function<void()>> tasks;
+	bool running = true;
+
+	void WorkerLoop()
+	{
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> l(mutex);
+				wake.wait(l, [this] { return !running || !tasks.empty(); });
+				// the posted tasks are still run, so nobody waits for them in vain
+				if (tasks.empty()) return;
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+};
+
+static PathWorkers& GetPathWorkers()
+{
+	static PathWorkers workers;
+	return workers;
+}
+
+struct Map::PathBatch {
+	std::vector<PathRequest> requests;
+	std::vector<ieDword> movers;
+	size_t remaining = 0; // searches still running
+	std::mutex mutex;
+	std::condition_variable done;
+
+	void Finish()
+	{
+		std::lock_guard<std::mutex> l(mutex);
+		if (--remaining == 0) {
+			done.notify_all();
+		}
+	}
+
+	void Wait()
+	{
+		std::unique_lock<std::mutex> l(mutex);
+		done.wait(l, [this] { return remaining == 0; });
+	}
+};
+
 // Find a path from start to goal, ending at the specified distance from the
 // target (the goal must be in sight of the end, if PF_SIGHT is specified)
 Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsigned int minDistance, int flags, const Actor* caller)
 {
 	TRACY(ZoneScoped);
 
-	traversabilityCache.Update();
+	PathRequest request;
+	request.start = s;
+	request.dest = d;
+	request.size = size;
+	request.minDistance = minDistance;
+	request.flags = flags;
+	request.caller = caller;
+	if (!PreparePathSearch(request)) return {};
+	SearchPath(request);
+	return std::move(request.path);
+}
+
+// the searches don't change any state, so the results are the same as with
+// consecutive FindPath calls; the requests are completed when this returns
+void Map::FindPaths(std::vector<PathRequest>& requests)
+{
+	TRACY(ZoneScoped);
+
+	// the adjustments of the destination use the (shared) rng, so they stay on this thread
+	std::vector<PathRequest*> searches;
+	for (auto& request : requests) {
+		request.path.Clear();
+		request.expanded = 0;
+		if (PreparePathSearch(request)) {
+			searches.push_back(&request);
+		}
+	}
+
+	if (searches.size() < 2) {
+		for (PathRequest* request : searches) {
+			SearchPath(*request);
+		}
+		return;
+	}
+
+	auto batch = std::make_shared<PathBatch>();
+	batch->remaining = searches.size();
+	for (PathRequest* request : searches) {
+		GetPathWorkers().Post([this, batch, request]() {
+			SearchPath(*request);
+			batch->Finish();
+		});
+	}
+	batch->Wait();
+}
+
+void Map::QueuePath(PathRequest&& request)
+{
+	assert(request.caller);
+	queuedPathMovers.push_back(request.caller->GetGlobalID());
+	queuedPaths.push_back(std::move(request));
+}
+
+bool Map::IsPathQueued(const Actor* mover) const
+{
+	ieDword id = mover->GetGlobalID();
+	if (std::find(queuedPathMovers.begin(), queuedPathMovers.end(), id) != queuedPathMovers.end()) {
+		return true;
+	}
+	for (const auto& batch : pathBatches) {
+		if (std::find(batch->movers.begin(), batch->movers.end(), id) != batch->movers.end()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// the searches are prepared here, like in FindPaths, so only the searching itself runs
+// in the background; the movers stay on the searchmap, blocking each other's paths
+void Map::DispatchPaths()
+{
+	if (queuedPaths.empty()) return;
+	TRACY(ZoneScoped);
 
+	auto batch = std::make_shared<PathBatch>();
+	std::vector<size_t> searches;
+	for (size_t i = 0; i < queuedPaths.size(); i++) {
+		PathRequest& request = queuedPaths[i];
+		request.caller = GetActorByGlobalID(queuedPathMovers[i]);
+		if (!request.caller) continue;
+
+		request.path.Clear();
+		request.expanded = 0;
+		// the failures are delivered too, so the movers don't wait forever
+		if (PreparePathSearch(request)) {
+			searches.push_back(batch->requests.size());
+		}
+		if (request.caller->BlocksSearchMap()) {
+			request.footprint = SearchMapFootprint(request.caller);
+		}
+		batch->requests.push_back(std::move(request));
+		batch->movers.push_back(queuedPathMovers[i]);
+	}
+	queuedPaths.clear();
+	queuedPathMovers.clear();
+
+	batch->remaining = searches.size();
+	pathBatches.push_back(batch);
+	for (size_t i : searches) {
+		GetPathWorkers().Post([this, batch, i]() {
+			SearchPath(batch->requests[i]);
+			batch->Finish();
+		});
+	}
+}
+
+void Map::DeliverPaths()
+{
+	if (pathBatches.empty()) return;
+	TRACY(ZoneScoped);
+
+	WaitForPaths();
+	// taken out first, since the movers could queue new searches
+	std::vector<std::shared_ptr<PathBatch>> batches = std::move(pathBatches);
+	pathBatches.clear();
+	for (const auto& batch : batches) {
+		for (size_t i = 0; i < batch->requests.size(); i++) {
+			// it may have left the area since
+			Actor* mover = GetActorByGlobalID(batch->movers[i]);
+			if (mover) {
+				mover->SetPlannedPath(std::move(batch->requests[i]));
+			}
+		}
+	}
+}
+
+void Map::WaitForPaths() const
+{
+	for (const auto& batch : pathBatches) {
+		batch->Wait();
+	}
+}
+
+bool Map::PreparePathSearch(PathRequest& request)
+{
+	if (!traversabilityCache.HasUpdatedTraversabilityThisFrame() || pathClusters.NeedsUpdate()) {
+		// the dispatched searches still read both
+		WaitForPaths();
+		traversabilityCache.Update();
+		// the graph is built with the area, this only redoes the clusters changed since, eg. by doors
+		pathClusters.Update(tileProps);
+	}
+
+	const Point& s = request.start;
+	const Point& d = request.dest;
+	const unsigned int size = request.size;
+	const Actor* caller = request.caller;
 	if (InDebugMode(DebugMode::PATHFINDER))
 		Log(DEBUG, "FindPath", "s = {}, d = {}, caller = {}, dist = {}, size = {}",
 		    s, d,
 		    fmt::WideToChar { caller ? caller->GetShortName() : u"nullptr" },
-		    minDistance, size);
-	const bool actorsAreBlocking = flags & PF_ACTORS_ARE_BLOCKING;
-	const auto blockingTraversabilityValue = actorsAreBlocking ? TraversabilityCache::TraversabilityCellValueActor : TraversabilityCache::TraversabilityCellValueActorNonTraversable;
+		    request.minDistance, size);
 
-	// TODO: we could optimize this function further by doing everything in SearchmapPoint and converting at the end
 	SearchmapPoint smptDest0 { d };
 	NavmapPoint nmptDest = d;
 	NavmapPoint nmptSource = s;
@@ -249,30 +512,75 @@ Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsi
 		AdjustPositionDirected(nmptDest, direction, size);
 	}
 
-	if (nmptDest == nmptSource) return {};
+	if (nmptDest == nmptSource) return false;
 
 	SearchmapPoint smptSource { nmptSource };
 	SearchmapPoint smptDest { nmptDest };
 
-	if (minDistance < size && !(GetBlockedInRadiusTile(smptDest, size) & (PathMapFlags::PASSABLE | PathMapFlags::ACTOR))) {
+	if (request.minDistance < size && !(GetBlockedInRadiusTile(smptDest, size) & (PathMapFlags::PASSABLE | PathMapFlags::ACTOR))) {
 		Log(DEBUG, "FindPath", "{} can't fit in destination", fmt::WideToChar { caller ? caller->GetShortName() : u"nullptr" });
-		return {};
+		return false;
 	}
 
 	const Size& mapSize = PropsSize();
-	if (!mapSize.PointInside(smptSource)) return {};
+	if (!mapSize.PointInside(smptSource)) return false;
+
+	request.goal = nmptDest;
+	request.stepFactor = caller && caller->GetSpeed() ? float_t(gamedata->GetStepTime()) / float_t(caller->GetSpeed()) : 1;
+	return true;
+}
+
+void Map::SearchPath(PathRequest& request) const
+{
+	// long routes are planned on the cluster graph first, so the search can skip the dead ends
+	std::vector<bool>& corridor = GetPathScratch().corridor;
+	SearchmapPoint smptSource { request.start };
+	SearchmapPoint smptDest { request.goal };
+	bool hasCorridor = pathClusters.FindCorridor(smptSource, smptDest, corridor);
+
+	request.expanded = 0;
+	request.path = ThetaStarSearch(request, hasCorridor ? &corridor : nullptr, request.expanded);
+
+	if (!InDebugMode(DebugMode::PATHFINDER)) return;
+	if (!request.path) {
+		if (request.caller) {
+			Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar { request.caller->GetShortName() });
+		} else {
+			Log(DEBUG, "FindPath", "Pathing failed");
+		}
+	}
+	Log(DEBUG, "FindPath", "{} cells expanded{}", request.expanded, hasCorridor ? " in the corridor" : "");
+}
+
+Path Map::ThetaStarSearch(const PathRequest& request, const std::vector<bool>* corridor, unsigned int& expanded) const
+{
+	const unsigned int size = request.size;
+	const unsigned int minDistance = request.minDistance;
+	const int flags = request.flags;
+	const Actor* caller = request.caller;
+	const bool actorsAreBlocking = flags & PF_ACTORS_ARE_BLOCKING;
+	const auto blockingTraversabilityValue = actorsAreBlocking ? TraversabilityCache::TraversabilityCellValueActor : TraversabilityCache::TraversabilityCellValueActorNonTraversable;
+
+	// TODO: we could optimize this function further by doing everything in SearchmapPoint and converting at the end
+	SearchmapPoint smptDest0 { request.dest };
+	NavmapPoint nmptDest = request.goal;
+	NavmapPoint nmptSource = request.start;
+	SearchmapPoint smptSource { nmptSource };
+	SearchmapPoint smptDest { nmptDest };
+	const Size& mapSize = PropsSize();
 
 	const auto getChildBlockedStatusFn = size > 2 ? &Map::GetChildBlockedStatusForBigSize : &Map::GetChildBlockedStatusForSmallSize;
 
 	// Initialize data structures
 	const size_t mapCellsCount = mapSize.Area();
 
-	// make most data storage for this algorithm static, to avoid memory allocations;
-	// each run we just clear the storage, which is keeping the underlying allocated memory at hand
-	static BucketPriorityQueue open;
-	static std::vector<bool> isClosed;
-	static std::vector<NavmapPoint> parents;
-	static std::vector<unsigned short> distFromStart;
+	PathScratch& scratch = GetPathScratch();
+	BucketPriorityQueue& open = scratch.open;
+	std::vector<bool>& isClosed = scratch.isClosed;
+	std::vector<NavmapPoint>& parents = scratch.parents;
+	std::vector<unsigned short>& distFromStart = scratch.distFromStart;
+	std::vector<NavmapPoint>& deferred = scratch.deferred;
+	deferred.clear();
 
 	// resize if needed (in case of a map change; probably can be done once, when new map is loaded)
 	if (isClosed.size() != mapCellsCount) {
@@ -286,8 +594,8 @@ Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsi
 	isClosed.resize(mapCellsCount, false);
 	// `.clear() + .resize()` is generally more performant than `memset` in cases where we have relatively small
 	// number of elements, while memset performs better for large vectors
-	memset(static_cast<void*>(parents.data()), 0, sizeof(decltype(parents)::value_type) * mapCellsCount);
-	memset(static_cast<void*>(distFromStart.data()), std::numeric_limits<unsigned short>::max(), sizeof(decltype(distFromStart)::value_type) * mapCellsCount);
+	memset(static_cast<void*>(parents.data()), 0, sizeof(NavmapPoint) * mapCellsCount);
+	memset(static_cast<void*>(distFromStart.data()), std::numeric_limits<unsigned short>::max(), sizeof(unsigned short) * mapCellsCount);
 
 	// begin algo init
 	distFromStart[smptSource.y * mapSize.w + smptSource.x] = 0;
@@ -314,7 +622,21 @@ Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsi
 		return estDist;
 	};
 
-	while (!open.IsEmpty()) {
+	while (true) {
+		if (open.IsEmpty()) {
+			// the graph ignores actors and creature sizes, so the corridor may be too tight;
+			// then we go on from where it was left, instead of searching everything again
+			if (!corridor || deferred.empty()) break;
+			corridor = nullptr;
+			for (const NavmapPoint& nmptDeferred : deferred) {
+				SearchmapPoint smptDeferred { nmptDeferred };
+				int smptDeferredIdx = smptDeferred.y * mapSize.w + smptDeferred.x;
+				isClosed[smptDeferredIdx] = false;
+				open.Push(nmptDeferred, getHeuristic(smptDeferred, smptDeferredIdx));
+			}
+			deferred.clear();
+			continue;
+		}
 		const NavmapPoint nmptCurrent = open.Pop();
 
 		const SearchmapPoint smptCurrent { nmptCurrent };
@@ -340,12 +662,20 @@ Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsi
 		}
 
 		isClosed[smptCurrentIdx] = true;
+		expanded++;
 
+		bool isDeferred = false;
 		for (size_t i = 0; i < DEGREES_OF_FREEDOM; i++) {
 			const NavmapPoint nmptChild(nmptCurrent.x + 16 * dxAdjacent[i], nmptCurrent.y + 12 * dyAdjacent[i]);
 			const SearchmapPoint smptChild { nmptChild };
 			// Outside map
 			if (smptChild.x < 0 || smptChild.y < 0 || smptChild.x >= mapSize.w || smptChild.y >= mapSize.h) continue;
+			// Outside the planned corridor, only looked at if the corridor leads nowhere
+			if (corridor && !(*corridor)[pathClusters.GetClusterIndex(smptChild)]) {
+				if (!isDeferred) deferred.push_back(nmptCurrent);
+				isDeferred = true;
+				continue;
+			}
 			// Already visited
 			int smptChildIdx = smptChild.y * mapSize.w + smptChild.x;
 			if (isClosed[smptChildIdx]) continue;
@@ -375,7 +705,7 @@ Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsi
 				// Theta-star path if there is LOS
 				// so far the searchmap grid appears too coarse to play on, see #2261
 				//if (!IsWalkableTo(smptParent, smptChild, actorsAreBlocking, caller)) {
-				if (!IsWalkableTo(nmptParent, nmptChild, actorsAreBlocking, caller)) {
+				if (!IsWalkableFor(request, nmptParent, nmptChild)) {
 					// Fall back to A-star path
 					distFromStart[smptChildIdx] = std::numeric_limits<unsigned short>::max();
 					// Find already visited neighbour with shortest: path from start + path to child
@@ -428,12 +758,6 @@ Path Map::FindPath(const Point& s, const Point& d, const unsigned int size, unsi
 			smptCurrent = SearchmapPoint(nmptCurrent);
 		}
 		return resultPath;
-	} else if (InDebugMode(DebugMode::PATHFINDER)) {
-		if (caller) {
-			Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar { caller->GetShortName() });
-		} else {
-			Log(DEBUG, "FindPath", "Pathing failed");
-		}
 	}
 
 	return {};
@@ -136,6 +136,27 @@ enum {
 	PF_BACKAWAY = 2,
 	PF_ACTORS_ARE_BLOCKING = 4
 };
+
+class Actor;
+
+// the parameters of Map::FindPath, for batched searches
+struct PathRequest {
+	Point start;
+	Point dest;
+	unsigned int size = 0;
+	unsigned int minDistance = 0;
+	int flags = PF_SIGHT;
+	const Actor* caller = nullptr;
+
+	Path path; // the result
+	unsigned int expanded = 0; // searchmap cells the search went through
+
+	// set up by Map::PreparePathSearch, so the search doesn't have to look at the
+	// caller, which may act while the search runs
+	Point goal; // dest moved out of any obstacles
+	float_t stepFactor = 1; // of the walkability checks, scaled by the caller's speed
+	Region footprint; // the caller's searchmap cells, which don't block its own search
+};
 }
 
 #endif
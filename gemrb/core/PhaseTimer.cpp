@@ -0,0 +1,83 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "PhaseTimer.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+#include "Strings/String.h"
+
+namespace GemRB {
+
+static double Milliseconds(PhaseTimer::Clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+PhaseTimer::PhaseTimer(std::string name)
+	: name(std::move(name))
+{}
+
+void PhaseTimer::Begin(std::string phase)
+{
+	Stop();
+	phases.push_back({ std::move(phase), {} });
+	phaseStart = Clock::now();
+	running = true;
+}
+
+void PhaseTimer::Stop()
+{
+	if (!running) return;
+	phases.back().duration = Clock::now() - phaseStart;
+	total += phases.back().duration;
+	running = false;
+}
+
+std::string PhaseTimer::ToJSON() const
+{
+	// the names are our own, so they need no escaping
+	std::string json = fmt::format("{{\"timer\": \"{}\", \"total_ms\": {:.3f}, \"phases\": [", name, Milliseconds(total));
+	for (const Phase& phase : phases) {
+		if (&phase != &phases.front()) json += ", ";
+		AppendFormat(json, "{{\"name\": \"{}\", \"ms\": {:.3f}}}", phase.name, Milliseconds(phase.duration));
+	}
+	json += "]}\n";
+	return json;
+}
+
+void PhaseTimer::Report(const path_t& path) const
+{
+	for (const Phase& phase : phases) {
+		Log(MESSAGE, "PhaseTimer", "{} {}: {:.1f} ms", name, phase.name, Milliseconds(phase.duration));
+	}
+	Log(MESSAGE, "PhaseTimer", "{} total: {:.1f} ms", name, Milliseconds(total));
+
+	if (path.empty()) return;
+	FileStream out;
+	if (!out.Create(path)) {
+		Log(ERROR, "PhaseTimer", "Cannot write {}.", path);
+		return;
+	}
+	std::string json = ToJSON();
+	out.Write(json.data(), json.size());
+}
+
+}
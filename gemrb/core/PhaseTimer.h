@@ -0,0 +1,72 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef PHASETIMER_H
+#define PHASETIMER_H
+
+#include "exports.h"
+
+#include "System/VFS.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * Measures the wall time of consecutive phases, eg. of the engine startup.
+ *
+ * A phase lasts until the next one begins or the timer is stopped. Report
+ * logs the results and can also write them as a line of JSON, so they can
+ * be collected and compared between builds.
+ */
+class GEM_EXPORT PhaseTimer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Phase {
+		std::string name;
+		Clock::duration duration;
+	};
+
+	explicit PhaseTimer(std::string name);
+
+	// ends the current phase, if any
+	void Begin(std::string phase);
+	void Stop();
+
+	const std::vector<Phase>& GetPhases() const { return phases; }
+	Clock::duration GetTotal() const { return total; }
+	std::string ToJSON() const;
+	// writes the JSON to path, unless it is empty
+	void Report(const path_t& path) const;
+
+private:
+	std::string name;
+	std::vector<Phase> phases;
+	Clock::time_point phaseStart;
+	Clock::duration total {};
+	bool running = false;
+};
+
+}
+
+#endif
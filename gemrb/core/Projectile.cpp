@@ -144,7 +144,7 @@ Projectile::AnimArray Projectile::CreateOrientedAnimations(const AnimationFactor
 				c = seq;
 				break;
 		}
-		Animation* a = af.GetCycle(c);
+		Animation* a = af.GetCycle(c, mirrorFlags);
 		if (!a) continue;
 
 		//animations are started at a random frame position
@@ -153,7 +153,6 @@ Projectile::AnimArray Projectile::CreateOrientedAnimations(const AnimationFactor
 			a->SetFrame(0);
 		}
 
-		a->MirrorAnimation(mirrorFlags);
 		a->gameAnimation = true;
 
 		anims[cycle] = std::move(*a);
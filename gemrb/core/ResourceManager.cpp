@@ -28,6 +28,10 @@
 
 #include "Logging/Logging.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace GemRB {
 
 path_t TypeExt(SClass_ID type)
@@ -85,6 +89,11 @@ path_t TypeExt(SClass_ID type)
 	return extIt->second;
 }
 
+ResourceManager::~ResourceManager()
+{
+	LogLocationStats();
+}
+
 bool ResourceManager::AddSource(const path_t& path, const std::string& description, PluginID type, int flags)
 {
 	PluginHolder<ResourceSource> source = MakePluginHolder<ResourceSource>(type);
@@ -93,6 +102,8 @@ bool ResourceManager::AddSource(const path_t& path, const std::string& descripti
 		return false;
 	}
 
+	// the prefetch jobs search the path, so it can't change under them
+	StopPrefetching();
 	if (flags & RM_REPLACE_SAME_SOURCE) {
 		for (auto& path2 : searchPath) {
 			if (description == path2->GetDescription()) {
@@ -103,9 +114,128 @@ bool ResourceManager::AddSource(const path_t& path, const std::string& descripti
 	} else {
 		searchPath.push_back(source);
 	}
+	InvalidateLocations();
 	return true;
 }
 
+std::vector<bool> ResourceManager::AddSources(const std::vector<SourceDesc>& sources)
+{
+	// the sources are created here and only opened in parallel. Opening still reads the
+	// plugin manager, eg. the KEYImporter checks for a BIF importer, which is safe,
+	// since nothing is registered with it after the plugins were loaded
+	std::vector<PluginHolder<ResourceSource>> opened;
+	opened.reserve(sources.size());
+	for (const SourceDesc& desc : sources) {
+		opened.push_back(MakePluginHolder<ResourceSource>(desc.type));
+	}
+
+	std::atomic<size_t> nextSource { 0 };
+	auto openSources = [&sources, &opened, &nextSource]() {
+		for (size_t i = nextSource++; i < sources.size(); i = nextSource++) {
+			// a missing plugin is reported like a bad path
+			if (opened[i] && !opened[i]->Open(sources[i].path, sources[i].description)) {
+				opened[i] = nullptr;
+			}
+		}
+	};
+	size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), sources.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(openSources);
+	}
+	openSources();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	StopPrefetching();
+	std::vector<bool> added(sources.size());
+	for (size_t i = 0; i < sources.size(); ++i) {
+		if (!opened[i]) {
+			Log(WARNING, "ResourceManager", "Invalid path given: {} ({})", sources[i].path, sources[i].description);
+			continue;
+		}
+		searchPath.push_back(std::move(opened[i]));
+		added[i] = true;
+	}
+	InvalidateLocations();
+	return added;
+}
+
+void ResourceManager::StopPrefetching()
+{
+	prefetcher.Clear();
+	prefetcher.WaitForJobs();
+}
+
+void ResourceManager::InvalidateLocations()
+{
+	std::lock_guard<std::mutex> lock(locationMutex);
+	if (locations.empty()) return;
+	LogLocationStats();
+	locations.clear();
+	locationStats.entries = 0;
+	++locationStats.invalidations;
+}
+
+void ResourceManager::LogLocationStats() const
+{
+	Log(DEBUG, "ResourceManager", "Resource locations: {} hits ({} negative), {} misses, {} invalidations, {} entries.",
+	    locationStats.hits, locationStats.negativeHits, locationStats.misses, locationStats.invalidations, locationStats.entries);
+}
+
+size_t ResourceManager::LocationHash::operator()(const LocationKey& key) const
+{
+	return CstrHashCI()(key.name) ^ (CstrHashCI()(key.ext) << 1) ^ (size_t(key.type) << 3) ^ size_t(key.lookup);
+}
+
+ResourceManager::LocationKey ResourceManager::MakeLocationKey(StringView resRef, SClass_ID type, Lookup lookup, StringView ext)
+{
+	LocationKey key { ResRef(), {}, type, lookup };
+	if (resRef.length() <= ResRef::Size && ext.length() <= decltype(key.ext)::Size) {
+		key.name = ResRef(resRef.c_str(), resRef.length());
+		key.ext = decltype(key.ext)(ext.c_str(), ext.length());
+	}
+	return key;
+}
+
+ResourceManager::LocationStats ResourceManager::GetLocationStats() const
+{
+	std::lock_guard<std::mutex> lock(locationMutex);
+	return locationStats;
+}
+
+size_t ResourceManager::FindLocation(const LocationKey& key) const
+{
+	if (key.name.IsEmpty()) return UNKNOWN_LOCATION;
+	std::lock_guard<std::mutex> lock(locationMutex);
+	const auto it = locations.find(key);
+	if (it == locations.cend()) {
+		++locationStats.misses;
+		return UNKNOWN_LOCATION;
+	}
+	++locationStats.hits;
+	if (it->second == searchPath.size()) {
+		++locationStats.negativeHits;
+	}
+	return it->second;
+}
+
+void ResourceManager::StoreLocation(const LocationKey& key, size_t index) const
+{
+	if (key.name.IsEmpty()) return;
+	std::lock_guard<std::mutex> lock(locationMutex);
+	if (locations.emplace(key, index).second) {
+		++locationStats.entries;
+	}
+}
+
+// indexed sources in front of the resolved location are known not to have the resource
+bool ResourceManager::Skip(size_t index, size_t location) const
+{
+	return location != UNKNOWN_LOCATION && index < location && searchPath[index]->IsIndexed();
+}
+
 static void PrintPossibleFiles(std::string& buffer, StringView ResRef, const TypeID* type)
 {
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
@@ -126,12 +256,17 @@ bool ResourceManager::Exists(StringView ResRef, SClass_ID type, bool silent) con
 {
 	if (ResRef.empty())
 		return false;
-	// TODO: check various caches
-	for (const auto& path : searchPath) {
-		if (path->HasResource(ResRef, type)) {
+	const LocationKey key = MakeLocationKey(ResRef, type, Lookup::Has);
+	const size_t location = FindLocation(key);
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		if (i == location) return true;
+		if (Skip(i, location)) continue;
+		if (searchPath[i]->HasResource(ResRef, type)) {
+			if (searchPath[i]->IsIndexed()) StoreLocation(key, i);
 			return true;
 		}
 	}
+	StoreLocation(key, searchPath.size());
 	if (!silent) {
 		Log(WARNING, "ResourceManager", "'{}.{}' not found...",
 		    ResRef, TypeExt(type));
@@ -143,14 +278,19 @@ bool ResourceManager::Exists(StringView ResRef, const TypeID* type, bool silent)
 {
 	if (ResRef.empty())
 		return false;
-	// TODO: check various caches
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
 	for (const auto& type2 : types) {
-		for (const auto& path : searchPath) {
-			if (path->HasResource(ResRef, type2)) {
+		const LocationKey key = MakeLocationKey(ResRef, type2.GetKeyType(), Lookup::HasDesc, type2.GetExt());
+		const size_t location = FindLocation(key);
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (i == location) return true;
+			if (Skip(i, location)) continue;
+			if (searchPath[i]->HasResource(ResRef, type2)) {
+				if (searchPath[i]->IsIndexed()) StoreLocation(key, i);
 				return true;
 			}
 		}
+		StoreLocation(key, searchPath.size());
 	}
 	if (!silent) {
 		std::string buffer = fmt::format("Couldn't find '{}'... Tried ", ResRef);
@@ -164,15 +304,28 @@ DataStream* ResourceManager::GetResourceStream(StringView ResRef, SClass_ID type
 {
 	if (ResRef.empty())
 		return nullptr;
-	for (const auto& path : searchPath) {
+	DataStream* prefetched = prefetcher.GetStream(ResRef, type);
+	if (prefetched) {
+		if (!silent) {
+			Log(MESSAGE, "ResourceManager", "Found '{}.{}' in prefetched data.", ResRef, TypeExt(type));
+		}
+		return prefetched;
+	}
+	const LocationKey key = MakeLocationKey(ResRef, type, Lookup::Get);
+	const size_t location = FindLocation(key);
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		if (Skip(i, location)) continue;
+		const auto& path = searchPath[i];
 		DataStream* ds = path->GetResource(ResRef, type);
 		if (ds) {
+			if (path->IsIndexed()) StoreLocation(key, i);
 			if (!silent) {
 				Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.", ResRef, TypeExt(type), path->GetDescription());
 			}
 			return ds;
 		}
 	}
+	StoreLocation(key, searchPath.size());
 	if (!silent) {
 		Log(ERROR, "ResourceManager", "Couldn't find '{}.{}'.", ResRef, TypeExt(type));
 	}
@@ -194,9 +347,24 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 	}
 
 	for (const auto& type2 : types2) {
-		for (const auto& path : searchPath) {
+		DataStream* prefetched = prefetcher.GetStream(ResRef, type2.GetKeyType());
+		if (prefetched) {
+			auto res = type2.Create(prefetched);
+			if (res) {
+				if (!silent) {
+					Log(MESSAGE, "ResourceManager", "Found '{}.{}' in prefetched data.", ResRef, type2.GetExt());
+				}
+				return res;
+			}
+		}
+		const LocationKey key = MakeLocationKey(ResRef, type2.GetKeyType(), Lookup::GetDesc, type2.GetExt());
+		const size_t location = FindLocation(key);
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (Skip(i, location)) continue;
+			const auto& path = searchPath[i];
 			DataStream* str = path->GetResource(ResRef, type2);
 			if (!str) continue;
+			if (path->IsIndexed()) StoreLocation(key, i);
 
 			auto res = type2.Create(str);
 			if (!res) continue;
@@ -206,6 +374,7 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 			}
 			return res;
 		}
+		StoreLocation(key, searchPath.size());
 	}
 	if (!silent) {
 		std::string buffer = fmt::format("Couldn't find '{}'... Tried ", ResRef);
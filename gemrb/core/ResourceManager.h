@@ -26,10 +26,13 @@
 
 #include "Holder.h"
 #include "Resource.h"
+#include "ResourcePrefetcher.h"
 
 #include "System/VFS.h"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
@@ -41,6 +44,19 @@ class TypeID;
 
 class GEM_EXPORT ResourceManager {
 public:
+	struct LocationStats {
+		size_t hits = 0;
+		size_t misses = 0; // lookups that had to search all the sources
+		size_t negativeHits = 0; // hits for resources none of the indexed sources has
+		size_t invalidations = 0;
+		size_t entries = 0;
+	};
+
+	ResourceManager() = default;
+	ResourceManager(const ResourceManager&) = delete;
+	~ResourceManager();
+	ResourceManager& operator=(const ResourceManager&) = delete;
+
 	/**
 	 * Add ResourceSource to search path
 	 * @param[in] path Path to be used for source.
@@ -50,6 +66,19 @@ public:
 	 **/
 	bool AddSource(const path_t& path, const std::string& description, PluginID type, int flags = 0);
 
+	struct SourceDesc {
+		path_t path;
+		std::string description;
+		PluginID type;
+	};
+	/**
+	 * Adds the sources to the end of the search path, in the given order.
+	 * Opening them lists directories and reads key files, which is mostly
+	 * waiting for the disk, so they are opened in parallel.
+	 * @return whether each of the sources could be added
+	 **/
+	std::vector<bool> AddSources(const std::vector<SourceDesc>& sources);
+
 	/** returns true if resource exists */
 	bool Exists(const String& resRef, SClass_ID type, bool silent = false) const;
 	bool Exists(StringView resRef, SClass_ID type, bool silent = false) const;
@@ -63,11 +92,67 @@ public:
 		return std::static_pointer_cast<T>(GetResource(resname, &T::ID, silent, prefferedType));
 	}
 
+	/**
+	 * Forgets where resources were found. This happens on its own when sources
+	 * are added or replaced, call it when the files of an indexed source change.
+	 **/
+	void InvalidateLocations();
+	LocationStats GetLocationStats() const;
+
+protected:
+	// resources read ahead of their use, see GameData::PrefetchArea
+	ResourcePrefetcher prefetcher;
+
 private:
 	/** Returns Resource object associated to given resource */
 	ResourceHolder<Resource> GetResource(StringView resname, const TypeID* type, bool silent = false, ieWord prefferedType = 0) const;
 
+	// the source operation a location was resolved for, they don't always agree
+	enum class Lookup : uint8_t {
+		Has,
+		Get,
+		HasDesc,
+		GetDesc
+	};
+
+	// the names compare case insensitively; an empty name is too long for the key and not cached
+	struct LocationKey {
+		ResRef name;
+		FixedSizeString<7, strnicmp> ext; // only for the ResourceDesc lookups
+		SClass_ID type;
+		Lookup lookup;
+
+		bool operator==(const LocationKey& other) const
+		{
+			return type == other.type && lookup == other.lookup && name == other.name && ext == other.ext;
+		}
+	};
+
+	struct LocationHash {
+		size_t operator()(const LocationKey& key) const;
+	};
+
+	static constexpr size_t UNKNOWN_LOCATION = size_t(-1);
+
 	std::vector<PluginHolder<ResourceSource>> searchPath;
+	/**
+	 * First indexed source in searchPath that has a resource, or searchPath.size()
+	 * if none does. The other sources are still searched in order, since their
+	 * files may come and go.
+	 **/
+	mutable std::unordered_map<LocationKey, size_t, LocationHash> locations;
+	mutable LocationStats locationStats;
+	// the prefetch jobs look up resources too
+	mutable std::mutex locationMutex;
+
+	static LocationKey MakeLocationKey(StringView resRef, SClass_ID type, Lookup lookup, StringView ext = StringView());
+	size_t FindLocation(const LocationKey& key) const;
+	void StoreLocation(const LocationKey& key, size_t index) const;
+	// at the debug level, whenever the locations are dropped
+	void LogLocationStats() const;
+	// drops the prefetched data and waits for the job in progress
+	void StopPrefetching();
+	bool Skip(size_t index, size_t location) const;
 };
 
 }
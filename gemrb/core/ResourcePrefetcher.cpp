@@ -0,0 +1,224 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ResourcePrefetcher.h"
+
+#include "Streams/DataStream.h"
+#include "Streams/MemoryStream.h"
+
+#include <cstdlib>
+
+namespace GemRB {
+
+ResourcePrefetcher::Entry::~Entry()
+{
+	delete source;
+	free(data);
+}
+
+ResourcePrefetcher::~ResourcePrefetcher()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wake.notify_one();
+	if (worker.joinable()) {
+		worker.join();
+	}
+	Clear();
+}
+
+void ResourcePrefetcher::StartWorker()
+{
+	if (!worker.joinable()) {
+		worker = std::thread(&ResourcePrefetcher::Run, this);
+	}
+	wake.notify_one();
+}
+
+void ResourcePrefetcher::Add(const ResRef& resRef, SClass_ID type, DataStream* stream)
+{
+	auto& typeEntries = entries[type];
+	if (!stream || typeEntries.count(resRef)) {
+		delete stream;
+		return;
+	}
+
+	auto entry = std::make_shared<Entry>();
+	entry->source = stream;
+	entry->name = stream->originalfile;
+	entry->generation = generation;
+	typeEntries[resRef] = entry;
+	pending.push_back(std::move(entry));
+}
+
+void ResourcePrefetcher::Queue(const ResRef& resRef, SClass_ID type, DataStream* stream)
+{
+	if (!stream) return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	Add(resRef, type, stream);
+	StartWorker();
+}
+
+void ResourcePrefetcher::QueueJob(Job job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	jobs.push_back(std::move(job));
+	StartWorker();
+}
+
+bool ResourcePrefetcher::IsQueued(const ResRef& resRef, SClass_ID type) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return Find(resRef, type) != nullptr;
+}
+
+ResourcePrefetcher::EntryPtr ResourcePrefetcher::Find(StringView resRef, SClass_ID type) const
+{
+	auto typeEntries = entries.find(type);
+	if (typeEntries == entries.end()) {
+		return nullptr;
+	}
+	auto entry = typeEntries->second.find(ResRef(resRef));
+	if (entry == typeEntries->second.end()) {
+		return nullptr;
+	}
+	return entry->second;
+}
+
+DataStream* ResourcePrefetcher::GetStream(StringView resRef, SClass_ID type) const
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (entries.empty()) return nullptr;
+
+	EntryPtr entry = Find(resRef, type);
+	if (!entry) return nullptr;
+
+	if (entry->state == State::Queued) {
+		ReadEntry(entry, lock);
+	} else {
+		stateChanged.wait(lock, [&entry]() { return entry->state != State::Reading; });
+	}
+	// a Clear while reading already dropped it
+	if (entry->generation != generation) return nullptr;
+
+	entries[type].erase(ResRef(resRef));
+	if (entry->state != State::Ready) {
+		return nullptr;
+	}
+
+	totalBytes -= entry->size;
+	DataStream* stream = new MemoryStream(entry->name, entry->data, entry->size);
+	entry->data = nullptr;
+	return stream;
+}
+
+void ResourcePrefetcher::ReadEntry(const EntryPtr& entry, std::unique_lock<std::mutex>& lock) const
+{
+	entry->state = State::Reading;
+	DataStream* source = entry->source;
+	entry->source = nullptr;
+	size_t length = source->Remains();
+	bool fits = totalBytes + length <= MAX_BYTES;
+	if (fits) {
+		totalBytes += length;
+	}
+	lock.unlock();
+
+	char* data = nullptr;
+	bool ok = false;
+	if (fits) {
+		data = static_cast<char*>(malloc(length));
+		ok = source->Read(data, length) == strret_t(length);
+	}
+	delete source;
+
+	lock.lock();
+	if (ok) {
+		entry->data = data;
+		entry->size = length;
+		entry->state = State::Ready;
+	} else {
+		free(data);
+		// after a Clear, the bytes were already forgotten
+		if (fits && entry->generation == generation) totalBytes -= length;
+		entry->state = State::Failed;
+	}
+	stateChanged.notify_all();
+}
+
+void ResourcePrefetcher::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake.wait(lock, [this]() { return quit || !jobs.empty() || !pending.empty(); });
+		if (quit) return;
+
+		// the jobs come first, reading is quicker than looking up what to read
+		if (!jobs.empty()) {
+			Job job = std::move(jobs.front());
+			jobs.pop_front();
+			uint32_t jobGeneration = generation;
+			runningJob = true;
+			lock.unlock();
+
+			std::vector<Request> requests = job();
+
+			lock.lock();
+			runningJob = false;
+			for (const Request& request : requests) {
+				if (jobGeneration == generation) {
+					Add(request.resRef, request.type, request.stream);
+				} else {
+					delete request.stream;
+				}
+			}
+			stateChanged.notify_all();
+			continue;
+		}
+
+		EntryPtr entry = std::move(pending.front());
+		pending.pop_front();
+		// the game thread may have needed it already
+		if (entry->state != State::Queued) continue;
+		ReadEntry(entry, lock);
+	}
+}
+
+void ResourcePrefetcher::Clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	++generation;
+	jobs.clear();
+	pending.clear();
+	// entries being read are kept alive by their readers
+	entries.clear();
+	totalBytes = 0;
+}
+
+void ResourcePrefetcher::WaitForJobs() const
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	stateChanged.wait(lock, [this]() { return !runningJob && jobs.empty(); });
+}
+
+}
@@ -0,0 +1,131 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef RESOURCEPREFETCHER_H
+#define RESOURCEPREFETCHER_H
+
+#include "SClassID.h"
+#include "exports.h"
+
+#include "Resource.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * Reads resources into memory on a background thread, so that a later load
+ * (eg. of the next area) doesn't have to wait for the disk.
+ *
+ * Jobs run on that thread too and find the resources to read, eg. from the
+ * header of an area. Whatever they touch has to be safe to use from there:
+ * the resource lookups, the area extraction and the importers that only read
+ * their stream. Nothing is parsed into the object caches (items, spells,
+ * animations), since those aren't thread safe.
+ */
+class GEM_EXPORT ResourcePrefetcher {
+public:
+	// upper bound for all the buffered data, resources beyond it are just skipped
+	static constexpr size_t MAX_BYTES = 256 * 1024 * 1024;
+
+	struct Request {
+		ResRef resRef;
+		SClass_ID type;
+		DataStream* stream; // owned
+	};
+	using Job = std::function<std::vector<Request>()>;
+
+	ResourcePrefetcher() noexcept = default;
+	ResourcePrefetcher(const ResourcePrefetcher&) = delete;
+	~ResourcePrefetcher();
+	ResourcePrefetcher& operator=(const ResourcePrefetcher&) = delete;
+
+	// takes ownership of stream, which will be read in the background
+	void Queue(const ResRef& resRef, SClass_ID type, DataStream* stream);
+	// runs job in the background and queues what it returns, unless Clear came first
+	void QueueJob(Job job);
+	bool IsQueued(const ResRef& resRef, SClass_ID type) const;
+	/**
+	 * Hands over a queued resource, so it can only be taken once, or returns
+	 * nullptr if there is none. Resources that weren't read yet are read right
+	 * away instead of waiting for the background thread to reach them.
+	 */
+	DataStream* GetStream(StringView resRef, SClass_ID type) const;
+	// drops everything without waiting, reads and jobs in progress are discarded when done
+	void Clear();
+	// waits for the job in progress, if any
+	void WaitForJobs() const;
+
+private:
+	enum class State : uint8_t {
+		Queued,
+		Reading,
+		Ready,
+		Failed
+	};
+
+	struct Entry {
+		DataStream* source = nullptr;
+		path_t name;
+		char* data = nullptr; // malloc'd, as the streams take it over
+		size_t size = 0;
+		State state = State::Queued;
+		// of the prefetcher when queued, it is gone once they differ
+		uint32_t generation = 0;
+
+		Entry() noexcept = default;
+		Entry(const Entry&) = delete;
+		~Entry();
+		Entry& operator=(const Entry&) = delete;
+	};
+	using EntryPtr = std::shared_ptr<Entry>;
+
+	mutable std::mutex mutex;
+	mutable std::condition_variable stateChanged;
+	std::condition_variable wake;
+	std::thread worker;
+	bool quit = false;
+	bool runningJob = false;
+	uint32_t generation = 0;
+
+	mutable std::map<SClass_ID, ResRefMap<EntryPtr>> entries;
+	std::deque<EntryPtr> pending;
+	std::deque<Job> jobs;
+	mutable size_t totalBytes = 0;
+
+	void Run();
+	void StartWorker();
+	// the caller holds the lock
+	void Add(const ResRef& resRef, SClass_ID type, DataStream* stream);
+	EntryPtr Find(StringView resRef, SClass_ID type) const;
+	// reads the source of an entry claimed by the caller, with the lock released
+	void ReadEntry(const EntryPtr& entry, std::unique_lock<std::mutex>& lock) const;
+};
+
+}
+
+#endif
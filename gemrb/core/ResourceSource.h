@@ -43,6 +43,8 @@ public:
 	virtual DataStream* GetResource(StringView resname, SClass_ID type) = 0;
 	virtual DataStream* GetResource(StringView resname, const ResourceDesc& type) = 0;
 	const std::string& GetDescription() const { return description; }
+	// false if the contents can change while the source is open, eg. a directory the engine writes to
+	virtual bool IsIndexed() const { return true; }
 
 protected:
 	std::string description;
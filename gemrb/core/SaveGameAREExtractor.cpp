@@ -23,8 +23,13 @@
 #include "Streams/FileCache.h"
 #include "Streams/FileStream.h"
 
+#include <mutex>
+
 namespace GemRB {
 
+// the resource prefetcher extracts areas on its worker
+static std::recursive_mutex registryMutex;
+
 SaveGameAREExtractor::SaveGameAREExtractor(Holder<SaveGame> saveGame)
 	: saveGame(std::move(saveGame))
 {}
@@ -35,6 +40,7 @@ int32_t SaveGameAREExtractor::copyRetainedAREs(DataStream* destStream, bool trac
 		return GEM_OK;
 	}
 
+	std::lock_guard<std::recursive_mutex> lock(registryMutex);
 	auto saveGameStream = saveGame->GetSave();
 	if (saveGameStream == nullptr) {
 		return GEM_ERROR;
@@ -86,6 +92,7 @@ int32_t SaveGameAREExtractor::copyRetainedAREs(DataStream* destStream, bool trac
 
 int32_t SaveGameAREExtractor::createCacheBlob()
 {
+	std::lock_guard<std::recursive_mutex> lock(registryMutex);
 	if (areLocations.empty()) {
 		return 0;
 	}
@@ -107,6 +114,7 @@ int32_t SaveGameAREExtractor::createCacheBlob()
 
 int32_t SaveGameAREExtractor::extractARE(const ResRef& key)
 {
+	std::lock_guard<std::recursive_mutex> lock(registryMutex);
 	auto it = areLocations.find(key);
 	if (it != areLocations.cend() && extractByEntry(key, it) != GEM_OK) {
 		return GEM_ERROR;
@@ -154,6 +162,7 @@ bool SaveGameAREExtractor::isRunningSaveGame(const SaveGame& otherGame) const
 
 void SaveGameAREExtractor::registerLocation(const ResRef& resRef, unsigned long pos)
 {
+	std::lock_guard<std::recursive_mutex> lock(registryMutex);
 	areLocations.emplace(resRef, pos);
 }
 
@@ -163,6 +172,7 @@ void SaveGameAREExtractor::updateSaveGame(size_t offset)
 		return;
 	}
 
+	std::lock_guard<std::recursive_mutex> lock(registryMutex);
 	areLocations = std::move(newAreLocations);
 
 	for (auto it = areLocations.begin(); it != areLocations.end(); ++it) {
@@ -397,8 +397,8 @@ void SaveGameIterator::PruneQuickSave(StringView folder) const
 	}
 }
 
-/** Save game to given directory */
-static bool DoSaveGame(const path_t& Path, bool overrideRunning)
+/** Save game to given directory, fast trades the size of the archive for speed */
+static bool DoSaveGame(const path_t& Path, bool overrideRunning, bool fast)
 {
 	const Game* game = core->GetGame();
 	//saving areas to cache currently in memory
@@ -414,7 +414,7 @@ static bool DoSaveGame(const path_t& Path, bool overrideRunning)
 
 	//compress files in cache named: .STO and .ARE
 	//no .CRE would be saved in cache
-	if (core->CompressSave(Path, overrideRunning)) {
+	if (core->CompressSave(Path, overrideRunning, fast)) {
 		return false;
 	}
 
@@ -625,7 +625,8 @@ int SaveGameIterator::CreateSaveGame(int index, bool mqs) const
 		return GEM_ERROR;
 	}
 
-	if (!DoSaveGame(Path.c_str(), overrideRunning)) {
+	// these are quick and auto saves, which happen while playing
+	if (!DoSaveGame(Path.c_str(), overrideRunning, core->config.FastQuickSaves)) {
 		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
 		return GEM_ERROR;
 	}
@@ -704,7 +705,7 @@ int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname,
 		return GEM_ERROR;
 	}
 
-	if (!DoSaveGame(Path.c_str(), overrideRunning)) {
+	if (!DoSaveGame(Path.c_str(), overrideRunning, false)) {
 		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
 		return GEM_ERROR;
 	}
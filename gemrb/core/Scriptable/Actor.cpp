@@ -2515,6 +2515,9 @@ bool Actor::SetStat(unsigned int StatIndex, stat_t Value, int pcf)
 	unsigned int previous = GetSafeStat(StatIndex);
 	if (Modified[StatIndex] != Value) {
 		Modified[StatIndex] = Value;
+		if (area && ActorIndex::IsIndexedStat(StatIndex)) {
+			area->UpdateActorIndex(this);
+		}
 	}
 	if (previous != Value) {
 		if (pcf) {
@@ -2863,6 +2866,11 @@ void Actor::RefreshEffects(bool first, const stats_t& previous)
 	if (Immobile()) {
 		timeStartStep = game->Ticks;
 	}
+
+	// ResetStats bypasses SetStat, so resync the object matching index
+	if (area) {
+		area->UpdateActorIndex(this);
+	}
 }
 
 void Actor::RefreshEffects()
@@ -5402,6 +5410,7 @@ void Actor::Resurrect(const Point& destPoint)
 			lookup->second = 0;
 		}
 	}
+	game->VariablesChanged();
 
 	ResetCommentTime();
 	// clear effects? If we get resurrected in a new area, equipping effects would get
@@ -5628,6 +5637,7 @@ void Actor::Die(Scriptable* killer, bool grantXP)
 
 	if (InParty && killerPC) {
 		UpdateOrCreateVariable(game->locals, "PM_KILLED", 1);
+		game->VariablesChanged();
 	}
 
 	// EXTRACOUNT is updated at the moment of death
@@ -5647,6 +5657,7 @@ void Actor::Die(Scriptable* killer, bool grantXP)
 			// i am guessing that we shouldn't decrease below 0
 			if (value > 0) {
 				area->locals[varname] = value - 1;
+				game->VariablesChanged();
 			}
 		}
 	}
@@ -5798,6 +5809,7 @@ bool Actor::CheckOnDeath()
 		}
 		j += j;
 	}
+	game->VariablesChanged();
 
 	if (disintegrated) return true;
 
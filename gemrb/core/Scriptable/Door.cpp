@@ -50,8 +50,8 @@ void DoorTrigger::SetState(bool open, Map* map)
 	}
 
 	// also force update the Map stencils
-	// without the viewport reset we would not notice there was a change
-	map->ResetStencilViewport();
+	// without this we would not notice there was a change
+	map->WallsChanged();
 }
 
 std::shared_ptr<Gem_Polygon> DoorTrigger::StatePolygon() const
@@ -71,9 +71,11 @@ Door::Door(Holder<TileOverlay> Overlay, DoorTrigger&& trigger)
 
 void Door::ImpedeBlocks(const std::vector<SearchmapPoint>& points, PathMapFlags value) const
 {
+	area->WaitForPaths();
 	for (const SearchmapPoint& point : points) {
 		PathMapFlags tmp = area->tileProps.QuerySearchMap(point) & PathMapFlags::NOTDOOR;
 		area->tileProps.PaintSearchMap(point, tmp | value);
+		area->SearchMapChanged(point);
 	}
 }
 
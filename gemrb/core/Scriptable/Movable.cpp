@@ -361,7 +361,15 @@ void Movable::WalkTo(const Point& Des, int distance)
 	}
 
 	if (BlocksSearchMap()) area->ClearSearchMapFor(this);
-	Path newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT | PF_ACTORS_ARE_BLOCKING, actor);
+	Path newPath;
+	// a failed search is used too, there's no point in repeating it
+	if (HasPlannedPath(Des, distance)) {
+		newPath = std::move(plannedPath.path);
+	} else {
+		newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT | PF_ACTORS_ARE_BLOCKING, actor);
+	}
+	plannedPath.path.Clear();
+	plannedArea = nullptr;
 	if (!newPath && actor && actor->ValidTarget(GA_CAN_BUMP)) {
 		Log(DEBUG, "WalkTo", "{} re-pathing ignoring actors", fmt::WideToChar { actor->GetShortName() });
 		newPath = area->FindPath(Pos, Des, circleSize, distance, PF_SIGHT, actor);
@@ -379,6 +387,41 @@ void Movable::WalkTo(const Point& Des, int distance)
 	}
 }
 
+void Movable::SetPlannedPath(PathRequest&& request)
+{
+	plannedPath = std::move(request);
+	plannedArea = area;
+}
+
+// whether the planned path is what WalkTo would search for now
+bool Movable::HasPlannedPath(const Point& Des, int distance) const
+{
+	return plannedArea && plannedArea == area && plannedPath.start == Pos && plannedPath.dest == Des &&
+	       plannedPath.minDistance == unsigned(distance) && plannedPath.size == unsigned(circleSize) &&
+	       plannedPath.flags == (PF_SIGHT | PF_ACTORS_ARE_BLOCKING);
+}
+
+// for the moves that can wait a tick, like the many random walkers heading home at once;
+// returns false while the search is pending, call it again then to take the delivered path
+bool Movable::QueueWalkTo(const Point& Des)
+{
+	const Actor* actor = As<Actor>(this);
+	if (!actor || HasPlannedPath(Des, 0) || (Pos.x / 16 == Des.x / 16 && Pos.y / 12 == Des.y / 12)) {
+		WalkTo(Des);
+		return true;
+	}
+	if (area->IsPathQueued(actor)) return false;
+
+	PathRequest request;
+	request.start = Pos;
+	request.dest = Des;
+	request.size = circleSize;
+	request.flags = PF_SIGHT | PF_ACTORS_ARE_BLOCKING;
+	request.caller = actor;
+	area->QueuePath(std::move(request));
+	return false;
+}
+
 void Movable::RunAwayFrom(const Point& Source, int PathLength, bool noBackAway)
 {
 	ClearPath(true);
@@ -392,6 +435,11 @@ void Movable::RandomWalk(bool can_stop, bool run)
 	if (path) {
 		return;
 	}
+	// still waiting for the way home
+	const Actor* actor = As<Actor>();
+	if (actor && area->IsPathQueued(actor)) {
+		return;
+	}
 	// if not continuous random walk, then stops for a while
 	if (can_stop) {
 		Region vp = core->GetGameControl()->Viewport();
@@ -430,8 +478,7 @@ void Movable::RandomWalk(bool can_stop, bool run)
 
 	randomWalkCounter++;
 	if (randomWalkCounter > MAX_RAND_WALK) {
-		randomWalkCounter = 0;
-		WalkTo(HomeLocation);
+		if (QueueWalkTo(HomeLocation)) randomWalkCounter = 0;
 		return;
 	}
 
@@ -453,8 +500,7 @@ void Movable::RandomWalk(bool can_stop, bool run)
 		Destination = randomStep.point;
 		path.PrependStep(randomStep); // start or end doesn't matter, since the path is currently empty
 	} else {
-		randomWalkCounter = 0;
-		WalkTo(HomeLocation);
+		if (QueueWalkTo(HomeLocation)) randomWalkCounter = 0;
 		return;
 	}
 }
@@ -474,6 +520,8 @@ void Movable::Stop(int flags)
 {
 	Scriptable::Stop(flags);
 	ClearPath(true);
+	plannedPath.path.Clear();
+	plannedArea = nullptr;
 }
 
 void Movable::ClearPath(bool resetDestination)
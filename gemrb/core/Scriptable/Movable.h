@@ -34,6 +34,8 @@ private: // these seem to be sensitive, so get protection
 	std::array<ieWord, 3> AttackMovements = { 100, 0, 0 };
 
 	Path path; // whole path
+	PathRequest plannedPath; // searched ahead of time, for the next WalkTo
+	const Map* plannedArea = nullptr; // where plannedPath was searched, if any
 	unsigned int prevTicks = 0;
 	int bumpBackTries = 0;
 	bool pathAbandoned = false;
@@ -111,10 +113,15 @@ public:
 	int GetRandomWalkCounter() const { return randomWalkCounter; };
 	void MoveLine(int steps, orient_t Orient);
 	void WalkTo(const Point& Des, int MinDistance = 0);
+	// hands over the result of a batched search, which WalkTo uses if nothing changed in between
+	void SetPlannedPath(PathRequest&& request);
+	bool HasPlannedPath(const Point& Des, int distance) const;
 	void MoveTo(const Point& Des);
 	void Stop(int flags = 0) override;
 	void ClearPath(bool resetDestination = true);
 	void HandleAnkhegStance(bool emerge);
+	// WalkTo, with the search queued on the area instead of done right away
+	bool QueueWalkTo(const Point& Des);
 
 	/* returns the most likely position of this actor */
 	Point GetMostLikelyPosition() const;
@@ -132,6 +132,16 @@ void Scriptable::SetMap(Map* map)
 	area = map;
 }
 
+void Scriptable::SetPos(const NavmapPoint& pos)
+{
+	Pos = pos;
+	SMPos = SearchmapPoint(pos);
+	// keep the area's spatial lookups in sync
+	if (area && Type == ST_ACTOR) {
+		area->UpdateActorGrid(static_cast<const Actor*>(this));
+	}
+}
+
 //ai is nonzero if this is an actor currently in the party
 //if the script level is AI_SCRIPT_LEVEL, then we need to
 //load an AI script (.bs) instead of (.bcs)
@@ -26,6 +26,7 @@
 
 #include "OverHeadText.h"
 #include "PathFinder.h"
+#include "VariableSlots.h"
 
 #include <list>
 #include <map>
@@ -304,6 +305,7 @@ public:
 
 	// more scripting state
 	ieVarsMap locals;
+	mutable VariableSlots localSlots; // for the scripted lookups of locals
 	OverHeadText overHead { this };
 	StoredObjects objects {};
 	ieDword UnselectableTimer = 0;
@@ -385,6 +387,7 @@ public:
 	void AddTrigger(TriggerEntry trigger);
 	void SetLastTrigger(ieDword triggerID, ieDword scriptableID);
 	bool MatchTrigger(unsigned short id, ieDword param = 0) const;
+	bool HasTriggers() const { return !triggers.empty(); }
 	bool MatchTriggerWithObject(short unsigned int id, const Object* obj, ieDword param = 0) const;
 	const TriggerEntry* GetMatchingTrigger(unsigned short id, unsigned int notflags = 0) const;
 	void SendTriggerToAll(TriggerEntry entry, int extraFlags = 0);
@@ -410,11 +413,7 @@ public:
 	unsigned int GetVisualRange() const;
 	ieDword GetLocal(const ieVariable& key, ieDword fallback) const;
 	virtual std::string dump() const = 0;
-	void SetPos(const NavmapPoint& pos)
-	{
-		Pos = pos;
-		SMPos = SearchmapPoint(pos);
-	};
+	void SetPos(const NavmapPoint& pos);
 
 private:
 	/* used internally to handle start of spellcasting */
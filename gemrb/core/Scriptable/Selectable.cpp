@@ -19,7 +19,10 @@
 
 #include "Selectable.h"
 
+#include "Map.h"
+
 #include "GUI/GUIAnimation.h"
+#include "Scriptable/Actor.h"
 #include "Video/Video.h"
 
 namespace GemRB {
@@ -116,6 +119,10 @@ void Selectable::SetCircle(int circlesize, float_t factor, const Color& color, H
 {
 	circleSize = circlesize;
 	sizeFactor = factor;
+	// the grid pads its queries by the circle sizes
+	if (area && Type == ST_ACTOR) {
+		area->UpdateActorGrid(static_cast<const Actor*>(this));
+	}
 	selectedColor = color;
 	overColor.r = color.r >> 1;
 	overColor.g = color.g >> 1;
@@ -79,9 +79,8 @@ Animation* ScriptedAnimation::PrepareAnimation(const AnimationFactory& af, Anima
 		c = SixteenToNine[i % MAX_ORIENT] + 9 * i / MAX_ORIENT;
 	}
 
-	Animation* anim = af.GetCycle(c);
+	Animation* anim = af.GetCycle(c, BlitFlags(Transparency) & (BlitFlags::MIRRORX | BlitFlags::MIRRORY));
 	if (anim) {
-		anim->MirrorAnimation(BlitFlags(Transparency) & (BlitFlags::MIRRORX | BlitFlags::MIRRORY));
 		//creature anims may start at random position, vvcs always start on 0
 		anim->frameIdx = 0;
 		//vvcs are always paused
@@ -165,10 +164,9 @@ void ScriptedAnimation::LoadAnimationFactory(const AnimationFactory& af, int get
 			p *= MAX_ORIENT;
 		}
 
-		anims[p] = af.GetCycle(c);
+		anims[p] = af.GetCycle(c, mirrorFlags);
 		if (anims[p]) {
 			anims[p]->frameIdx = 0;
-			anims[p]->MirrorAnimation(mirrorFlags);
 			anims[p]->gameAnimation = true;
 		}
 	}
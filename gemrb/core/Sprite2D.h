@@ -113,6 +113,8 @@ public:
 	bool IsPixelTransparent(const Point& p) const noexcept;
 
 	uint16_t GetPitch() const noexcept { return pitch; }
+	// uncompressed pixel data size, RLE sprites are usually smaller
+	size_t GetMemorySize() const noexcept { return size_t(Frame.w) * Frame.h * format.Bpp; }
 
 	virtual const void* LockSprite() const;
 	virtual void* LockSprite();
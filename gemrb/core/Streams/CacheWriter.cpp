@@ -0,0 +1,130 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "Streams/CacheWriter.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+#include "Strings/String.h"
+
+#include <algorithm>
+#include <array>
+
+namespace GemRB {
+
+CacheWriter::~CacheWriter()
+{
+	WaitAll();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wake.notify_one();
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+path_t CacheWriter::MakeKey(const path_t& path)
+{
+	path_t key = path;
+	StringToLower(key);
+	return key;
+}
+
+void CacheWriter::Write(const path_t& path, DataStream* contents)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	jobs.push_back({ path, MakeKey(path), std::unique_ptr<DataStream>(contents) });
+	if (!worker.joinable()) {
+		worker = std::thread(&CacheWriter::Run, this);
+	}
+	wake.notify_one();
+}
+
+bool CacheWriter::IsPending(const path_t& key) const
+{
+	return std::any_of(jobs.begin(), jobs.end(), [&key](const Job& job) { return job.key == key; });
+}
+
+bool CacheWriter::TakeFailures(const path_t* key)
+{
+	bool ok = true;
+	auto it = failed.begin();
+	while (it != failed.end()) {
+		if (key && *it != *key) {
+			++it;
+			continue;
+		}
+		// logging from the writer thread could reach the GUI console, so it happens here
+		Log(ERROR, "CacheWriter", "Failed to write {}!", *it);
+		it = failed.erase(it);
+		ok = false;
+	}
+	return ok;
+}
+
+bool CacheWriter::Wait(const path_t& path)
+{
+	path_t key = MakeKey(path);
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this, &key]() { return !IsPending(key); });
+	return TakeFailures(&key);
+}
+
+bool CacheWriter::WaitAll()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this]() { return jobs.empty(); });
+	return TakeFailures(nullptr);
+}
+
+void CacheWriter::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake.wait(lock, [this]() { return quit || !jobs.empty(); });
+		if (jobs.empty()) return;
+
+		// the job stays queued while it is written, so it still counts as pending
+		Job& job = jobs.front();
+		lock.unlock();
+
+		bool ok = false;
+		FileStream file;
+		if (file.Create(job.path)) {
+			std::array<char, 65536> buffer;
+			strpos_t remaining = job.contents->Remains();
+			ok = true;
+			while (ok && remaining > 0) {
+				strpos_t chunk = std::min<strpos_t>(remaining, buffer.size());
+				ok = job.contents->Read(buffer.data(), chunk) == strret_t(chunk) && file.Write(buffer.data(), chunk) == strret_t(chunk);
+				remaining -= chunk;
+			}
+		}
+
+		lock.lock();
+		if (!ok) {
+			failed.push_back(job.key);
+		}
+		jobs.pop_front();
+		done.notify_all();
+	}
+}
+
+}
@@ -0,0 +1,79 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef CACHEWRITER_H
+#define CACHEWRITER_H
+
+#include "exports.h"
+
+#include "Streams/DataStream.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * Writes already serialized files (eg. swapped out areas) to disk on a
+ * background thread, so the game doesn't stall on the disk.
+ *
+ * Anything reading or removing such a file has to Wait for it first.
+ */
+class GEM_EXPORT CacheWriter {
+public:
+	CacheWriter() noexcept = default;
+	CacheWriter(const CacheWriter&) = delete;
+	~CacheWriter();
+	CacheWriter& operator=(const CacheWriter&) = delete;
+
+	// takes ownership of contents, which are written to path from their current position
+	void Write(const path_t& path, DataStream* contents);
+	// blocks until the pending writes of path are done, false if any failed
+	bool Wait(const path_t& path);
+	bool WaitAll();
+
+private:
+	struct Job {
+		path_t path;
+		path_t key; // lowercased, since the cache is searched case insensitively
+		std::unique_ptr<DataStream> contents;
+	};
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	// the front job is the one being written
+	std::deque<Job> jobs;
+	std::vector<path_t> failed;
+	std::thread worker;
+	bool quit = false;
+
+	void Run();
+	static path_t MakeKey(const path_t& path);
+	bool IsPending(const path_t& key) const;
+	// removes and logs the failures of key, or all of them without one
+	bool TakeFailures(const path_t* key);
+};
+
+}
+
+#endif
@@ -19,9 +19,12 @@
 #include "FileCache.h"
 
 #include "Compressor.h"
+#include "DirectoryIndex.h"
 #include "Interface.h"
+#include "MurmurHash.h"
 #include "PluginMgr.h"
 
+#include "GameScript/CompiledScript.h"
 #include "Logging/Logging.h"
 #include "Streams/FileStream.h"
 #if defined(SUPPORTS_MEMSTREAM)
@@ -29,8 +32,117 @@
 #endif
 #include "System/VFS.h"
 
+#include <ctime>
+#include <map>
+#include <mutex>
+
 namespace GemRB {
 
+static const path_t manifestName = "archives.lst";
+// enough to cover the headers and entry tables, which differ between versions
+constexpr strpos_t HASHED_BYTES = 65536;
+// the numbers and a file name of any length that makes sense
+constexpr strpos_t MANIFEST_LINE_MAX = 4096;
+
+struct CachedArchive {
+	strpos_t sourceSize = 0;
+	long long sourceTime = 0;
+	uint32_t sourceHash = 0;
+	strpos_t cachedSize = 0;
+};
+
+static std::mutex manifestMutex;
+static std::map<path_t, CachedArchive> manifest;
+static bool manifestLoaded = false;
+
+static path_t ManifestPath()
+{
+	return PathJoin(core->config.CachePath, manifestName);
+}
+
+static void LoadManifest()
+{
+	if (manifestLoaded) return;
+	manifestLoaded = true;
+
+	FileStream* file = FileStream::OpenFile(ManifestPath());
+	if (!file) return;
+
+	// the name comes last and runs to the end of the line, so it may contain spaces
+	std::string line;
+	while (file->ReadLine(line, MANIFEST_LINE_MAX) != DataStream::Error) {
+		unsigned long long sourceSize;
+		long long sourceTime;
+		unsigned int sourceHash;
+		unsigned long long cachedSize;
+		int nameStart = 0;
+		if (sscanf(line.c_str(), "%llu %lld %u %llu %n", &sourceSize, &sourceTime, &sourceHash, &cachedSize, &nameStart) != 4) {
+			continue;
+		}
+		if (nameStart == 0 || size_t(nameStart) >= line.length()) continue;
+		manifest[line.substr(nameStart)] = { strpos_t(sourceSize), sourceTime, sourceHash, strpos_t(cachedSize) };
+	}
+	delete file;
+}
+
+static void SaveManifest()
+{
+	FileStream out;
+	if (!out.Create(ManifestPath())) {
+		Log(ERROR, "FileCache", "Cannot write {}.", ManifestPath());
+		return;
+	}
+	for (const auto& entry : manifest) {
+		const CachedArchive& archive = entry.second;
+		std::string line = fmt::format("{} {} {} {} {}\n", archive.sourceSize, archive.sourceTime, archive.sourceHash, archive.cachedSize, entry.first);
+		out.Write(line.c_str(), line.size());
+	}
+}
+
+// the cheap fingerprint of an archive: its size, time and the hash of its start
+static bool DescribeArchive(const path_t& source, CachedArchive& archive)
+{
+	FileStream* file = FileStream::OpenFile(source);
+	if (!file) return false;
+
+	archive.sourceSize = file->Size();
+	Hasher hasher;
+	uint32_t buffer[1024];
+	strpos_t remains = std::min(archive.sourceSize, HASHED_BYTES);
+	while (remains > 0) {
+		strpos_t chunk = std::min<strpos_t>(remains, sizeof(buffer));
+		memset(buffer, 0, sizeof(buffer));
+		file->Read(buffer, chunk);
+		for (size_t i = 0; i < (chunk + 3) / 4; i++) {
+			hasher.Feed(buffer[i]);
+		}
+		remains -= chunk;
+	}
+	delete file;
+	archive.sourceHash = hasher.GetHash().value;
+
+	const std::tm* time = FileModificationTime(source);
+	if (time) {
+		std::tm localTime = *time;
+		archive.sourceTime = std::mktime(&localTime);
+	}
+	return true;
+}
+
+static DataStream* OpenCacheFile(const path_t& path)
+{
+#if defined(SUPPORTS_MEMSTREAM)
+	auto stream = new MappedFileMemoryStream { path };
+	if (!stream->isOk()) {
+		delete stream;
+		return nullptr;
+	}
+	return stream;
+#else
+	return FileStream::OpenFile(path);
+#endif
+}
+
 DataStream* CacheCompressedStream(DataStream* stream, const path_t& filename, int length, bool overwrite)
 {
 	path_t fname = ExtractFileFromPath(filename);
@@ -49,11 +161,90 @@ DataStream* CacheCompressedStream(DataStream* stream, const path_t& filename, in
 	} else {
 		stream->Seek(length, GEM_CURRENT_POS);
 	}
-#if defined(SUPPORTS_MEMSTREAM)
-	return new MappedFileMemoryStream { path };
-#else
-	return FileStream::OpenFile(path);
-#endif
+	return OpenCacheFile(path);
+}
+
+DataStream* OpenCachedArchive(const path_t& source)
+{
+	path_t name = ExtractFileFromPath(source);
+	CachedArchive current;
+	{
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		LoadManifest();
+		auto entry = manifest.find(name);
+		if (entry == manifest.end()) return nullptr;
+		current = entry->second;
+	}
+
+	CachedArchive actual;
+	if (!DescribeArchive(source, actual)) return nullptr;
+	if (actual.sourceSize != current.sourceSize || actual.sourceTime != current.sourceTime || actual.sourceHash != current.sourceHash) {
+		Log(MESSAGE, "FileCache", "Cached copy of {} is outdated.", name);
+		return nullptr;
+	}
+
+	DataStream* cached = OpenCacheFile(PathJoin(core->config.CachePath, name));
+	if (cached && cached->Size() != current.cachedSize) {
+		Log(MESSAGE, "FileCache", "Cached copy of {} is incomplete.", name);
+		delete cached;
+		return nullptr;
+	}
+	return cached;
+}
+
+void AddCachedArchive(const path_t& source)
+{
+	path_t name = ExtractFileFromPath(source);
+	CachedArchive archive;
+	if (!DescribeArchive(source, archive)) return;
+
+	FileStream* cached = FileStream::OpenFile(PathJoin(core->config.CachePath, name));
+	if (!cached) return;
+	archive.cachedSize = cached->Size();
+	delete cached;
+
+	std::lock_guard<std::mutex> lock(manifestMutex);
+	LoadManifest();
+	manifest[name] = archive;
+	SaveManifest();
+}
+
+static void RemoveTree(const path_t& path)
+{
+	DirectoryIterator dir(path);
+	dir.SetFlags(DirectoryIterator::Files | DirectoryIterator::Directories, true);
+	if (dir) {
+		do {
+			if (dir.IsDirectory()) {
+				RemoveTree(dir.GetFullPath());
+			} else {
+				UnlinkFile(dir.GetFullPath());
+			}
+		} while (++dir);
+	}
+	RemoveDirectory(path);
+}
+
+void ClearCache()
+{
+	const path_t& path = core->config.CachePath;
+	std::lock_guard<std::mutex> lock(manifestMutex);
+	LoadManifest();
+
+	DirectoryIterator dir(path);
+	dir.SetFlags(DirectoryIterator::Files | DirectoryIterator::Directories, true);
+	if (!dir) {
+		return;
+	}
+	do {
+		const path_t& name = dir.GetName();
+		if (dir.IsDirectory()) {
+			if (name != CompiledScriptDir) RemoveTree(dir.GetFullPath());
+			continue;
+		}
+		if (name == manifestName || name == DirectoryIndex::FileName || manifest.count(name)) continue;
+		UnlinkFile(dir.GetFullPath());
+	} while (++dir);
 }
 
 }
@@ -25,6 +25,19 @@ namespace GemRB {
 
 GEM_EXPORT DataStream* CacheCompressedStream(DataStream* stream, const path_t& filename, int length = 0, bool overwrite = false);
 
+/**
+ * Decompressed copies of compressed archives are kept in the cache between runs.
+ * A manifest in the cache records the size, modification time and a hash of the
+ * start of each source archive, so stale or half written copies are redone.
+ */
+// returns the cached copy of the archive at source if it is still valid
+GEM_EXPORT DataStream* OpenCachedArchive(const path_t& source);
+// records the copy of source that was just written to the cache
+GEM_EXPORT void AddCachedArchive(const path_t& source);
+// empties the cache, including any subdirectories, except for the archive copies in the manifest,
+// the directory index and the compiled scripts, which clean up after themselves
+GEM_EXPORT void ClearCache();
+
 }
 
 #endif
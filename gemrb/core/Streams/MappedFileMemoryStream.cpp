@@ -28,11 +28,7 @@
 
 namespace GemRB {
 
-MappedFileMemoryStream::MappedFileMemoryStream(const std::string& fileName)
-	: MemoryStream(fileName.c_str(), nullptr, 0),
-	  fileHandle(nullptr),
-	  fileOpened(false),
-	  fileMapped(false)
+MappedFileMemoryStream::MappedFile::MappedFile(const std::string& fileName)
 {
 #ifdef WIN32
 	TCHAR t_name[MAX_PATH] = { 0 };
@@ -68,24 +64,63 @@ MappedFileMemoryStream::MappedFileMemoryStream(const std::string& fileName)
 #endif
 
 	if (fileOpened) {
-		this->data = static_cast<char*>(readonly_mmap(fileHandle));
+		this->data = readonly_mmap(fileHandle);
 		this->fileMapped = data != nullptr;
 	}
 }
 
+MappedFileMemoryStream::MappedFile::~MappedFile()
+{
+	if (fileMapped) {
+		munmap(data, size);
+	}
+
+	if (fileOpened) {
+#ifdef WIN32
+		CloseHandle(fileHandle);
+#else
+		fclose(static_cast<FILE*>(fileHandle));
+#endif
+	}
+}
+
+MappedFileMemoryStream::MappedFileMemoryStream(const std::string& fileName)
+	: MemoryStream(fileName.c_str(), nullptr, 0),
+	  file(std::make_shared<MappedFile>(fileName))
+{
+	size = file->size;
+	data = static_cast<char*>(file->data);
+}
+
+MappedFileMemoryStream::MappedFileMemoryStream(const std::shared_ptr<MappedFile>& file, const path_t& name, strpos_t start, strpos_t length)
+	: MemoryStream(name, nullptr, 0),
+	  file(file)
+{
+	size = length;
+	data = static_cast<char*>(file->data) + start;
+}
+
 bool MappedFileMemoryStream::isOk() const
 {
-	return fileOpened && fileMapped;
+	return file->fileOpened && file->fileMapped;
 }
 
 DataStream* MappedFileMemoryStream::Clone() const noexcept
 {
-	return new MappedFileMemoryStream(originalfile);
+	return new MappedFileMemoryStream(file, originalfile, data - static_cast<char*>(file->data), size);
+}
+
+DataStream* MappedFileMemoryStream::Slice(strpos_t start, strpos_t length) const
+{
+	if (!file->fileMapped || start + length > size) {
+		return nullptr;
+	}
+	return new MappedFileMemoryStream(file, originalfile, data - static_cast<char*>(file->data) + start, length);
 }
 
 strret_t MappedFileMemoryStream::Read(void* dest, strpos_t length)
 {
-	if (!fileMapped) {
+	if (!file->fileMapped) {
 		return Error;
 	}
 
@@ -94,7 +129,7 @@ strret_t MappedFileMemoryStream::Read(void* dest, strpos_t length)
 
 stroff_t MappedFileMemoryStream::Seek(stroff_t pos, strpos_t startPos)
 {
-	if (!fileMapped) {
+	if (!file->fileMapped) {
 		return InvalidPos;
 	}
 
@@ -108,19 +143,8 @@ strret_t MappedFileMemoryStream::Write(const void*, strpos_t)
 
 MappedFileMemoryStream::~MappedFileMemoryStream()
 {
-	if (fileMapped) {
-		munmap(data, size);
-	}
-
+	// the mapping is released with the last stream using it
 	this->data = nullptr;
-
-	if (fileOpened) {
-#ifdef WIN32
-		CloseHandle(fileHandle);
-#else
-		fclose(static_cast<FILE*>(fileHandle));
-#endif
-	}
 }
 
 }
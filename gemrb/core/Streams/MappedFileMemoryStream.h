@@ -21,6 +21,8 @@
 #include "DataStream.h"
 #include "MemoryStream.h"
 
+#include <memory>
+
 namespace GemRB {
 
 class GEM_EXPORT MappedFileMemoryStream : public MemoryStream {
@@ -33,12 +35,27 @@ public:
 	strret_t Read(void* dest, strpos_t len) override;
 	strret_t Seek(stroff_t pos, strpos_t startPos) override;
 	strret_t Write(const void* src, strpos_t len) override;
+	// clones and slices share the mapping, so they don't copy or remap anything
 	DataStream* Clone() const noexcept override;
+	DataStream* Slice(strpos_t start, strpos_t length) const;
 
 private:
-	void* fileHandle;
-	bool fileOpened;
-	bool fileMapped;
+	struct MappedFile {
+		void* fileHandle = nullptr;
+		void* data = nullptr;
+		strpos_t size = 0;
+		bool fileOpened = false;
+		bool fileMapped = false;
+
+		explicit MappedFile(const std::string& fileName);
+		MappedFile(const MappedFile&) = delete;
+		~MappedFile();
+		MappedFile& operator=(const MappedFile&) = delete;
+	};
+
+	std::shared_ptr<MappedFile> file;
+
+	MappedFileMemoryStream(const std::shared_ptr<MappedFile>& file, const path_t& name, strpos_t start, strpos_t length);
 };
 
 }
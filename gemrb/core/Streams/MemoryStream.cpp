@@ -22,10 +22,12 @@
 
 #include "Logging/Logging.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 MemoryStream::MemoryStream(const path_t& name, void* data, strpos_t size)
-	: data((char*) data)
+	: data((char*) data), capacity(size)
 {
 	this->size = size;
 	originalfile = name;
@@ -63,8 +65,17 @@ strret_t MemoryStream::Read(void* dest, strpos_t length)
 strret_t MemoryStream::Write(const void* src, strpos_t length)
 {
 	if (Pos + length > size) {
-		//error("MemoryStream", "We don't support appending to memory streams yet.");
-		return Error;
+		// appending, usually in many small writes, so grow geometrically
+		if (Pos + length > capacity) {
+			strpos_t newCapacity = std::max(Pos + length, capacity * 2);
+			char* grown = static_cast<char*>(realloc(data, newCapacity));
+			if (!grown) {
+				return Error;
+			}
+			data = grown;
+			capacity = newCapacity;
+		}
+		size = Pos + length;
 	}
 	memcpy(data + Pos, src, length);
 	Pos += length;
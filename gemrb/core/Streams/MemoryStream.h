@@ -30,8 +30,10 @@ namespace GemRB {
 class GEM_EXPORT MemoryStream : public DataStream {
 protected:
 	char* data;
+	strpos_t capacity;
 
 public:
+	// takes ownership of the malloc'd data, writing past its end grows it
 	MemoryStream(const path_t& name, void* data, strpos_t size);
 	~MemoryStream() override;
 	DataStream* Clone() const noexcept override;
@@ -39,6 +41,9 @@ public:
 	strret_t Read(void* dest, strpos_t length) override;
 	strret_t Write(const void* src, strpos_t length) override;
 	strret_t Seek(stroff_t pos, strpos_t startpos) override;
+
+	// the whole buffer, for readers that want to avoid copying
+	const char* GetBuffer() const noexcept { return data; }
 };
 
 }
@@ -29,6 +29,7 @@
 #include "Strings/UTF8Comparison.h"
 
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
 #include <sys/stat.h>
 
@@ -298,6 +299,48 @@ std::tm* FileModificationTime(const path_t& path)
 #endif
 }
 
+long long DirectoryModificationTime(const path_t& path)
+{
+#ifdef WIN32
+	auto buffer = StringFromUtf8(path.c_str());
+	auto wideChars = reinterpret_cast<const wchar_t*>(buffer.c_str());
+
+	// directories can only be opened with backup semantics
+	auto dir =
+		CreateFile(
+			wideChars,
+			FILE_READ_ATTRIBUTES,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS,
+			nullptr);
+
+	if (dir == INVALID_HANDLE_VALUE) {
+		return 0;
+	}
+
+	FILETIME modificationTime;
+	auto result = GetFileTime(dir, nullptr, nullptr, &modificationTime);
+	CloseHandle(dir);
+	if (result == 0) {
+		return 0;
+	}
+
+	// 100ns intervals since 1601
+	ULARGE_INTEGER ticks;
+	ticks.LowPart = modificationTime.dwLowDateTime;
+	ticks.HighPart = modificationTime.dwHighDateTime;
+	return static_cast<long long>((ticks.QuadPart - 116444736000000000ULL) / 10000000ULL);
+#else
+	struct stat statStruct;
+	if (stat(path.c_str(), &statStruct)) {
+		return 0;
+	}
+	return statStruct.st_mtime;
+#endif
+}
+
 void PathAppend(path_t& target, const path_t& name)
 {
 	if (name.empty()) {
@@ -616,6 +659,17 @@ bool UnlinkFile(const path_t& path)
 #endif
 }
 
+bool RenameFile(const path_t& from, const path_t& to)
+{
+#ifdef WIN32
+	auto wideFrom = StringFromUtf8(from);
+	auto wideTo = StringFromUtf8(to);
+	return MoveFileExW(reinterpret_cast<const wchar_t*>(wideFrom.c_str()), reinterpret_cast<const wchar_t*>(wideTo.c_str()), MOVEFILE_REPLACE_EXISTING);
+#else
+	return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 bool RemoveDirectory(const path_t& path)
 {
 #ifdef WIN32
@@ -33,6 +33,7 @@
 
 #include "fmt/format.h"
 
+#include <ctime>
 #include <string>
 
 #ifdef WIN32
@@ -78,6 +79,8 @@ GEM_EXPORT path_t& ResolveFilePath(path_t& FilePath);
 GEM_EXPORT bool DirExists(const path_t& path);
 GEM_EXPORT bool FileExists(const path_t& path);
 GEM_EXPORT std::tm* FileModificationTime(const path_t& path);
+// seconds since the epoch, 0 if unknown; unlike FileModificationTime it also works for directories on windows
+GEM_EXPORT long long DirectoryModificationTime(const path_t& path);
 
 // when case sensitivity is enabled dir will be transformed to fit the case of the actual items composing the path
 GEM_EXPORT path_t& ResolveCase(path_t& dir);
@@ -152,6 +155,8 @@ void munmap(void* start, size_t);
 
 GEM_EXPORT bool RemoveDirectory(const path_t& path);
 GEM_EXPORT bool UnlinkFile(const path_t& path);
+// replaces to if it exists
+GEM_EXPORT bool RenameFile(const path_t& from, const path_t& to);
 
 class GEM_EXPORT DirectoryIterator {
 public:
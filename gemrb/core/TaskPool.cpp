@@ -0,0 +1,143 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace GemRB {
+
+TaskPool::TaskPool(size_t threadCount)
+{
+	threadCount = std::max<size_t>(threadCount, 1);
+	for (size_t i = 0; i < threadCount; ++i) {
+		threads.emplace_back(&TaskPool::Run, this);
+	}
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		changed.wait(lock, [this]() {
+			return std::all_of(tasks.begin(), tasks.end(), [](const Entry& entry) { return entry.state == State::Done; });
+		});
+		quit = true;
+	}
+	changed.notify_all();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+TaskPool::TaskID TaskPool::Add(Task task, std::vector<TaskID> dependencies)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	TaskID id = tasks.size();
+	for (TaskID dependency : dependencies) {
+		assert(dependency < id);
+		(void) dependency;
+	}
+	tasks.push_back({ std::move(task), std::move(dependencies) });
+	changed.notify_all();
+	return id;
+}
+
+void TaskPool::Wait(TaskID id)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	assert(id < tasks.size());
+	changed.wait(lock, [this, id]() { return tasks[id].state == State::Done; });
+	if (tasks[id].error) {
+		std::rethrow_exception(tasks[id].error);
+	}
+}
+
+void TaskPool::WaitAll()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	TaskID count = tasks.size();
+	lock.unlock();
+	for (TaskID id = 0; id < count; ++id) {
+		Wait(id);
+	}
+}
+
+TaskPool::TaskID TaskPool::NextReady()
+{
+	for (TaskID id = 0; id < tasks.size(); ++id) {
+		Entry& entry = tasks[id];
+		if (entry.state != State::Pending) continue;
+
+		bool ready = true;
+		std::exception_ptr error;
+		for (TaskID dependency : entry.dependencies) {
+			const Entry& other = tasks[dependency];
+			if (other.state != State::Done) {
+				ready = false;
+				break;
+			}
+			if (other.error) error = other.error;
+		}
+		if (!ready) continue;
+		if (!error) return id;
+
+		// no point in running it, the later tasks see it as failed too
+		entry.state = State::Done;
+		entry.error = error;
+		entry.task = nullptr;
+		changed.notify_all();
+	}
+	return tasks.size();
+}
+
+void TaskPool::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		TaskID id = NextReady();
+		if (id == tasks.size()) {
+			if (quit) return;
+			changed.wait(lock);
+			continue;
+		}
+
+		Entry& entry = tasks[id];
+		entry.state = State::Running;
+		Task task = std::move(entry.task);
+		lock.unlock();
+
+		std::exception_ptr error;
+		try {
+			task();
+		} catch (...) {
+			error = std::current_exception();
+		}
+
+		lock.lock();
+		// the vector may have grown meanwhile
+		tasks[id].state = State::Done;
+		tasks[id].error = error;
+		changed.notify_all();
+	}
+}
+
+}
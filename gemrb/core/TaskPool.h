@@ -0,0 +1,88 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+#include "exports.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * Runs tasks on a few background threads, each once the tasks it depends on
+ * are done. Meant for work that shares no state with what runs meanwhile,
+ * like reading the TLK during the rest of the startup.
+ *
+ * Whatever a task throws is rethrown by Wait. The tasks depending on a
+ * failed one aren't run and fail the same way.
+ */
+class GEM_EXPORT TaskPool {
+public:
+	using Task = std::function<void()>;
+	using TaskID = size_t;
+
+	explicit TaskPool(size_t threadCount);
+	TaskPool(const TaskPool&) = delete;
+	// waits for the tasks, dropping their errors
+	~TaskPool();
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	// dependencies have to be added before
+	TaskID Add(Task task, std::vector<TaskID> dependencies = {});
+	// blocks until the task is done and rethrows its error
+	void Wait(TaskID id);
+	// blocks until all are done and rethrows the first error
+	void WaitAll();
+
+private:
+	enum class State : uint8_t {
+		Pending,
+		Running,
+		Done
+	};
+
+	struct Entry {
+		Task task;
+		std::vector<TaskID> dependencies;
+		State state = State::Pending;
+		std::exception_ptr error;
+	};
+
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::vector<Entry> tasks;
+	std::vector<std::thread> threads;
+	bool quit = false;
+
+	void Run();
+	// the caller holds the lock, returns tasks.size() if none can start
+	TaskID NextReady();
+};
+
+}
+
+#endif
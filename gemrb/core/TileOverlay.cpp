@@ -34,6 +34,15 @@ void TileOverlay::AddTile(Tile&& tile)
 	tiles.push_back(std::move(tile));
 }
 
+// static tiles don't need to go through the frame timing
+static Holder<Sprite2D> TileFrame(Animation* anim)
+{
+	if (anim->GetFrameCount() == 1 && bool(anim->flags & Animation::Flags::Active)) {
+		return anim->CurrentFrame();
+	}
+	return anim->NextFrame();
+}
+
 void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags) const
 {
 	// determine which tiles are visible
@@ -50,6 +59,23 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 	}
 	const Color tintcol = globalTint ? *globalTint : Color();
 
+	// overlay tiles should be half transparent except for BG1
+	bool layeredWater = core->HasFeature(GFFlags::LAYERED_WATER_TILES);
+	BlitFlags transFlag = layeredWater ? BlitFlags::HALFTRANS : BlitFlags::NONE;
+
+	// all the tiles of an overlay show the same frame
+	overlayFrames.assign(overlays.size(), nullptr);
+	for (size_t z = 1; z < overlays.size(); ++z) {
+		const auto& ov = overlays[z];
+		if (ov && !ov->tiles.empty()) {
+			overlayFrames[z] = ov->tiles[0].GetAnimation(0)->NextFrame(); //allow only 1x1 tiles now
+		}
+	}
+
+	// tiles don't overlap, so each layer can be drawn in one pass
+	baseBlits.clear();
+	overlayBlits.clear();
+	maskBlits.clear();
 	for (int y = sy; y < dy && y < size.h; y++) {
 		for (int x = sx; x < dx && x < size.w; x++) {
 			const Tile& tile = tiles[(y * size.w) + x];
@@ -60,7 +86,7 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 
 			// this is the base terrain tile
 			Point p = Point(x * 64, y * 64) - viewport.origin;
-			VideoDriver->BlitGameSprite(anim->NextFrame(), p, flags, tintcol);
+			baseBlits.push_back({ TileFrame(anim), p, flags });
 
 			if (!tile.om || tile.tileIndex) {
 				continue;
@@ -68,33 +94,29 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 
 			int mask = 2;
 			for (size_t z = 1; z < overlays.size(); ++z) {
-				const auto& ov = overlays[z];
-				if (ov && !ov->tiles.empty()) {
-					const Tile& ovtile = ov->tiles[0]; //allow only 1x1 tiles now
-					if (tile.om & mask) {
-						//draw overlay tiles, they should be half transparent except for BG1
-						BlitFlags transFlag = (core->HasFeature(GFFlags::LAYERED_WATER_TILES)) ? BlitFlags::HALFTRANS : BlitFlags::NONE;
-						// this is the water (or whatever)
-						VideoDriver->BlitGameSprite(ovtile.GetAnimation(0)->NextFrame(), p, flags | transFlag, tintcol);
-
-						if (core->HasFeature(GFFlags::LAYERED_WATER_TILES)) {
-							Animation* anim1 = tile.GetAnimation(1);
-							if (anim1) {
-								// this is the mask to blend the terrain tile with the water for everything but BG1
-								VideoDriver->BlitGameSprite(anim1->NextFrame(), p,
-											    flags | BlitFlags::BLENDED, tintcol);
-							}
-						} else {
-							// in BG 1 this is the mask to blend the terrain tile with the water
-							VideoDriver->BlitGameSprite(tile.GetAnimation(0)->NextFrame(), p,
-										    flags | BlitFlags::BLENDED, tintcol);
+				if (overlayFrames[z] && (tile.om & mask)) {
+					// this is the water (or whatever)
+					overlayBlits.push_back({ overlayFrames[z], p, flags | transFlag });
+
+					if (layeredWater) {
+						Animation* anim1 = tile.GetAnimation(1);
+						if (anim1) {
+							// this is the mask to blend the terrain tile with the water for everything but BG1
+							maskBlits.push_back({ TileFrame(anim1), p, flags | BlitFlags::BLENDED });
 						}
+					} else {
+						// in BG 1 this is the mask to blend the terrain tile with the water
+						maskBlits.push_back({ TileFrame(tile.GetAnimation(0)), p, flags | BlitFlags::BLENDED });
 					}
 				}
 				mask <<= 1;
 			}
 		}
 	}
+
+	VideoDriver->BlitGameSprites(baseBlits, tintcol);
+	VideoDriver->BlitGameSprites(overlayBlits, tintcol);
+	VideoDriver->BlitGameSprites(maskBlits, tintcol);
 }
 
 }
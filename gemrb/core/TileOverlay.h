@@ -24,6 +24,7 @@
 #include "exports.h"
 
 #include "Tile.h"
+#include "Video/Video.h"
 
 #include <vector>
 
@@ -46,6 +47,13 @@ public:
 
 	void AddTile(Tile&& tile);
 	void Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags) const;
+
+private:
+	// draw lists, kept to reuse their storage between frames
+	mutable std::vector<Video::GameSpriteBlit> baseBlits;
+	mutable std::vector<Video::GameSpriteBlit> overlayBlits;
+	mutable std::vector<Video::GameSpriteBlit> maskBlits;
+	mutable std::vector<Holder<Sprite2D>> overlayFrames;
 };
 
 }
@@ -0,0 +1,81 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "VariableSlots.h"
+
+#include <unordered_map>
+
+namespace GemRB {
+
+static std::unordered_map<ieVariable, uint32_t, CstrHashCI> symbols[2];
+
+uint32_t InternVariable(const ieVariable& name, VariableSpace space)
+{
+	auto& table = symbols[size_t(space)];
+	return table.emplace(name, uint32_t(table.size())).first->second;
+}
+
+size_t InternedVariableCount(VariableSpace space)
+{
+	return symbols[size_t(space)].size();
+}
+
+VariableSlots::Slot& VariableSlots::At(VariableSpace space, uint32_t id)
+{
+	auto& table = slots[size_t(space)];
+	if (id >= table.size()) {
+		table.resize(id + 1);
+	}
+	return table[id];
+}
+
+const ieDword* VariableSlots::Find(const ieVarsMap& vars, VariableSpace space, uint32_t id, const char* name)
+{
+	Slot& slot = At(space, id);
+	if (slot.value) return slot.value;
+	if (slot.missingAt == vars.size() + 1) return nullptr;
+
+	auto lookup = vars.find(ieVariable { name });
+	if (lookup == vars.cend()) {
+		slot.missingAt = vars.size() + 1;
+		return nullptr;
+	}
+	slot.value = &lookup->second;
+	return slot.value;
+}
+
+ieDword* VariableSlots::Get(ieVarsMap& vars, VariableSpace space, uint32_t id, const char* name, bool create)
+{
+	// vars is ours to modify, Find just has no reason to ask for that
+	ieDword* value = const_cast<ieDword*>(Find(vars, space, id, name));
+	if (value || !create) return value;
+
+	value = &vars[ieVariable { name }];
+	At(space, id).value = value;
+	return value;
+}
+
+void VariableSlots::Clear()
+{
+	slots[0].clear();
+	slots[1].clear();
+}
+
+}
@@ -0,0 +1,77 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef VARIABLESLOTS_H
+#define VARIABLESLOTS_H
+
+#include "exports.h"
+#include "ie_types.h"
+
+#include <vector>
+
+namespace GemRB {
+
+// names used with the LOCALS scope get their own ids, since every actor has slots for them
+enum class VariableSpace : uint8_t {
+	Shared,
+	Local
+};
+
+// returns the dense id of a variable name, the same for all names differing only in case
+GEM_EXPORT uint32_t InternVariable(const ieVariable& name, VariableSpace space);
+GEM_EXPORT size_t InternedVariableCount(VariableSpace space);
+
+/**
+ * Direct access to the entries of an ieVarsMap through interned ids.
+ *
+ * The slots point at the nodes of the map, which stay where they are as long
+ * as nothing is erased from it. So they have to live next to their map and
+ * aren't copied with it. Missing variables are remembered until the map grows.
+ */
+class GEM_EXPORT VariableSlots {
+public:
+	VariableSlots() noexcept = default;
+	VariableSlots(const VariableSlots&) noexcept {}
+	VariableSlots& operator=(const VariableSlots&) noexcept
+	{
+		Clear();
+		return *this;
+	}
+
+	// name is only used the first time, to find the variable in vars
+	const ieDword* Find(const ieVarsMap& vars, VariableSpace space, uint32_t id, const char* name);
+	// returns nullptr if the variable doesn't exist and create is false
+	ieDword* Get(ieVarsMap& vars, VariableSpace space, uint32_t id, const char* name, bool create);
+	void Clear();
+
+private:
+	struct Slot {
+		const ieDword* value = nullptr;
+		size_t missingAt = 0; // size of the map plus one when the variable wasn't found
+	};
+
+	std::vector<Slot> slots[2];
+
+	Slot& At(VariableSpace space, uint32_t id);
+};
+
+}
+
+#endif
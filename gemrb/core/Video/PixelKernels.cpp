@@ -0,0 +1,513 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "PixelKernels.h"
+
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define PIXELKERNELS_X86
+	#define PIXELKERNELS_AVX2
+	#define TARGET_SSE2 __attribute__((target("sse2")))
+	#define TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+	// SSE2 is part of x86-64, AVX2 would need cpuid checks
+	#define PIXELKERNELS_X86
+	#define TARGET_SSE2
+#endif
+
+#ifdef PIXELKERNELS_X86
+	#include <immintrin.h>
+#endif
+
+namespace GemRB {
+
+static PixelKernelISA DetectISA()
+{
+#if defined(PIXELKERNELS_AVX2)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return PixelKernelISA::AVX2;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return PixelKernelISA::SSE2;
+	}
+#elif defined(PIXELKERNELS_X86)
+	return PixelKernelISA::SSE2;
+#endif
+	return PixelKernelISA::Scalar;
+}
+
+static PixelKernelISA& ActiveISA()
+{
+	static PixelKernelISA isa = SupportedPixelKernelISA();
+	return isa;
+}
+
+PixelKernelISA SupportedPixelKernelISA()
+{
+	static const PixelKernelISA supported = DetectISA();
+	return supported;
+}
+
+PixelKernelISA GetPixelKernelISA()
+{
+	return ActiveISA();
+}
+
+void SetPixelKernelISA(PixelKernelISA isa)
+{
+	ActiveISA() = std::min(isa, SupportedPixelKernelISA());
+}
+
+// finds the byte of each channel, the alpha one being the remaining byte
+static bool ChannelLanes(const PixelFormat& fmt, uint8_t lane[4])
+{
+	if (fmt.Bpp != 4 || fmt.Rloss || fmt.Gloss || fmt.Bloss) {
+		return false;
+	}
+
+	const uint8_t shifts[3] = { fmt.Rshift, fmt.Gshift, fmt.Bshift };
+	const uint32_t masks[3] = { fmt.Rmask, fmt.Gmask, fmt.Bmask };
+	unsigned int used = 0;
+	for (int i = 0; i < 3; ++i) {
+		if (shifts[i] % 8 || shifts[i] > 24 || masks[i] != 0xffU << shifts[i]) {
+			return false;
+		}
+		lane[i] = shifts[i] / 8;
+		used |= 1 << lane[i];
+	}
+	if (used == 0x7) {
+		lane[3] = 3;
+	} else if (used == 0xb) {
+		lane[3] = 2;
+	} else if (used == 0xd) {
+		lane[3] = 1;
+	} else if (used == 0xe) {
+		lane[3] = 0;
+	} else {
+		return false;
+	}
+
+	return fmt.Amask == 0 || (fmt.Aloss == 0 && fmt.Amask == 0xffU << (lane[3] * 8));
+}
+
+static inline uint8_t LaneByte(uint32_t px, uint8_t lane)
+{
+	return px >> (lane * 8);
+}
+
+static inline uint32_t LaneValue(uint8_t v, uint8_t lane)
+{
+	return uint32_t(v) << (lane * 8);
+}
+
+static void BlendRowScalar(const RowBlender32& b, const uint32_t* src, uint32_t* dst, int count)
+{
+	const uint8_t* lane = b.lane;
+	for (int i = 0; i < count; ++i) {
+		uint32_t d = dst[i];
+		Color dc(LaneByte(d, lane[0]), LaneByte(d, lane[1]), LaneByte(d, lane[2]), b.dstAlpha ? LaneByte(d, lane[3]) : 255);
+		Color c(LaneByte(src[i], lane[0]), LaneByte(src[i], lane[1]), LaneByte(src[i], lane[2]), LaneByte(src[i], lane[3]));
+		// like BlitBlendedRect, the pixel is written back even if there is nothing to blend
+		if (c.a == 0) {
+			dst[i] = (LaneValue(dc.r, lane[0]) | LaneValue(dc.g, lane[1]) | LaneValue(dc.b, lane[2]) | LaneValue(dc.a, lane[3])) & b.dstMask;
+			continue;
+		}
+
+		if (b.shade == SHADER::TINT || b.shade == SHADER::GREYSCALE || b.shade == SHADER::SEPIA) {
+			c.r = (b.tint.r * c.r) >> b.shift;
+			c.g = (b.tint.g * c.g) >> b.shift;
+			c.b = (b.tint.b * c.b) >> b.shift;
+		}
+		if (b.shade == SHADER::GREYSCALE) {
+			uint8_t avg = c.r + c.g + c.b;
+			c.r = c.g = c.b = avg;
+		} else if (b.shade == SHADER::SEPIA) {
+			uint8_t avg = c.r + c.g + c.b;
+			c.r = avg + 21;
+			c.g = avg;
+			c.b = avg < 32 ? 0 : avg - 32;
+		}
+
+		ShaderBlend<true>(c, dc);
+		dst[i] = (LaneValue(dc.r, lane[0]) | LaneValue(dc.g, lane[1]) | LaneValue(dc.b, lane[2]) | LaneValue(dc.a, lane[3])) & b.dstMask;
+	}
+}
+
+static void BlendPaletteRowScalar(const PaletteBlender32& b, const uint8_t* indices, uint32_t* dst, int count)
+{
+	const uint8_t* lane = b.lane;
+	for (int i = 0; i < count; ++i) {
+		uint32_t s = b.palette[indices[i]];
+		uint32_t d = dst[i];
+		unsigned int a = LaneByte(s, lane[3]);
+		uint32_t pix = 0;
+		for (int ch = 0; ch < 3; ++ch) {
+			unsigned int v = 1 + a * LaneByte(s, lane[ch]) + (255 - a) * LaneByte(d, lane[ch]);
+			pix |= LaneValue((v + (v >> 8)) >> 8, lane[ch]);
+		}
+		dst[i] = pix | b.amask;
+	}
+}
+
+#ifdef PIXELKERNELS_X86
+// the pixels are unpacked to one 16 bit lane per channel, two pixels per register
+
+TARGET_SSE2 static __m128i LanesSSE2(const uint16_t (&lanes)[4])
+{
+	return _mm_set_epi16(lanes[3], lanes[2], lanes[1], lanes[0], lanes[3], lanes[2], lanes[1], lanes[0]);
+}
+
+// sum of the lanes of each pixel, in all of its lanes
+TARGET_SSE2 static inline __m128i PixelSumSSE2(__m128i v)
+{
+	v = _mm_add_epi16(v, _mm_srli_epi64(v, 16));
+	v = _mm_add_epi16(v, _mm_srli_epi64(v, 32));
+	v = _mm_shufflelo_epi16(v, 0);
+	return _mm_shufflehi_epi16(v, 0);
+}
+
+TARGET_SSE2 static inline __m128i Div255SSE2(__m128i v, __m128i one)
+{
+	return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(v, one), _mm_srli_epi16(v, 8)), 8);
+}
+
+struct BlendConstsSSE2 {
+	__m128i tint;
+	__m128i rgb;
+	__m128i alpha;
+	__m128i sepiaAdd;
+	__m128i sepiaSub;
+	__m128i shift;
+};
+
+TARGET_SSE2 static inline __m128i BlendPixelsSSE2(__m128i s, __m128i d, SHADER shade, const BlendConstsSSE2& k)
+{
+	const __m128i one = _mm_set1_epi16(1);
+	const __m128i low = _mm_set1_epi16(0xff);
+
+	__m128i c = s;
+	if (shade == SHADER::TINT || shade == SHADER::GREYSCALE || shade == SHADER::SEPIA) {
+		c = _mm_and_si128(_mm_srl_epi16(_mm_mullo_epi16(c, k.tint), k.shift), low);
+		if (shade != SHADER::TINT) {
+			c = _mm_and_si128(PixelSumSSE2(_mm_and_si128(c, k.rgb)), low);
+			if (shade == SHADER::SEPIA) {
+				c = _mm_subs_epu16(_mm_add_epi16(c, k.sepiaAdd), k.sepiaSub);
+			}
+		}
+	}
+
+	__m128i a = PixelSumSSE2(_mm_and_si128(s, k.alpha));
+	__m128i srcTerm = Div255SSE2(_mm_mullo_epi16(c, a), one);
+	// the alpha channel is src.a + (255 - src.a) * dst.a
+	srcTerm = _mm_or_si128(_mm_and_si128(srcTerm, k.rgb), _mm_and_si128(s, k.alpha));
+	__m128i dstTerm = Div255SSE2(_mm_mullo_epi16(d, _mm_sub_epi16(low, a)), one);
+	return _mm_add_epi16(srcTerm, dstTerm);
+}
+
+TARGET_SSE2 static void BlendRowSSE2(const RowBlender32& b, const uint32_t* src, uint32_t* dst, int count)
+{
+	uint16_t tint[4] = {};
+	uint16_t rgb[4] = {};
+	uint16_t alpha[4] = {};
+	uint16_t sepiaAdd[4] = {};
+	uint16_t sepiaSub[4] = {};
+	tint[b.lane[0]] = b.tint.r;
+	tint[b.lane[1]] = b.tint.g;
+	tint[b.lane[2]] = b.tint.b;
+	rgb[b.lane[0]] = rgb[b.lane[1]] = rgb[b.lane[2]] = 0xffff;
+	alpha[b.lane[3]] = 0xffff;
+	sepiaAdd[b.lane[0]] = 21;
+	sepiaSub[b.lane[2]] = 32;
+
+	BlendConstsSSE2 k;
+	k.tint = LanesSSE2(tint);
+	k.rgb = LanesSSE2(rgb);
+	k.alpha = LanesSSE2(alpha);
+	k.sepiaAdd = LanesSSE2(sepiaAdd);
+	k.sepiaSub = LanesSSE2(sepiaSub);
+	k.shift = _mm_cvtsi32_si128(b.shift);
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i dstFill = _mm_set1_epi32(b.dstAlpha ? 0 : LaneValue(0xff, b.lane[3]));
+	const __m128i dstMask = _mm_set1_epi32(b.dstMask);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+		__m128i dIn = _mm_or_si128(d, dstFill);
+
+		__m128i lo = BlendPixelsSSE2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(dIn, zero), b.shade, k);
+		__m128i hi = BlendPixelsSSE2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(dIn, zero), b.shade, k);
+		// fully transparent source pixels come out unchanged, no need to special case them
+		__m128i out = _mm_and_si128(_mm_packus_epi16(lo, hi), dstMask);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+	}
+	BlendRowScalar(b, src + i, dst + i, count - i);
+}
+
+TARGET_SSE2 static inline __m128i BlendPaletteSSE2(__m128i s, __m128i d, __m128i alphaLane)
+{
+	const __m128i one = _mm_set1_epi16(1);
+	__m128i a = PixelSumSSE2(_mm_and_si128(s, alphaLane));
+	__m128i v = _mm_add_epi16(_mm_add_epi16(one, _mm_mullo_epi16(a, s)),
+				  _mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(255), a), d));
+	return _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+}
+
+TARGET_SSE2 static void BlendPaletteRowSSE2(const PaletteBlender32& b, const uint8_t* indices, uint32_t* dst, int count)
+{
+	uint16_t alpha[4] = {};
+	alpha[b.lane[3]] = 0xffff;
+	const __m128i alphaLane = LanesSSE2(alpha);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rgbMask = _mm_set1_epi32(b.rgbMask);
+	const __m128i amask = _mm_set1_epi32(b.amask);
+	const uint32_t* pal = b.palette;
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i s = _mm_set_epi32(pal[indices[i + 3]], pal[indices[i + 2]], pal[indices[i + 1]], pal[indices[i]]);
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+		__m128i lo = BlendPaletteSSE2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), alphaLane);
+		__m128i hi = BlendPaletteSSE2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), alphaLane);
+		__m128i out = _mm_or_si128(_mm_and_si128(_mm_packus_epi16(lo, hi), rgbMask), amask);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+	}
+	BlendPaletteRowScalar(b, indices + i, dst + i, count - i);
+}
+#endif
+
+#ifdef PIXELKERNELS_AVX2
+// the same as the SSE2 versions, each 128 bit half handling its own pixels
+
+TARGET_AVX2 static __m256i LanesAVX2(const uint16_t (&lanes)[4])
+{
+	return _mm256_set_epi16(lanes[3], lanes[2], lanes[1], lanes[0], lanes[3], lanes[2], lanes[1], lanes[0],
+				lanes[3], lanes[2], lanes[1], lanes[0], lanes[3], lanes[2], lanes[1], lanes[0]);
+}
+
+TARGET_AVX2 static inline __m256i PixelSumAVX2(__m256i v)
+{
+	v = _mm256_add_epi16(v, _mm256_srli_epi64(v, 16));
+	v = _mm256_add_epi16(v, _mm256_srli_epi64(v, 32));
+	v = _mm256_shufflelo_epi16(v, 0);
+	return _mm256_shufflehi_epi16(v, 0);
+}
+
+TARGET_AVX2 static inline __m256i Div255AVX2(__m256i v, __m256i one)
+{
+	return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(v, one), _mm256_srli_epi16(v, 8)), 8);
+}
+
+struct BlendConstsAVX2 {
+	__m256i tint;
+	__m256i rgb;
+	__m256i alpha;
+	__m256i sepiaAdd;
+	__m256i sepiaSub;
+	__m128i shift;
+};
+
+TARGET_AVX2 static inline __m256i BlendPixelsAVX2(__m256i s, __m256i d, SHADER shade, const BlendConstsAVX2& k)
+{
+	const __m256i one = _mm256_set1_epi16(1);
+	const __m256i low = _mm256_set1_epi16(0xff);
+
+	__m256i c = s;
+	if (shade == SHADER::TINT || shade == SHADER::GREYSCALE || shade == SHADER::SEPIA) {
+		c = _mm256_and_si256(_mm256_srl_epi16(_mm256_mullo_epi16(c, k.tint), k.shift), low);
+		if (shade != SHADER::TINT) {
+			c = _mm256_and_si256(PixelSumAVX2(_mm256_and_si256(c, k.rgb)), low);
+			if (shade == SHADER::SEPIA) {
+				c = _mm256_subs_epu16(_mm256_add_epi16(c, k.sepiaAdd), k.sepiaSub);
+			}
+		}
+	}
+
+	__m256i a = PixelSumAVX2(_mm256_and_si256(s, k.alpha));
+	__m256i srcTerm = Div255AVX2(_mm256_mullo_epi16(c, a), one);
+	srcTerm = _mm256_or_si256(_mm256_and_si256(srcTerm, k.rgb), _mm256_and_si256(s, k.alpha));
+	__m256i dstTerm = Div255AVX2(_mm256_mullo_epi16(d, _mm256_sub_epi16(low, a)), one);
+	return _mm256_add_epi16(srcTerm, dstTerm);
+}
+
+TARGET_AVX2 static void BlendRowAVX2(const RowBlender32& b, const uint32_t* src, uint32_t* dst, int count)
+{
+	uint16_t tint[4] = {};
+	uint16_t rgb[4] = {};
+	uint16_t alpha[4] = {};
+	uint16_t sepiaAdd[4] = {};
+	uint16_t sepiaSub[4] = {};
+	tint[b.lane[0]] = b.tint.r;
+	tint[b.lane[1]] = b.tint.g;
+	tint[b.lane[2]] = b.tint.b;
+	rgb[b.lane[0]] = rgb[b.lane[1]] = rgb[b.lane[2]] = 0xffff;
+	alpha[b.lane[3]] = 0xffff;
+	sepiaAdd[b.lane[0]] = 21;
+	sepiaSub[b.lane[2]] = 32;
+
+	BlendConstsAVX2 k;
+	k.tint = LanesAVX2(tint);
+	k.rgb = LanesAVX2(rgb);
+	k.alpha = LanesAVX2(alpha);
+	k.sepiaAdd = LanesAVX2(sepiaAdd);
+	k.sepiaSub = LanesAVX2(sepiaSub);
+	k.shift = _mm_cvtsi32_si128(b.shift);
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i dstFill = _mm256_set1_epi32(b.dstAlpha ? 0 : LaneValue(0xff, b.lane[3]));
+	const __m256i dstMask = _mm256_set1_epi32(b.dstMask);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		__m256i dIn = _mm256_or_si256(d, dstFill);
+
+		__m256i lo = BlendPixelsAVX2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(dIn, zero), b.shade, k);
+		__m256i hi = BlendPixelsAVX2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(dIn, zero), b.shade, k);
+		__m256i out = _mm256_and_si256(_mm256_packus_epi16(lo, hi), dstMask);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+	}
+	BlendRowScalar(b, src + i, dst + i, count - i);
+}
+
+TARGET_AVX2 static inline __m256i BlendPaletteAVX2(__m256i s, __m256i d, __m256i alphaLane)
+{
+	const __m256i one = _mm256_set1_epi16(1);
+	__m256i a = PixelSumAVX2(_mm256_and_si256(s, alphaLane));
+	__m256i v = _mm256_add_epi16(_mm256_add_epi16(one, _mm256_mullo_epi16(a, s)),
+				     _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_set1_epi16(255), a), d));
+	return _mm256_srli_epi16(_mm256_add_epi16(v, _mm256_srli_epi16(v, 8)), 8);
+}
+
+TARGET_AVX2 static void BlendPaletteRowAVX2(const PaletteBlender32& b, const uint8_t* indices, uint32_t* dst, int count)
+{
+	uint16_t alpha[4] = {};
+	alpha[b.lane[3]] = 0xffff;
+	const __m256i alphaLane = LanesAVX2(alpha);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i rgbMask = _mm256_set1_epi32(b.rgbMask);
+	const __m256i amask = _mm256_set1_epi32(b.amask);
+	const int* pal = reinterpret_cast<const int*>(b.palette);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+		__m256i s = _mm256_i32gather_epi32(pal, idx, 4);
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+
+		__m256i lo = BlendPaletteAVX2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), alphaLane);
+		__m256i hi = BlendPaletteAVX2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), alphaLane);
+		__m256i out = _mm256_or_si256(_mm256_and_si256(_mm256_packus_epi16(lo, hi), rgbMask), amask);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+	}
+	BlendPaletteRowScalar(b, indices + i, dst + i, count - i);
+}
+#endif
+
+RowBlender32::RowBlender32(SHADER shade, const Color& tint, unsigned int shift, const PixelFormat& dstFormat)
+	: shade(shade), tint(tint), shift(shift)
+{
+	bool valid = ChannelLanes(dstFormat, lane);
+	assert(valid);
+	(void) valid;
+
+	dstAlpha = dstFormat.Amask != 0;
+	dstMask = dstFormat.Rmask | dstFormat.Gmask | dstFormat.Bmask | dstFormat.Amask;
+}
+
+bool RowBlender32::Supports(const PixelFormat& src, const PixelFormat& dst)
+{
+	uint8_t srcLane[4];
+	uint8_t dstLane[4];
+	if (!ChannelLanes(src, srcLane) || !ChannelLanes(dst, dstLane)) {
+		return false;
+	}
+	if (!std::equal(srcLane, srcLane + 4, dstLane)) {
+		return false;
+	}
+	// the pipeline reads the alpha of color keyed pixels as 0
+	return src.Amask && (dst.Amask || !dst.HasColorKey);
+}
+
+void RowBlender32::operator()(const uint32_t* src, uint32_t* dst, int count) const
+{
+	switch (GetPixelKernelISA()) {
+#ifdef PIXELKERNELS_AVX2
+		case PixelKernelISA::AVX2:
+			BlendRowAVX2(*this, src, dst, count);
+			break;
+#endif
+#ifdef PIXELKERNELS_X86
+		case PixelKernelISA::SSE2:
+			BlendRowSSE2(*this, src, dst, count);
+			break;
+#endif
+		default:
+			BlendRowScalar(*this, src, dst, count);
+			break;
+	}
+}
+
+PaletteBlender32::PaletteBlender32(const Color* colors, const PixelFormat& dstFormat)
+{
+	bool valid = ChannelLanes(dstFormat, lane);
+	assert(valid);
+	(void) valid;
+
+	rgbMask = dstFormat.Rmask | dstFormat.Gmask | dstFormat.Bmask;
+	amask = dstFormat.Amask;
+	for (int i = 0; i < 256; ++i) {
+		const Color& c = colors[i];
+		palette[i] = LaneValue(c.r, lane[0]) | LaneValue(c.g, lane[1]) | LaneValue(c.b, lane[2]) | LaneValue(c.a, lane[3]);
+	}
+}
+
+bool PaletteBlender32::Supports(const PixelFormat& dst)
+{
+	uint8_t lane[4];
+	return ChannelLanes(dst, lane);
+}
+
+void PaletteBlender32::operator()(const uint8_t* indices, uint32_t* dst, int count) const
+{
+	switch (GetPixelKernelISA()) {
+#ifdef PIXELKERNELS_AVX2
+		case PixelKernelISA::AVX2:
+			BlendPaletteRowAVX2(*this, indices, dst, count);
+			break;
+#endif
+#ifdef PIXELKERNELS_X86
+		case PixelKernelISA::SSE2:
+			BlendPaletteRowSSE2(*this, indices, dst, count);
+			break;
+#endif
+		default:
+			BlendPaletteRowScalar(*this, indices, dst, count);
+			break;
+	}
+}
+
+}
@@ -0,0 +1,79 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include "Pixels.h"
+
+namespace GemRB {
+
+// Row kernels for the software blitters, for 32bpp formats with 8 bit channels.
+// They produce exactly the same pixels as the per pixel blenders they replace.
+enum class PixelKernelISA : uint8_t {
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+// the best instruction set the cpu supports
+GEM_EXPORT PixelKernelISA SupportedPixelKernelISA();
+GEM_EXPORT PixelKernelISA GetPixelKernelISA();
+// for testing and debugging, anything better than SupportedPixelKernelISA is ignored
+GEM_EXPORT void SetPixelKernelISA(PixelKernelISA isa);
+
+// RGBBlendingPipeline<SHADE, true> with ShaderBlend<true> and no mask
+class GEM_EXPORT RowBlender32 {
+public:
+	// tint and shift as set up by the RGBBlendingPipeline constructors
+	RowBlender32(SHADER shade, const Color& tint, unsigned int shift, const PixelFormat& dstFormat);
+
+	// src needs an alpha channel and the same color layout as dst
+	static bool Supports(const PixelFormat& src, const PixelFormat& dst);
+
+	void operator()(const uint32_t* src, uint32_t* dst, int count) const;
+
+	SHADER shade;
+	Color tint;
+	unsigned int shift;
+	uint8_t lane[4]; // byte of r, g, b and a in a pixel
+	uint32_t dstMask; // bits of the written pixel, dst may lack alpha
+	bool dstAlpha;
+};
+
+// SRBlender_Alpha for 32bpp: palette expansion and alpha blending of RLE literals
+class GEM_EXPORT PaletteBlender32 {
+public:
+	// colors are the 256 (already tinted) palette entries
+	PaletteBlender32(const Color* colors, const PixelFormat& dstFormat);
+
+	static bool Supports(const PixelFormat& dst);
+
+	void operator()(const uint8_t* indices, uint32_t* dst, int count) const;
+
+	uint32_t palette[256]; // in dst layout, with alpha in the otherwise unused byte
+	uint8_t lane[4];
+	uint32_t rgbMask;
+	uint32_t amask;
+};
+
+}
+
+#endif
@@ -252,6 +252,11 @@ public:
 		}
 	}
 
+	// only the default blender has a vectorized version, see RowBlender32
+	bool IsAlphaBlend() const { return blender == ShaderBlend<SRCALPHA>; }
+	const Color& GetTint() const { return tint; }
+	unsigned int GetShift() const { return shift; }
+
 	void operator()(const Color& src, Color& dst, uint8_t mask) const override
 	{
 		if (SRCALPHA && src.a == 0) {
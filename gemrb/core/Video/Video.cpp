@@ -213,6 +213,13 @@ void Video::BlitSprite(const Holder<Sprite2D>& spr, Point p, const Region* clip,
 	BlitSprite(spr, src, fClip, flags | BlitFlags::BLENDED);
 }
 
+void Video::BlitGameSprites(const std::vector<GameSpriteBlit>& blits, Color tint)
+{
+	for (const auto& blit : blits) {
+		BlitGameSprite(blit.spr, blit.p, blit.flags, tint);
+	}
+}
+
 void Video::BlitGameSpriteWithPalette(const Holder<Sprite2D>& spr, const Holder<Palette>& pal, const Point& p,
 				      BlitFlags flags, Color tint)
 {
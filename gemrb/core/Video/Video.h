@@ -33,6 +33,7 @@
 #include "Sprite2D.h"
 
 #include <deque>
+#include <vector>
 
 namespace GemRB {
 
@@ -57,6 +58,8 @@ public:
 
 	virtual void Clear() { Clear({ 0, 0, rect.w, rect.h }); };
 	virtual void Clear(const Region& rgn) = 0;
+	// shifts the contents by delta, leaving the uncovered parts undefined; false if unsupported
+	virtual bool Scroll(const Point& /*delta*/) { return false; }
 	// CopyPixels takes at least one void* buffer with implied pitch of Region.w, otherwise alternating pairs of buffers and their corresponding pitches
 	virtual void CopyPixels(const Region& bufDest, const void* pixelBuf, const int* pitch = NULL, ...) = 0;
 
@@ -83,6 +86,13 @@ public:
 		YV12 // YUV format for BIK videos
 	};
 
+	// one entry of a BlitGameSprites batch
+	struct GameSpriteBlit {
+		Holder<Sprite2D> spr;
+		Point p;
+		BlitFlags flags;
+	};
+
 protected:
 	tick_t lastTime = 0;
 	EventMgr* EvntManager = nullptr;
@@ -171,6 +181,9 @@ public:
 	virtual void BlitGameSprite(const Holder<Sprite2D>& spr, const Point& p,
 				    BlitFlags flags, Color tint = Color()) = 0;
 
+	/** Blits the sprites in order, all with the same tint. Drivers can avoid the per sprite overhead */
+	virtual void BlitGameSprites(const std::vector<GameSpriteBlit>& blits, Color tint = Color());
+
 	void BlitGameSpriteWithPalette(const Holder<Sprite2D>& spr, const Holder<Palette>& pal, const Point& p,
 				       BlitFlags flags, Color tint);
 
@@ -23,6 +23,8 @@
 #include "Logging/Logging.h"
 #include "Streams/DataStream.h"
 
+#include <algorithm>
+
 using namespace GemRB;
 
 static bool StringCompKey(const std::string& str, TableMgr::key_t key)
@@ -91,6 +93,26 @@ bool p2DAImporter::Open(std::unique_ptr<DataStream> str)
 	}
 
 	assert(rows.size() < std::numeric_limits<index_t>::max());
+
+	// the first of any duplicate names wins, like with a linear search
+	for (index_t index = 0; index < rowNames.size(); index++) {
+		if (!rowIndex.Contains(rowNames[index])) {
+			rowIndex.Set(rowNames[index], index);
+		}
+	}
+	for (index_t index = 0; index < colNames.size(); index++) {
+		if (!colIndex.Contains(colNames[index])) {
+			colIndex.Set(colNames[index], index);
+		}
+	}
+
+	maxColumns = 0;
+	for (const auto& row : rows) {
+		maxColumns = std::max(maxColumns, static_cast<index_t>(row.size()));
+	}
+	signedColumns.resize(maxColumns);
+	unsignedColumns.resize(maxColumns);
+	valueIndexes.resize(maxColumns);
 	return true;
 }
 
@@ -134,24 +156,74 @@ const std::string& p2DAImporter::QueryDefault() const
 	return defVal;
 }
 
-p2DAImporter::index_t p2DAImporter::GetRowIndex(const key_t& key) const
+// columns past the widest row only ever hold the default, so they aren't cached
+const std::vector<p2DAImporter::SignedCell>& p2DAImporter::GetSignedColumn(index_t column) const
 {
-	for (index_t index = 0; index < rowNames.size(); index++) {
-		if (StringCompKey(rowNames[index], key)) {
-			return index;
+	auto& cells = signedColumns[column];
+	if (cells.empty() && !rows.empty()) {
+		cells.resize(rows.size());
+		for (index_t row = 0; row < rows.size(); row++) {
+			cells[row].valid = valid_signednumber(QueryField(row, column).c_str(), cells[row].value);
 		}
 	}
-	return npos;
+	return cells;
 }
 
-p2DAImporter::index_t p2DAImporter::GetColumnIndex(const key_t& key) const
+const std::vector<unsigned long>& p2DAImporter::GetUnsignedColumn(index_t column) const
 {
-	for (index_t index = 0; index < colNames.size(); index++) {
-		if (StringCompKey(colNames[index], key)) {
-			return index;
+	auto& cells = unsignedColumns[column];
+	if (cells.empty() && !rows.empty()) {
+		cells.resize(rows.size());
+		for (index_t row = 0; row < rows.size(); row++) {
+			cells[row] = strtoul(QueryField(row, column).c_str(), nullptr, 0);
 		}
 	}
-	return npos;
+	return cells;
+}
+
+const p2DAImporter::ValueIndex& p2DAImporter::GetValueIndex(index_t column) const
+{
+	auto& index = valueIndexes[column];
+	if (!index.built) {
+		for (index_t row = 0; row < rows.size(); row++) {
+			const std::string& value = QueryField(row, column);
+			const index_t* list = index.lists.Get(value);
+			if (list) {
+				index.rows[*list].push_back(row);
+			} else {
+				index.lists.Set(value, static_cast<index_t>(index.rows.size()));
+				index.rows.push_back({ row });
+			}
+		}
+		index.built = true;
+	}
+	return index;
+}
+
+long p2DAImporter::QueryFieldLong(index_t row, index_t column) const
+{
+	if (row >= rows.size() || column >= maxColumns) {
+		return TableMgr::QueryFieldLong(row, column);
+	}
+	return GetSignedColumn(column)[row].value;
+}
+
+unsigned long p2DAImporter::QueryFieldULong(index_t row, index_t column) const
+{
+	if (row >= rows.size() || column >= maxColumns) {
+		return TableMgr::QueryFieldULong(row, column);
+	}
+	return GetUnsignedColumn(column)[row];
+}
+
+p2DAImporter::index_t p2DAImporter::GetRowIndex(const key_t& key) const
+{
+	return rowIndex.Get(key, npos);
+}
+
+p2DAImporter::index_t p2DAImporter::GetColumnIndex(const key_t& key) const
+{
+	return colIndex.Get(key, npos);
 }
 
 const static std::string blank;
@@ -174,10 +246,18 @@ const std::string& p2DAImporter::GetRowName(index_t index) const
 p2DAImporter::index_t p2DAImporter::FindTableValue(index_t col, long val, index_t start) const
 {
 	index_t max = GetRowCount();
-	for (index_t row = start; row < max; row++) {
-		const std::string& ret = QueryField(row, col);
+	if (col >= maxColumns) {
+		// only the default is left
 		long Value;
-		if (valid_signednumber(ret.c_str(), Value) && (Value == val))
+		if (start < max && valid_signednumber(defVal.c_str(), Value) && Value == val) {
+			return start;
+		}
+		return npos;
+	}
+
+	const auto& cells = GetSignedColumn(col);
+	for (index_t row = start; row < max; row++) {
+		if (cells[row].valid && cells[row].value == val)
 			return row;
 	}
 	return npos;
@@ -186,12 +266,24 @@ p2DAImporter::index_t p2DAImporter::FindTableValue(index_t col, long val, index_
 p2DAImporter::index_t p2DAImporter::FindTableValue(index_t col, const key_t& val, index_t start) const
 {
 	index_t max = GetRowCount();
-	for (index_t row = start; row < max; row++) {
-		const std::string& ret = QueryField(row, col);
-		if (StringCompKey(ret, val))
-			return row;
+	if (col >= maxColumns) {
+		if (start < max && StringCompKey(defVal, val)) {
+			return start;
+		}
+		return npos;
 	}
-	return npos;
+
+	const ValueIndex& index = GetValueIndex(col);
+	const index_t* list = index.lists.Get(val);
+	if (!list) {
+		return npos;
+	}
+	const auto& matches = index.rows[*list];
+	auto row = std::lower_bound(matches.begin(), matches.end(), start);
+	if (row == matches.end()) {
+		return npos;
+	}
+	return *row;
 }
 
 p2DAImporter::index_t p2DAImporter::FindTableValue(const key_t& col, long val, index_t start) const
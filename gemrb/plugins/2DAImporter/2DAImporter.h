@@ -23,6 +23,8 @@
 
 #include "TableMgr.h"
 
+#include "Strings/StringMap.h"
+
 #include <vector>
 
 namespace GemRB {
@@ -37,6 +39,29 @@ private:
 	std::vector<row_t> rows;
 	std::string defVal;
 
+	// case insensitive name lookups, built on load
+	StringMap<index_t> rowIndex;
+	StringMap<index_t> colIndex;
+	index_t maxColumns = 0;
+
+	struct SignedCell {
+		long value;
+		bool valid; // false if the field isn't a number at all
+	};
+	// per column views, parsed on first use, since most columns are never queried as numbers
+	mutable std::vector<std::vector<SignedCell>> signedColumns;
+	mutable std::vector<std::vector<unsigned long>> unsignedColumns;
+	struct ValueIndex {
+		StringMap<index_t> lists; // field value -> index into rows
+		std::vector<std::vector<index_t>> rows; // ascending rows with that value
+		bool built = false;
+	};
+	mutable std::vector<ValueIndex> valueIndexes;
+
+	const std::vector<SignedCell>& GetSignedColumn(index_t column) const;
+	const std::vector<unsigned long>& GetUnsignedColumn(index_t column) const;
+	const ValueIndex& GetValueIndex(index_t column) const;
+
 public:
 	static index_t npos;
 
@@ -53,6 +78,10 @@ public:
 		if it cannot return a value, it returns the default */
 	const std::string& QueryField(index_t row, index_t column) const override;
 	const std::string& QueryDefault() const override;
+	using TableMgr::QueryFieldLong;
+	using TableMgr::QueryFieldULong;
+	long QueryFieldLong(index_t row, index_t column) const override;
+	unsigned long QueryFieldULong(index_t row, index_t column) const override;
 
 	index_t GetRowIndex(const key_t& string) const override;
 	index_t GetColumnIndex(const key_t& string) const override;
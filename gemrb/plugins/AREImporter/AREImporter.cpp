@@ -313,24 +313,14 @@ bool AREImporter::Import(DataStream* str)
 	// It's 1 byte, so setting it to 128 you'll have the same as the default of 0
 	str->ReadWord(WUnknown);
 
-	AreaDifficulty = 0;
+	DifficultyLevels[0] = DifficultyLevels[1] = 0;
 	if (bigheader) {
-		// are9.1 difficulty bits for level2/level3
+		// are9.1 difficulty bits for level2/level3, resolved against the party in GetMap
 		// ar4000 for example has a bunch of actors for all area difficulty levels, so these here are likely just the allowed levels
-		AreaDifficulty = 1;
-		ieByte tmp = 0;
-		int avgPartyLevel = core->GetGame()->GetTotalPartyLevel(false) / core->GetGame()->GetPartySize(false);
-		str->Read(&tmp, 1); // 0x54
-		if (tmp && avgPartyLevel >= tmp) {
-			AreaDifficulty = 2;
-		}
-		tmp = 0;
-		str->Read(&tmp, 1); // 0x55
-		if (tmp && avgPartyLevel >= tmp) {
-			AreaDifficulty = 4;
-		}
+		str->Read(&DifficultyLevels[0], 1); // 0x54
+		str->Read(&DifficultyLevels[1], 1); // 0x55
 		// 0x56 held the average party level at load time (usually 1, since it had no access yet),
-		// but we resolve everything here and store AreaDifficulty instead
+		// but we resolve everything on load and store AreaDifficulty instead
 	}
 	//bigheader gap is here
 	str->Seek(0x54 + bigheader, GEM_STREAM_START);
@@ -1440,6 +1430,61 @@ void AREImporter::GetTile(DataStream* str, Map* map) const
 	map->TMap->AddTile(tileID, tileName, tileFlags, nullptr, 0, nullptr, 0);
 }
 
+// not done in Import, which the resource prefetcher also runs on its worker
+ieByte AREImporter::GetAreaDifficulty() const
+{
+	if (!bigheader) return 0;
+
+	ieByte difficulty = 1;
+	int avgPartyLevel = core->GetGame()->GetTotalPartyLevel(false) / core->GetGame()->GetPartySize(false);
+	if (DifficultyLevels[0] && avgPartyLevel >= DifficultyLevels[0]) {
+		difficulty = 2;
+	}
+	if (DifficultyLevels[1] && avgPartyLevel >= DifficultyLevels[1]) {
+		difficulty = 4;
+	}
+	return difficulty;
+}
+
+void AREImporter::ListResources(std::vector<std::pair<ResRef, SClass_ID>>& resources) const
+{
+	ResRef tmpResRef;
+
+	// the main tileset normally shares its name with the WED
+	resources.emplace_back(WEDResRef, IE_WED_CLASS_ID);
+	resources.emplace_back(WEDResRef, IE_TIS_CLASS_ID);
+	resources.emplace_back(WEDResRef, IE_MOS_CLASS_ID);
+	for (const char* suffix : { "LM", "SR", "HT" }) {
+		tmpResRef.Format("{:.6}{}", WEDResRef, suffix);
+		resources.emplace_back(tmpResRef, IE_BMP_CLASS_ID);
+	}
+	if (AreaFlags & AT_EXTENDED_NIGHT) {
+		tmpResRef.Format("{:.7}N", WEDResRef);
+		resources.emplace_back(tmpResRef, IE_WED_CLASS_ID);
+		resources.emplace_back(tmpResRef, IE_TIS_CLASS_ID);
+		resources.emplace_back(tmpResRef, IE_MOS_CLASS_ID);
+		tmpResRef.Format("{:.6}LN", WEDResRef);
+		resources.emplace_back(tmpResRef, IE_BMP_CLASS_ID);
+	}
+	if (!Script.IsEmpty()) {
+		resources.emplace_back(Script, IE_BCS_CLASS_ID);
+	}
+
+	// only the creatures that aren't embedded in the area
+	for (ieDword i = 0; i < ActorCount; i++) {
+		ieDword flags;
+		ieDword creOffset;
+		ResRef creResRef;
+		str->Seek(ActorOffset + i * 0x110 + 0x28, GEM_STREAM_START);
+		str->ReadDword(flags);
+		str->Seek(ActorOffset + i * 0x110 + 0x80, GEM_STREAM_START);
+		str->ReadResRef(creResRef);
+		str->ReadDword(creOffset);
+		if (creOffset != 0 && !(flags & AF_CRE_NOT_LOADED)) continue;
+		resources.emplace_back(creResRef, IE_CRE_CLASS_ID);
+	}
+}
+
 Map* AREImporter::GetMap(const ResRef& resRef, bool day_or_night)
 {
 	// if this area does not have extended night, force it to day mode
@@ -1490,7 +1535,7 @@ Map* AREImporter::GetMap(const ResRef& resRef, bool day_or_night)
 	map->Lightning = WLightning;
 	map->AreaType = AreaType;
 	map->DayNight = day_or_night;
-	map->AreaDifficulty = AreaDifficulty;
+	map->AreaDifficulty = GetAreaDifficulty();
 	map->WEDResRef = WEDResRef;
 	map->Dream[0] = Dream1;
 	map->Dream[1] = Dream2;
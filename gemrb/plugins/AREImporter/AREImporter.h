@@ -57,18 +57,20 @@ private:
 	ResRef Script;
 	ResRef Dream1; // only in ToB
 	ResRef Dream2; // only in ToB
-	ieByte AreaDifficulty = 0;
+	ieByte DifficultyLevels[2] {}; // minimum party levels for the harder actors
 
 public:
 	AREImporter() noexcept = default;
 	bool Import(DataStream* stream) override;
 	bool ChangeMap(Map* map, bool day_or_night) override;
 	Map* GetMap(const ResRef& resRef, bool day_or_night) override;
+	void ListResources(std::vector<std::pair<ResRef, SClass_ID>>& resources) const override;
 	int GetStoredFileSize(Map* map) override;
 	/* stores an area in the Cache (swaps it out) */
 	int PutArea(DataStream* stream, const Map* map) const override;
 
 private:
+	ieByte GetAreaDifficulty() const;
 	ieWord SavedAmbientCount(const Map*) const;
 	void AdjustPSTFlags(AreaAnimation&) const;
 	void ReadEffects(DataStream* ds, EffectQueue* fx, ieDword EffectsCount) const;
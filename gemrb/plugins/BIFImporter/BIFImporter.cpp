@@ -32,8 +32,13 @@
 	#include "Streams/MappedFileMemoryStream.h"
 #endif
 
+#include <mutex>
+
 using namespace GemRB;
 
+// the resource prefetcher opens archives on its worker, so only one may write the cached copy
+static std::mutex cacheMutex;
+
 BIFImporter::~BIFImporter(void)
 {
 	delete stream;
@@ -89,7 +94,8 @@ DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const path_t& /*p
 	compressed->ReadDword(declen);
 	compressed->ReadDword(complen);
 	Log(MESSAGE, "BIFImporter", "Decompressing {} ...", compressed->filename);
-	return CacheCompressedStream(compressed, std::string(compressed->filename), complen);
+	// the caller already checked the cached copy, so whatever is there is outdated
+	return CacheCompressedStream(compressed, std::string(compressed->filename), complen, true);
 }
 
 int BIFImporter::OpenArchive(const path_t& path)
@@ -99,19 +105,16 @@ int BIFImporter::OpenArchive(const path_t& path)
 
 	path_t cachePath = PathJoin(core->config.CachePath, ExtractFileFromPath(path));
 	char Signature[8];
-#if defined(SUPPORTS_MEMSTREAM)
-	auto cacheStream = new MappedFileMemoryStream { cachePath.c_str() };
-
-	if (!cacheStream->isOk()) {
-		delete cacheStream;
 
+	// a verified copy from an earlier decompression
+	std::unique_lock<std::mutex> cacheLock(cacheMutex);
+	stream = OpenCachedArchive(path);
+	if (!stream) {
+#if defined(SUPPORTS_MEMSTREAM)
 		auto file = new MappedFileMemoryStream { path };
 		if (!file->isOk()) {
 			delete file;
 #else
-	stream = FileStream::OpenFile(cachePath);
-
-	if (!stream) {
 		FileStream* file = FileStream::OpenFile(path);
 		if (!file) {
 #endif
@@ -125,9 +128,11 @@ int BIFImporter::OpenArchive(const path_t& path)
 		if (strncmp(Signature, "BIF V1.0", 8) == 0) {
 			stream = DecompressBIF(file, cachePath.c_str());
 			delete file;
+			if (stream) AddCachedArchive(path);
 		} else if (strncmp(Signature, "BIFCV1.0", 8) == 0) {
 			stream = DecompressBIFC(file, cachePath.c_str());
 			delete file;
+			if (stream) AddCachedArchive(path);
 		} else if (strncmp(Signature, "BIFFV1  ", 8) == 0) {
 			file->Seek(0, GEM_STREAM_START);
 			stream = file;
@@ -135,11 +140,8 @@ int BIFImporter::OpenArchive(const path_t& path)
 			delete file;
 			return GEM_ERROR;
 		}
-#if defined(SUPPORTS_MEMSTREAM)
-	} else {
-		stream = cacheStream;
-#endif
 	}
+	cacheLock.unlock();
 
 	if (!stream)
 		return GEM_ERROR;
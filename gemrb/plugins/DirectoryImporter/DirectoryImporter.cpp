@@ -18,9 +18,9 @@
 
 #include "DirectoryImporter.h"
 
+#include "Interface.h"
 #include "ResourceDesc.h"
 
-#include "Logging/Logging.h"
 #include "Streams/FileStream.h"
 #include "System/VFS.h"
 
@@ -80,20 +80,7 @@ bool CachedDirectoryImporter::Open(const path_t& dir, std::string desc)
 
 void CachedDirectoryImporter::Refresh()
 {
-	cache.clear();
-
-	DirectoryIterator it(path);
-	it.SetFlags(DirectoryIterator::Files, true);
-	if (!it)
-		return;
-
-	do {
-		const path_t name = it.GetName();
-		auto emplaceResult = cache.emplace(name);
-		if (!emplaceResult.second) {
-			Log(ERROR, "CachedDirectoryImporter", "Duplicate '{}' files in '{}' directory", name, path);
-		}
-	} while (++it);
+	cache = DirectoryIndex::Load(path, core->config.IndexDirectories);
 }
 
 static path_t ConstructFilename(StringView resname, const path_t& ext)
@@ -107,38 +94,38 @@ static path_t ConstructFilename(StringView resname, const path_t& ext)
 bool CachedDirectoryImporter::HasResource(StringView resname, SClass_ID type)
 {
 	const path_t& filename = ConstructFilename(resname, TypeExt(type));
-	return cache.find(filename) != cache.cend();
+	return !cache.Find(filename).empty();
 }
 
 bool CachedDirectoryImporter::HasResource(StringView resname, const ResourceDesc& type)
 {
 	const path_t& filename = ConstructFilename(resname, type.GetExt());
-	return cache.find(filename) != cache.cend();
+	return !cache.Find(filename).empty();
 }
 
 DataStream* CachedDirectoryImporter::GetResource(StringView resname, SClass_ID type)
 {
 	const path_t& filename = ConstructFilename(resname, TypeExt(type));
-	const auto lookup = cache.find(filename);
+	const StringView lookup = cache.Find(filename);
 
-	if (lookup == cache.cend())
+	if (lookup.empty())
 		return nullptr;
 
 	path_t buf = path;
-	PathAppend(buf, *lookup);
+	PathAppend(buf, path_t(lookup.c_str(), lookup.length()));
 	return FileStream::OpenFile(buf);
 }
 
 DataStream* CachedDirectoryImporter::GetResource(StringView resname, const ResourceDesc& type)
 {
 	const path_t& filename = ConstructFilename(resname, type.GetExt());
-	const auto lookup = cache.find(filename);
+	const StringView lookup = cache.Find(filename);
 
-	if (lookup == cache.cend())
+	if (lookup.empty())
 		return nullptr;
 
 	path_t buf = path;
-	PathAppend(buf, *lookup);
+	PathAppend(buf, path_t(lookup.c_str(), lookup.length()));
 	return FileStream::OpenFile(buf);
 }
 
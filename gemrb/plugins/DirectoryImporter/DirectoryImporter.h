@@ -19,13 +19,11 @@
 #ifndef DIRIMP_H
 #define DIRIMP_H
 
+#include "DirectoryIndex.h"
 #include "ResourceSource.h"
 
-#include "Strings/CString.h"
 #include "System/VFS.h"
 
-#include <set>
-
 namespace GemRB {
 
 class ResourceDesc;
@@ -43,12 +41,13 @@ public:
 	/** returns resource */
 	DataStream* GetResource(StringView resname, SClass_ID type) override;
 	DataStream* GetResource(StringView resname, const ResourceDesc& type) override;
+	bool IsIndexed() const override { return false; }
 };
 
 class CachedDirectoryImporter : public DirectoryImporter {
 protected:
-	// the case is case insensitive, but we will only store valid names
-	std::set<path_t, CstrLessCI> cache;
+	// the lookup is case insensitive, but we will only store valid names
+	DirectoryIndex cache;
 
 public:
 	CachedDirectoryImporter() noexcept = default;
@@ -60,6 +59,7 @@ public:
 	/** returns resource */
 	DataStream* GetResource(StringView resname, SClass_ID type) override;
 	DataStream* GetResource(StringView resname, const ResourceDesc& type) override;
+	bool IsIndexed() const override { return true; }
 };
 
 
@@ -5612,6 +5612,9 @@ int fx_local_variable(Scriptable* /*Owner*/, Actor* target, Effect* fx)
 	//this is a hack, the variable name spreads across the resources
 	// print( "fx_local_variable (%2d) %s=%d", fx->Opcode, fx->Resource, fx->Parameter1 );
 	target->locals[fx->VariableName] = fx->Parameter1;
+	// creatures can also be loaded outside of a game
+	Game* game = core->GetGame();
+	if (game) game->VariablesChanged();
 	//local variable effects are not applied, they will be resaved though
 	return FX_NOT_APPLIED;
 }
@@ -7396,6 +7399,7 @@ int fx_modify_global_variable(Scriptable* /*Owner*/, Actor* /*target*/, Effect*
 	} else {
 		game->locals[key] = fx->Parameter1;
 	}
+	game->VariablesChanged();
 	return FX_NOT_APPLIED;
 }
 
@@ -8044,6 +8048,8 @@ int fx_modify_local_variable(Scriptable* /*Owner*/, Actor* target, Effect* fx)
 	} else {
 		target->locals[key] = fx->Parameter1;
 	}
+	Game* game = core->GetGame();
+	if (game) game->VariablesChanged();
 	return FX_NOT_APPLIED;
 }
 
@@ -1870,6 +1870,7 @@ static int fx_cutscene(Scriptable* /*Owner*/, Actor* /*target*/, Effect* /*fx*/)
 	// print("fx_cutscene(%2d)", fx->Opcode);
 	Game* game = core->GetGame();
 	game->locals["GEM_ACTIVE"] = 1;
+	game->VariablesChanged();
 	return FX_NOT_APPLIED;
 }
 
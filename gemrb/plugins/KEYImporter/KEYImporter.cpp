@@ -25,6 +25,7 @@
 
 #include "Logging/Logging.h"
 #include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
 
 using namespace GemRB;
 
@@ -160,14 +161,23 @@ bool KEYImporter::Open(const path_t& resfile, std::string desc)
 	}
 	f->Seek(ResOffset, GEM_STREAM_START);
 
+	// read the whole table at once, big keys have tens of thousands of entries
+	constexpr strpos_t entrySize = 14;
+	strpos_t tableSize = std::min<strpos_t>(ResCount * entrySize, f->Remains());
+	ResCount = ieDword(tableSize / entrySize);
+	void* table = malloc(tableSize);
+	f->Read(table, tableSize);
+	MemoryStream entries(resfile, table, tableSize);
+	resources.reserve(ResCount);
+
 	MapKey key;
 	ieDword ResLocator;
 	ieWord type;
 
 	for (unsigned int i = 0; i < ResCount; i++) {
-		f->ReadResRef(key.ref);
-		f->ReadWord(type);
-		f->ReadDword(ResLocator);
+		entries.ReadResRef(key.ref);
+		entries.ReadWord(type);
+		entries.ReadDword(ResLocator);
 		key.type = type;
 
 		// seems to be always the last entry?
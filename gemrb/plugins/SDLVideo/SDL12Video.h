@@ -123,6 +123,34 @@ public:
 		}
 	}
 
+	bool Scroll(const Point& delta) override
+	{
+		int width = rect.w - std::abs(delta.x);
+		int height = rect.h - std::abs(delta.y);
+		if (width <= 0 || height <= 0) {
+			return false;
+		}
+
+		if (SDL_MUSTLOCK(buffer)) {
+			SDL_LockSurface(buffer);
+		}
+		int bpp = buffer->format->BytesPerPixel;
+		Uint8* pixels = static_cast<Uint8*>(buffer->pixels);
+		int srcX = std::max(0, -delta.x) * bpp;
+		int dstX = std::max(0, delta.x) * bpp;
+		// go against the shift, so no row is overwritten before it is moved
+		for (int i = 0; i < height; ++i) {
+			int y = delta.y > 0 ? height - 1 - i : i;
+			Uint8* src = pixels + (y + std::max(0, -delta.y)) * buffer->pitch + srcX;
+			Uint8* dst = pixels + (y + std::max(0, delta.y)) * buffer->pitch + dstX;
+			memmove(dst, src, width * bpp);
+		}
+		if (SDL_MUSTLOCK(buffer)) {
+			SDL_UnlockSurface(buffer);
+		}
+		return true;
+	}
+
 	SDL_Surface* Surface()
 	{
 		return buffer;
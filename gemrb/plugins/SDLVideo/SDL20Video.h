@@ -77,6 +77,8 @@ class SDLTextureVideoBuffer : public VideoBuffer {
 	// this has significant memory overhead, but is much faster than dynamic allocation every frame
 	// this is also used for rendering stencils
 	SDL_Surface* conversionBuffer = nullptr;
+	// the other half of the pair Scroll swaps between
+	SDL_Texture* scrollTexture = nullptr;
 
 private:
 	static Region TextureRegion(SDL_Texture* tex, const Point& p)
@@ -106,6 +108,9 @@ public:
 	~SDLTextureVideoBuffer() override
 	{
 		SDL_DestroyTexture(texture);
+		if (scrollTexture) {
+			SDL_DestroyTexture(scrollTexture);
+		}
 		SDL_FreeSurface(conversionBuffer);
 	}
 
@@ -137,6 +142,41 @@ public:
 		return Clear(RectFromRegion(rgn));
 	}
 
+	bool Scroll(const Point& delta) override
+	{
+		int access;
+		Uint32 format;
+		SDL_QueryTexture(texture, &format, &access, nullptr, nullptr);
+		if (access != SDL_TEXTUREACCESS_TARGET) {
+			return false;
+		}
+
+		// a texture can't be copied onto itself, so copy to a second one and swap
+		if (!scrollTexture) {
+			scrollTexture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, rect.w, rect.h);
+			if (!scrollTexture) {
+				return false;
+			}
+		}
+
+		SDL_BlendMode blendMode;
+		SDL_GetTextureBlendMode(texture, &blendMode);
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+		SDL_SetRenderTarget(renderer, scrollTexture);
+		SDL_RenderSetClipRect(renderer, nullptr);
+		SDL_Rect dst = { delta.x, delta.y, rect.w, rect.h };
+		int ret = SDL_RenderCopy(renderer, texture, nullptr, &dst);
+		SDL_SetTextureBlendMode(texture, blendMode);
+		SDL_SetTextureBlendMode(scrollTexture, blendMode);
+		if (ret != 0) {
+			Log(ERROR, "SDL20Video", "{}", SDL_GetError());
+			return false;
+		}
+
+		std::swap(texture, scrollTexture);
+		return true;
+	}
+
 	bool RenderOnDisplay(void* display) const override
 	{
 		SDL_Renderer* targetRenderer = static_cast<SDL_Renderer*>(display);
@@ -21,7 +21,7 @@
 #ifndef SDL_PIXEL_ITERATOR_H
 #define SDL_PIXEL_ITERATOR_H
 
-#include "Video/Pixels.h"
+#include "Video/PixelKernels.h"
 
 namespace GemRB {
 
@@ -121,10 +121,44 @@ static void Blit(SDLPixelIterator src,
 	}
 }
 
+template<typename BLENDER>
+static bool BlitBlendedRows32(const SDLPixelIterator&, SDLPixelIterator&, const BLENDER&)
+{
+	return false;
+}
+
+// whole rows of 32bpp pixels can go through the vectorized kernels
+template<SHADER SHADE>
+static bool BlitBlendedRows32(const SDLPixelIterator& src, SDLPixelIterator& dst,
+			      const RGBBlendingPipeline<SHADE, true>& blender)
+{
+	if (!blender.IsAlphaBlend() || !RowBlender32::Supports(src.format, dst.format)) {
+		return false;
+	}
+	if (src.xdir != IPixelIterator::Forward || dst.xdir != IPixelIterator::Forward) {
+		return false;
+	}
+	assert(src.clip.size == dst.clip.size);
+
+	RowBlender32 rowBlender(SHADE, blender.GetTint(), blender.GetShift(), dst.format);
+	const uint8_t* srcRow = &*src;
+	uint8_t* dstRow = &*dst;
+	for (int y = 0; y < dst.clip.h; ++y) {
+		rowBlender(reinterpret_cast<const uint32_t*>(srcRow), reinterpret_cast<uint32_t*>(dstRow), dst.clip.w);
+		srcRow += src.pitch * src.ydir;
+		dstRow += dst.pitch * dst.ydir;
+	}
+	return true;
+}
+
 template<typename BLENDER>
 static void BlitBlendedRect(SDLPixelIterator& src, SDLPixelIterator& dst,
 			    BLENDER blender, IAlphaIterator* maskIt)
 {
+	if (!maskIt && BlitBlendedRows32(src, dst, blender)) {
+		return;
+	}
+
 	SDLPixelIterator dstend = SDLPixelIterator::end(dst);
 
 	if (maskIt) {
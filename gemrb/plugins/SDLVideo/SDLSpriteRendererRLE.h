@@ -18,6 +18,9 @@
  *
  */
 
+#include <algorithm>
+#include <type_traits>
+
 using namespace GemRB;
 
 template<bool PALALPHA>
@@ -343,6 +346,41 @@ static void BlitSpriteRLE_Partial(const Uint8* rledata, const int pitch, const R
 	}
 }
 
+// 32bpp rows without a cover, blending the literal runs of a whole sprite at once
+static void BlitSpriteRLE_Rows32(const Uint8* rledata, Uint8 transindex,
+				 SDLPixelIterator& dest, const PaletteBlender32& blend)
+{
+	const Size& size = dest.clip.size;
+	Uint8* row = &*dest;
+	int x = 0;
+	int y = 0;
+	int transQueue = 0;
+	while (y < size.h) {
+		if (transQueue > 0) {
+			int count = std::min(transQueue, size.w - x);
+			transQueue -= count;
+			x += count;
+		} else if (*rledata == transindex) {
+			transQueue = rledata[1] + 1;
+			rledata += 2;
+		} else {
+			int count = 1;
+			while (x + count < size.w && rledata[count] != transindex) {
+				++count;
+			}
+			blend(rledata, reinterpret_cast<Uint32*>(row) + x, count);
+			rledata += count;
+			x += count;
+		}
+
+		if (x == size.w) {
+			x = 0;
+			++y;
+			row += dest.pitch * dest.ydir;
+		}
+	}
+}
+
 template<typename Blender, typename Tinter>
 static void BlitSpriteRLE(Holder<Sprite2D> spr, const Region& srect,
 			  SDL_Surface* dst, const Region& drect,
@@ -361,6 +399,14 @@ static void BlitSpriteRLE(Holder<Sprite2D> spr, const Region& srect,
 	const Uint8* rledata = (const Uint8*) spr->LockSprite();
 	uint8_t ck = spr->GetColorKey();
 
+	// the tint only depends on the color, so apply it to the palette instead of every pixel
+	Color pal[256];
+	std::copy(palette->cbegin(), palette->cend(), pal);
+	for (Color& c : pal) {
+		tint(c.r, c.g, c.b, c.a, flags);
+	}
+	const SRTinter_NoTint<true> tinted;
+
 	bool partial = spr->Frame.size != srect.size;
 
 	IPixelIterator::Direction xdir = (flags & BlitFlags::MIRRORX) ? IPixelIterator::Reverse : IPixelIterator::Forward;
@@ -368,6 +414,12 @@ static void BlitSpriteRLE(Holder<Sprite2D> spr, const Region& srect,
 
 	auto dstit = MakeSDLPixelIterator(dst, xdir, ydir, drect);
 
+	if (std::is_same<Blender, SRBlender_Alpha>::value && !cover && !partial && xdir == IPixelIterator::Forward && PaletteBlender32::Supports(dstit.format)) {
+		PaletteBlender32 blend(pal, dstit.format);
+		BlitSpriteRLE_Rows32(rledata, ck, dstit, blend);
+		return;
+	}
+
 	static StaticAlphaIterator nomask(0);
 	if (cover == nullptr) {
 		cover = &nomask;
@@ -378,9 +430,9 @@ static void BlitSpriteRLE(Holder<Sprite2D> spr, const Region& srect,
 			{
 				SRBlender<Uint32, Blender> blend(dstit.format);
 				if (partial) {
-					BlitSpriteRLE_Partial<Uint32>(rledata, spr->Frame.w, srect, palette->col, ck, dstit, *cover, flags, tint, blend);
+					BlitSpriteRLE_Partial<Uint32>(rledata, spr->Frame.w, srect, pal, ck, dstit, *cover, flags, tinted, blend);
 				} else {
-					BlitSpriteRLE_Total<Uint32>(rledata, palette->col, ck, dstit, *cover, flags, tint, blend);
+					BlitSpriteRLE_Total<Uint32>(rledata, pal, ck, dstit, *cover, flags, tinted, blend);
 				}
 				break;
 			}
@@ -388,9 +440,9 @@ static void BlitSpriteRLE(Holder<Sprite2D> spr, const Region& srect,
 			{
 				SRBlender<Uint16, Blender> blend(dstit.format);
 				if (partial) {
-					BlitSpriteRLE_Partial<Uint16>(rledata, spr->Frame.w, srect, palette->col, ck, dstit, *cover, flags, tint, blend);
+					BlitSpriteRLE_Partial<Uint16>(rledata, spr->Frame.w, srect, pal, ck, dstit, *cover, flags, tinted, blend);
 				} else {
-					BlitSpriteRLE_Total<Uint16>(rledata, palette->col, ck, dstit, *cover, flags, tint, blend);
+					BlitSpriteRLE_Total<Uint16>(rledata, pal, ck, dstit, *cover, flags, tinted, blend);
 				}
 				break;
 			}
@@ -292,6 +292,23 @@ void SDLVideoDriver::BlitGameSprite(const Holder<Sprite2D>& spr, const Point& p,
 	BlitSpriteClipped(spr, std::move(srect), drect, flags, &tint);
 }
 
+void SDLVideoDriver::BlitGameSprites(const std::vector<GameSpriteBlit>& blits, Color tint)
+{
+	if (blits.empty()) return;
+
+	// the clip is the same for the whole batch, so reject what is fully outside it early
+	const Region clip = CurrentRenderClip();
+	for (const auto& blit : blits) {
+		if (!blit.spr) continue;
+
+		const Region& frame = blit.spr->Frame;
+		Region drect(blit.p - frame.origin, frame.size);
+		if (!clip.IntersectsRegion(drect)) continue;
+
+		BlitSpriteClipped(blit.spr, Region(Point(0, 0), frame.size), drect, blit.flags, &tint);
+	}
+}
+
 Region SDLVideoDriver::CurrentRenderClip() const
 {
 	Region bufferRegion(Point(), drawingBuffer->Size());
@@ -71,6 +71,7 @@ public:
 	void BlitSprite(const Holder<Sprite2D>& spr, const Region& src, Region dst,
 			BlitFlags flags, Color tint = Color()) override;
 	void BlitGameSprite(const Holder<Sprite2D>& spr, const Point& p, BlitFlags flags, Color tint = Color()) override;
+	void BlitGameSprites(const std::vector<GameSpriteBlit>& blits, Color tint = Color()) override;
 	int GetDisplayRefreshRate() const override { return refreshRate; }
 	int GetVirtualRefreshCap() const override { return 0; }
 
@@ -31,6 +31,7 @@
 #include "GUI/GameControl.h"
 #include "Logging/Logging.h"
 #include "Scriptable/Actor.h"
+#include "Streams/MemoryStream.h"
 
 #include <tuple>
 #include <utility>
@@ -95,6 +96,15 @@ bool TLKImporter::Open(DataStream* stream)
 	}
 	delete str;
 	str = stream;
+	decoded.Clear();
+	data = nullptr;
+	dataSize = 0;
+	const auto* mem = dynamic_cast<const MemoryStream*>(stream);
+	if (mem) {
+		data = mem->GetBuffer();
+		dataSize = mem->Size();
+	}
+
 	char Signature[8];
 	str->Read(Signature, 8);
 	if (strncmp(Signature, "TLK\x20V1\x20\x20", 8) != 0) {
@@ -335,6 +345,73 @@ ieStrRef TLKImporter::UpdateString(ieStrRef strref, const String& newvalue)
 	return OverrideTLK->UpdateString(strref, newvalue);
 }
 
+static ieWord ReadLEWord(const char* src)
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(src);
+	return ieWord(bytes[0] | bytes[1] << 8);
+}
+
+static ieDword ReadLEDword(const char* src)
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(src);
+	return ieDword(bytes[0]) | ieDword(bytes[1]) << 8 | ieDword(bytes[2]) << 16 | ieDword(bytes[3]) << 24;
+}
+
+bool TLKImporter::ReadEntry(ieStrRef strref, TLKEntry& entry)
+{
+	strpos_t pos = 18 + (ieDword(strref) * 0x1A);
+	if (!data) {
+		if (str->Seek(pos, GEM_STREAM_START) == GEM_ERROR) {
+			return false;
+		}
+		ieDword volume, pitch;
+		str->ReadWord(entry.type);
+		str->ReadResRef(entry.soundRef);
+		// volume and pitch variance fields are known to be unused at minimum in bg1
+		str->ReadDword(volume);
+		str->ReadDword(pitch);
+		str->ReadDword(entry.offset);
+		str->ReadDword(entry.length);
+		return true;
+	}
+
+	if (pos + 0x1A > dataSize) {
+		return false;
+	}
+	const char* header = data + pos;
+	entry.type = ReadLEWord(header);
+	entry.soundRef = ResRef(header + 2, 8);
+	RTrim(entry.soundRef);
+	entry.offset = ReadLEDword(header + 18);
+	entry.length = ReadLEDword(header + 22);
+	return true;
+}
+
+String TLKImporter::DecodeEntry(const TLKEntry& entry)
+{
+	if (!(entry.type & 1)) {
+		return u"";
+	}
+
+	strpos_t pos = entry.offset + Offset;
+	if (!data) {
+		if (str->Seek(pos, GEM_STREAM_START) == GEM_ERROR) {
+			return u"";
+		}
+		std::string mbstr(entry.length, '\0');
+		str->Read(&mbstr[0], entry.length);
+		return StringFromTLK(mbstr);
+	}
+
+	if (pos >= dataSize) {
+		return u"";
+	}
+	// like a short read, which leaves the rest zeroed
+	std::string mbstr(entry.length, '\0');
+	memcpy(&mbstr[0], data + pos, std::min<strpos_t>(entry.length, dataSize - pos));
+	return StringFromTLK(mbstr);
+}
+
 String TLKImporter::GetString(ieStrRef strref, STRING_FLAGS flags)
 {
 	String string;
@@ -352,30 +429,22 @@ String TLKImporter::GetString(ieStrRef strref, STRING_FLAGS flags)
 		type = 0;
 		SoundResRef.Reset();
 	} else {
-		ieDword Volume, Pitch, StrOffset;
-		ieDword l;
-		if (str->Seek(18 + (ieDword(strref) * 0x1A), GEM_STREAM_START) == GEM_ERROR) {
-			return u"";
-		}
-		str->ReadWord(type);
-		str->ReadResRef(SoundResRef);
-		// volume and pitch variance fields are known to be unused at minimum in bg1
-		str->ReadDword(Volume);
-		str->ReadDword(Pitch);
-		str->ReadDword(StrOffset);
-		str->ReadDword(l);
-
-		if (l == 0) {
-			return u"";
-		}
-
-		if (type & 1) {
-			if (str->Seek(StrOffset + Offset, GEM_STREAM_START) == GEM_ERROR) {
+		const DecodedString* cached = decoded.LookupAndTouch(ieDword(strref));
+		if (cached) {
+			string = cached->text;
+			type = cached->type;
+			SoundResRef = cached->soundRef;
+		} else {
+			TLKEntry entry;
+			if (!ReadEntry(strref, entry) || entry.length == 0) {
 				return u"";
 			}
-			std::string mbstr(l, '\0');
-			str->Read(&mbstr[0], l);
-			string = StringFromTLK(mbstr);
+			string = DecodeEntry(entry);
+			type = entry.type;
+			SoundResRef = entry.soundRef;
+			if (!(type & 4)) {
+				decoded.SetAt(ieDword(strref), string, entry);
+			}
 		}
 	}
 
@@ -417,14 +486,11 @@ StringBlock TLKImporter::GetStringBlock(ieStrRef strref, STRING_FLAGS flags)
 	if (empty) {
 		return StringBlock();
 	}
-	ieWord type;
-	if (str->Seek(18 + (ieDword(strref) * 0x1A), GEM_STREAM_START) == GEM_ERROR) {
+	TLKEntry entry;
+	if (!ReadEntry(strref, entry)) {
 		return StringBlock();
 	}
-	str->ReadWord(type);
-	ResRef soundRef;
-	str->ReadResRef(soundRef);
-	return StringBlock(GetString(strref, flags), soundRef);
+	return StringBlock(GetString(strref, flags), entry.soundRef);
 }
 
 #include "plugindef.h"
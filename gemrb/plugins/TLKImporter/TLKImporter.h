@@ -23,6 +23,7 @@
 
 #include "ie_types.h"
 
+#include "LRUCache.h"
 #include "StringMgr.h"
 #include "TlkOverride.h"
 
@@ -34,9 +35,42 @@ struct gt_type {
 	ieStrRef female;
 };
 
+struct TLKEntry {
+	ieWord type = 0;
+	ResRef soundRef;
+	ieDword offset = 0;
+	ieDword length = 0;
+};
+
+// text of a dialog.tlk entry, before any tag resolution
+struct DecodedString {
+	String text;
+	ieWord type = 0;
+	ResRef soundRef;
+
+	DecodedString(String text, const TLKEntry& entry)
+		: text(std::move(text)), type(entry.type), soundRef(entry.soundRef)
+	{}
+
+	void evictionNotice() const { /* No need. */ }
+};
+
+struct AlwaysEvict {
+	bool operator()(const DecodedString&) const
+	{
+		return true;
+	}
+};
+
 class TLKImporter : public StringMgr {
 private:
 	DataStream* str = nullptr;
+	// the file contents, if the stream is in memory (usually mapped)
+	const char* data = nullptr;
+	strpos_t dataSize = 0;
+	// only the immutable dialog.tlk entries without tags are cached, the
+	// override strings may be rewritten at any time by either of the tlk importers
+	LRUCache<DecodedString, AlwaysEvict, ieDword> decoded { 2048 };
 
 	//Data
 	ieWord Language = 0;
@@ -64,6 +98,8 @@ public:
 	ieStrRef GetNextStrRef() const final { return OverrideTLK->GetNextStrRef(); };
 
 private:
+	bool ReadEntry(ieStrRef strref, TLKEntry& entry);
+	String DecodeEntry(const TLKEntry& entry);
 	/** resolves day and monthname tokens */
 	void GetMonthName(int dayandmonth);
 	String ResolveTags(const String& source);
@@ -86,7 +86,7 @@ int ZLibManager::Decompress(DataStream* dest, DataStream* source, unsigned int s
 	}
 }
 
-int ZLibManager::Compress(DataStream* dest, DataStream* source) const
+int ZLibManager::Compress(DataStream* dest, DataStream* source, Level level) const
 {
 	unsigned char bufferin[INPUTSIZE];
 	unsigned char bufferout[OUTPUTSIZE];
@@ -96,7 +96,7 @@ int ZLibManager::Compress(DataStream* dest, DataStream* source) const
 	stream.zfree = Z_NULL;
 	stream.opaque = Z_NULL;
 
-	int result = deflateInit(&stream, Z_BEST_COMPRESSION);
+	int result = deflateInit(&stream, level == Level::Fast ? Z_BEST_SPEED : Z_BEST_COMPRESSION);
 	if (result != Z_OK) {
 		return GEM_ERROR;
 	}
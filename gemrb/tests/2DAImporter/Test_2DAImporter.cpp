@@ -27,6 +27,9 @@ namespace GemRB {
 static const path_t SAMPLE_FILE = PathJoin("tests", "resources", "2DAImporter", "sample.2da");
 static const path_t ENC_SAMPLE_FILE = PathJoin("tests", "resources", "2DAImporter", "sample_encrypted.2da");
 static const path_t SAMPLE_FILE2 = PathJoin("tests", "resources", "2DAImporter", "sample2.2da");
+// real rule tables
+static const path_t SPLPROT_FILE = PathJoin(UNHARDCODED_PATH, "shared", "splprot.2da");
+static const path_t CLSKILLS_FILE = PathJoin(UNHARDCODED_PATH, "bg2", "clskills.2da");
 
 class p2DAImporterTest : public testing::TestWithParam<path_t> {
 protected:
@@ -123,6 +126,32 @@ TEST_P(p2DAImporterTest, FindTableValueByLong)
 	EXPECT_EQ(unit.FindTableValue(4, 17, 0), p2DAImporter::npos);
 }
 
+TEST_P(p2DAImporterTest, QueryFieldNumbers)
+{
+	EXPECT_EQ(unit.QueryFieldSigned<int>(0, 0), 11975);
+	EXPECT_EQ(unit.QueryFieldSigned<int>("DEXTERITY", "CAP_REF"), 1151);
+	EXPECT_EQ(unit.QueryFieldSigned<int>(6, 3), -1);
+	EXPECT_EQ(unit.QueryFieldSigned<int8_t>(0, 0), 127);
+	EXPECT_EQ(unit.QueryFieldSigned<int>(0, 3), 0);
+	// out of range fields are the default
+	EXPECT_EQ(unit.QueryFieldSigned<int>(20, 0), -1);
+	EXPECT_EQ(unit.QueryFieldSigned<int>(0, 20), -1);
+	EXPECT_EQ(unit.QueryFieldSigned<int>("FLUFFINESS", "NAME_REF"), -1);
+
+	EXPECT_EQ(unit.QueryFieldUnsigned<ieDword>(1, 1), 9584u);
+	EXPECT_EQ(unit.QueryFieldUnsigned<ieDword>(6, 3), 0xFFFFFFFFu);
+	EXPECT_EQ(unit.QueryFieldUnsigned<ieWord>(0, 0), 11975u);
+	EXPECT_EQ(unit.QueryFieldUnsigned<uint8_t>(0, 0), 255u);
+}
+
+TEST_P(p2DAImporterTest, LookupsIgnoreCase)
+{
+	EXPECT_EQ(unit.GetRowIndex(std::string { "strength" }), 0);
+	EXPECT_EQ(unit.GetColumnIndex(std::string { "stat_id" }), 3);
+	EXPECT_EQ(unit.FindTableValue(3, std::string { "con" }, 0), 1);
+	EXPECT_EQ(unit.FindTableValue(std::string { "Stat_Id" }, std::string { "wis" }, 0), 4);
+}
+
 INSTANTIATE_TEST_SUITE_P(
 	2DAImporterInstances,
 	p2DAImporterTest,
@@ -139,4 +168,50 @@ TEST(p2DAImporterTest, GetColumnCount2)
 	EXPECT_EQ(unit.GetColumnCount(0), 1);
 }
 
+// the indexed lookups have to find what plain scans over the parsed fields find
+TEST(p2DAImporterTest, RuleTableIndexMatchesScan)
+{
+	for (const path_t& file : { SPLPROT_FILE, CLSKILLS_FILE }) {
+		p2DAImporter unit;
+		auto stream = new FileStream {};
+		ASSERT_TRUE(stream->Open(file));
+		ASSERT_TRUE(unit.Open(std::unique_ptr<DataStream> { stream }));
+
+		TableMgr::index_t rowCount = unit.GetRowCount();
+		TableMgr::index_t colCount = unit.GetColNamesCount();
+		ASSERT_GT(rowCount, 0u);
+
+		auto scanRow = [&](const std::string& name) {
+			for (TableMgr::index_t row = 0; row < rowCount; ++row) {
+				if (stricmp(unit.GetRowName(row).c_str(), name.c_str()) == 0) return row;
+			}
+			return TableMgr::npos;
+		};
+		auto scanColumn = [&](const std::string& name) {
+			for (TableMgr::index_t col = 0; col < colCount; ++col) {
+				if (stricmp(unit.GetColumnName(col).c_str(), name.c_str()) == 0) return col;
+			}
+			return TableMgr::npos;
+		};
+
+		for (TableMgr::index_t col = 0; col < colCount; ++col) {
+			EXPECT_EQ(unit.GetColumnIndex(unit.GetColumnName(col)), scanColumn(unit.GetColumnName(col)));
+		}
+		for (TableMgr::index_t row = 0; row < rowCount; ++row) {
+			EXPECT_EQ(unit.GetRowIndex(unit.GetRowName(row)), scanRow(unit.GetRowName(row)));
+			for (TableMgr::index_t col = 0; col < colCount; ++col) {
+				const char* field = unit.QueryField(row, col).c_str();
+				EXPECT_EQ(unit.QueryFieldSigned<int>(row, col), strtosigned<int>(field));
+				EXPECT_EQ(unit.QueryFieldUnsigned<ieDword>(row, col), strtounsigned<ieDword>(field));
+
+				// the named queries go through both indices
+				TableMgr::index_t r = scanRow(unit.GetRowName(row));
+				TableMgr::index_t c = scanColumn(unit.GetColumnName(col));
+				EXPECT_EQ(unit.QueryFieldUnsigned<ieDword>(unit.GetRowName(row), unit.GetColumnName(col)),
+					  strtounsigned<ieDword>(unit.QueryField(r, c).c_str()));
+			}
+		}
+	}
+}
+
 }
@@ -0,0 +1,95 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/Streams/FileStream.h"
+#include "../../plugins/2DAImporter/2DAImporter.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+
+namespace GemRB {
+
+// real rule tables
+static const path_t SPLPROT_FILE = PathJoin(UNHARDCODED_PATH, "shared", "splprot.2da");
+static const path_t CLSKILLS_FILE = PathJoin(UNHARDCODED_PATH, "bg2", "clskills.2da");
+
+// reports the time of named queries through the row and column indices and
+// through plain scans over the parsed names
+TEST(p2DAImporterBenchmark, RuleTables)
+{
+	constexpr int iterations = 200;
+
+	for (const path_t& file : { SPLPROT_FILE, CLSKILLS_FILE }) {
+		p2DAImporter unit;
+		auto stream = new FileStream {};
+		ASSERT_TRUE(stream->Open(file));
+		ASSERT_TRUE(unit.Open(std::unique_ptr<DataStream> { stream }));
+
+		TableMgr::index_t rowCount = unit.GetRowCount();
+		TableMgr::index_t colCount = unit.GetColNamesCount();
+		ASSERT_GT(rowCount, 0u);
+
+		auto scanRow = [&](const std::string& name) {
+			for (TableMgr::index_t row = 0; row < rowCount; ++row) {
+				if (stricmp(unit.GetRowName(row).c_str(), name.c_str()) == 0) return row;
+			}
+			return TableMgr::npos;
+		};
+		auto scanColumn = [&](const std::string& name) {
+			for (TableMgr::index_t col = 0; col < colCount; ++col) {
+				if (stricmp(unit.GetColumnName(col).c_str(), name.c_str()) == 0) return col;
+			}
+			return TableMgr::npos;
+		};
+
+		long scannedSum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			for (TableMgr::index_t row = 0; row < rowCount; ++row) {
+				TableMgr::index_t r = scanRow(unit.GetRowName(row));
+				for (TableMgr::index_t col = 0; col < colCount; ++col) {
+					TableMgr::index_t c = scanColumn(unit.GetColumnName(col));
+					scannedSum += strtounsigned<ieDword>(unit.QueryField(r, c).c_str());
+				}
+			}
+		}
+		auto scanned = std::chrono::steady_clock::now() - start;
+
+		long indexedSum = 0;
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			for (TableMgr::index_t row = 0; row < rowCount; ++row) {
+				for (TableMgr::index_t col = 0; col < colCount; ++col) {
+					indexedSum += unit.QueryFieldUnsigned<ieDword>(unit.GetRowName(row), unit.GetColumnName(col));
+				}
+			}
+		}
+		auto indexed = std::chrono::steady_clock::now() - start;
+		EXPECT_EQ(scannedSum, indexedSum);
+
+		using std::chrono::microseconds;
+		std::cout << file << ": " << iterations * rowCount * colCount << " named queries, scanned "
+			  << std::chrono::duration_cast<microseconds>(scanned).count() << "us, indexed "
+			  << std::chrono::duration_cast<microseconds>(indexed).count() << "us" << std::endl;
+	}
+}
+
+}
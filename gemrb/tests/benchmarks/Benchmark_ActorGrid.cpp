@@ -0,0 +1,115 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../core/DemoGameTest.h"
+
+#include "../../includes/ie_stats.h"
+
+#include "../../core/GameData.h"
+#include "../../core/Map.h"
+#include "../../core/Scriptable/Actor.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+
+namespace GemRB {
+
+class ActorGridBenchmark : public DemoGameTest {};
+
+// reports the speed of the actor grid radius and point queries and of the
+// full actor scan for a sparse and a dense crowd of 200 actors, so the cost
+// follows the neighbour count
+TEST_F(ActorGridBenchmark, Scaling)
+{
+	constexpr int actorCount = 200;
+	constexpr int rounds = 200;
+	const Size mapSize = map->GetSize();
+
+	std::vector<Actor*> crowd;
+	for (int i = 0; i < actorCount; i++) {
+		Actor* actor = gamedata->GetCreature(ResRef("rabbit"));
+		ASSERT_NE(actor, nullptr);
+		actor->SetBase(IE_EA, i % 3 ? EA_ENEMY : EA_NEUTRAL);
+		map->AddActor(actor, true);
+		crowd.push_back(actor);
+	}
+
+	std::vector<Point> probes;
+	for (int i = 0; i < 50; i++) {
+		probes.emplace_back((i * 97) % mapSize.w, (i * 61) % mapSize.h);
+	}
+
+	auto runQueries = [&]() {
+		size_t found = 0;
+		for (const Point& p : probes) {
+			found += map->GetAllActorsInRadius(p, GA_NO_LOS, 15).size();
+			found += map->GetActorInRadius(p, 0, 100) != nullptr;
+			found += map->GetActor(p, 0) != nullptr;
+			found += map->GetActorsInRect(Region(p, Size(200, 150)), 0).size();
+			found += map->AnyEnemyNearPoint(p);
+		}
+		return found;
+	};
+
+	auto measure = [&](bool enabled) {
+		map->SetActorGridEnabled(enabled);
+		size_t found = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; round++) {
+			found += runQueries();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		return std::make_pair(rounds * probes.size() * 5 / elapsed.count(), found);
+	};
+
+	// spread over the whole area first, then packed around the probes
+	for (int layout = 0; layout < 2; layout++) {
+		for (int i = 0; i < actorCount; i++) {
+			Point pos;
+			if (layout == 0) {
+				pos = Point((i * 337) % mapSize.w, (i * 211) % mapSize.h);
+			} else {
+				pos = probes[i % probes.size()] + Point((i % 5) * 16, (i % 7) * 12);
+			}
+			// moves update the grid through SetPos
+			crowd[i]->SetPosition(pos, false);
+		}
+
+		auto scan = measure(false);
+		auto grid = measure(true);
+		EXPECT_EQ(scan.second, grid.second);
+		std::cout << (layout ? "dense" : "sparse") << " crowd of " << actorCount << " actors, "
+			  << grid.second / rounds << " hits per round: " << scan.first << " queries/s scanning, "
+			  << grid.first << " queries/s with the grid" << std::endl;
+	}
+
+	map->SetActorGridEnabled(true);
+	for (Actor* actor : crowd) {
+		map->RemoveActor(actor);
+		delete actor;
+	}
+}
+
+}
+#endif
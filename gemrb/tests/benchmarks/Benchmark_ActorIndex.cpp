@@ -0,0 +1,99 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../core/DemoGameTest.h"
+
+#include "../../includes/ie_stats.h"
+
+#include "../../core/GameData.h"
+#include "../../core/GameScript/GSUtils.h"
+#include "../../core/GameScript/Matching.h"
+#include "../../core/GameScript/Targets.h"
+#include "../../core/Map.h"
+#include "../../core/Scriptable/Actor.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+
+namespace GemRB {
+
+class ActorIndexBenchmark : public DemoGameTest {};
+
+// reports the IDS object matching speed with the actor index and with the
+// full actor scan for a crowd of 100 actors
+TEST_F(ActorIndexBenchmark, TriggersPerSecond)
+{
+	constexpr int actorCount = 100;
+	constexpr int rounds = 2000;
+
+	std::vector<Actor*> crowd;
+	for (int i = 0; i < actorCount; i++) {
+		Actor* actor = gamedata->GetCreature(ResRef("rabbit"));
+		ASSERT_NE(actor, nullptr);
+		actor->SetBase(IE_EA, i % 3 ? EA_ENEMY : EA_NEUTRAL);
+		actor->SetBase(IE_CLASS, 1 + i % 12);
+		actor->SetBase(IE_RACE, 1 + i % 7);
+		actor->SetPosition(Point(700 + (i % 10) * 20, 500 + (i / 10) * 20), false);
+		map->AddActor(actor, true);
+		crowd.push_back(actor);
+	}
+
+	// ea, general, race, class, specific, gender, alignment
+	std::vector<Object> objects(4);
+	objects[0].objectFields[0] = EA_ENEMY; // [ENEMY]
+	objects[1].objectFields[0] = EA_ENEMY; // [ENEMY.0.0.MAGE]
+	objects[1].objectFields[3] = 1;
+	objects[2].objectFields[2] = 3; // [0.0.ELF]
+	objects[3].objectFields[0] = EA_EVILCUTOFF; // [EVILCUTOFF.0.0.THIEF]
+	objects[3].objectFields[3] = 4;
+
+	auto measure = [&](bool enabled) {
+		map->SetActorIndexEnabled(enabled);
+		size_t found = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; round++) {
+			for (const Object& object : objects) {
+				Targets* tgts = GetAllObjects(map, map, &object, 0);
+				if (!tgts) continue;
+				found += tgts->Count();
+				delete tgts;
+			}
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		return std::make_pair(rounds * objects.size() / elapsed.count(), found);
+	};
+	auto scan = measure(false);
+	auto index = measure(true);
+	EXPECT_EQ(scan.second, index.second);
+	std::cout << "object matching with " << map->GetActorCount(true) << " actors: "
+		  << scan.first << " triggers/s scanning, " << index.first << " triggers/s indexed" << std::endl;
+
+	for (Actor* actor : crowd) {
+		map->RemoveActor(actor);
+		delete actor;
+	}
+}
+
+}
+#endif
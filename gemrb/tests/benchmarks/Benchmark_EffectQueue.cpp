@@ -0,0 +1,96 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../core/DemoGameTest.h"
+
+#include "../../core/EffectQueue.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+
+namespace GemRB {
+
+// the opcodes come from the effect tables of the demo
+class EffectQueueBenchmark : public DemoGameTest {};
+
+// reports the speed of the opcode indexed lookups and of plain scans over a
+// synthetic queue of 500 effects
+TEST_F(EffectQueueBenchmark, Lookups)
+{
+	constexpr int effectCount = 500;
+	constexpr ieDword opcodeCount = 50;
+	constexpr int rounds = 2000;
+
+	EffectQueue queue;
+	for (int i = 0; i < effectCount; i++) {
+		Effect* fx = new Effect();
+		fx->Opcode = i % opcodeCount;
+		fx->Parameter1 = i;
+		fx->Parameter2 = i % 7;
+		fx->TimingMode = FX_DURATION_INSTANT_PERMANENT;
+		queue.AddEffect(fx, i % 5 == 0);
+	}
+
+	const EffectQueue& constQueue = queue;
+	auto scanParam = [&constQueue](ieDword opcode, ieDword param2) -> const Effect* {
+		auto f = constQueue.GetFirstEffect();
+		for (const Effect* fx = constQueue.GetNextEffect(f); fx; fx = constQueue.GetNextEffect(f)) {
+			if (fx->Opcode == opcode && fx->Parameter2 == param2) return fx;
+		}
+		return nullptr;
+	};
+	auto scanBonus = [&constQueue](ieDword opcode, ieDword param2) {
+		int sum = 0;
+		auto f = constQueue.GetFirstEffect();
+		for (const Effect* fx = constQueue.GetNextEffect(f); fx; fx = constQueue.GetNextEffect(f)) {
+			if (fx->Opcode == opcode && fx->Parameter2 == param2) sum += fx->Parameter1;
+		}
+		return sum;
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	int sink = 0;
+	for (int round = 0; round < rounds; round++) {
+		ieDword opcode = round % opcodeCount;
+		sink += scanParam(opcode, 3) != nullptr;
+		sink += scanBonus(opcode, 5);
+	}
+	std::chrono::duration<double> scanTime = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++) {
+		EffectRef ref = { "Synthetic", round % int(opcodeCount) };
+		sink -= queue.HasEffectWithParam(ref, 3) != nullptr;
+		sink -= queue.BonusForParam2(ref, 5);
+	}
+	std::chrono::duration<double> indexTime = std::chrono::steady_clock::now() - start;
+	EXPECT_EQ(sink, 0);
+
+	std::cout << "effect queue lookups with " << queue.GetEffectsCount() << " effects: "
+		  << scanTime.count() * 1e6 / rounds << " us scanning, "
+		  << indexTime.count() * 1e6 / rounds << " us indexed" << std::endl;
+}
+
+}
+#endif
@@ -0,0 +1,99 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../core/DemoGameTest.h"
+
+#include "../../core/Game.h"
+#include "../../core/Interface.h"
+#include "../../core/Map.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+
+namespace GemRB {
+
+class PathClusterBenchmark : public DemoGameTest {};
+
+// reports the expanded searchmap cells and the search latency of long routes
+// with and without the cluster graph on the biggest demo area
+TEST_F(PathClusterBenchmark, ExpansionsAndLatency)
+{
+	constexpr int circleSize = 2;
+	constexpr int rounds = 20;
+
+	Map* bigMap = core->GetGame()->GetMap(ResRef("ar0110"), false);
+	ASSERT_NE(bigMap, nullptr);
+
+	// pairs of walkable points from opposite corners of the area
+	const Size& mapSize = bigMap->tileProps.GetSize();
+	std::vector<PathRequest> requests;
+	for (int y = 0; y < mapSize.h / 3; y += 4) {
+		for (int x = 0; x < mapSize.w / 3; x += 4) {
+			SearchmapPoint near(x, y);
+			SearchmapPoint far(mapSize.w - 1 - x, mapSize.h - 1 - y);
+			if (!(bigMap->GetBlockedTile(near) & PathMapFlags::PASSABLE)) continue;
+			if (!(bigMap->GetBlockedTile(far) & PathMapFlags::PASSABLE)) continue;
+			PathRequest request;
+			request.start = near.ToNavmapPoint() + Point(8, 6);
+			request.dest = far.ToNavmapPoint() + Point(8, 6);
+			request.size = circleSize;
+			requests.push_back(request);
+		}
+	}
+	ASSERT_FALSE(requests.empty());
+
+	struct Result {
+		unsigned long expanded = 0;
+		size_t found = 0;
+		double latency = 0; // per search, in seconds
+	};
+	// one request at a time, so we time single searches and not the workers
+	auto measure = [&](bool hierarchical) {
+		bigMap->SetHierarchicalPathing(hierarchical);
+		Result result;
+		auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; round++) {
+			for (const PathRequest& request : requests) {
+				std::vector<PathRequest> single { request };
+				bigMap->FindPaths(single);
+				result.expanded += single[0].expanded;
+				result.found += bool(single[0].path);
+			}
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		result.latency = elapsed.count() / (rounds * requests.size());
+		return result;
+	};
+	Result flat = measure(false);
+	Result clusters = measure(true);
+
+	EXPECT_EQ(flat.found, clusters.found);
+	const size_t searches = rounds * requests.size();
+	std::cout << requests.size() << " long routes: " << flat.expanded / searches << " cells, "
+		  << flat.latency * 1000 << "ms flat, " << clusters.expanded / searches << " cells, "
+		  << clusters.latency * 1000 << "ms hierarchical" << std::endl;
+}
+
+}
+#endif
@@ -0,0 +1,88 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../core/DemoGameTest.h"
+
+#include "../../core/GameData.h"
+#include "../../core/GameScript/GameScript.h"
+#include "../../core/Interface.h"
+#include "../../core/Map.h"
+#include "../../core/PhaseTimer.h"
+#include "../../core/PluginMgr.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <iterator>
+
+namespace GemRB {
+
+class ScriptLoadingBenchmark : public DemoGameTest {};
+
+// times loading scripts by parsing their text and from the compiled script
+// cache, with a big script from the iwd2 override and a demo cutscene that
+// no actor keeps loaded (otherwise they would come from the script cache)
+TEST_F(ScriptLoadingBenchmark, ParsedAndCached)
+{
+	constexpr int rounds = 10;
+	const ResRef scripts[] = { ResRef("41parena"), ResRef("scene01") };
+
+	ASSERT_TRUE(gamedata->AddSource(PathJoin(core->config.GemRBPath, "override", "iwd2"), "iwd2 override", PLUGIN_RESOURCE_DIRECTORY));
+	bool cacheScripts = core->config.CacheScripts;
+
+	auto load = [&]() {
+		for (const ResRef& ref : scripts) {
+			GameScript script(ref, map);
+		}
+	};
+
+	PhaseTimer timer("script loading");
+	timer.Begin("parse");
+	core->config.CacheScripts = false;
+	for (int round = 0; round < rounds; round++) {
+		load();
+	}
+	// stored in the background, unless an earlier run already did it
+	timer.Begin("parse and store");
+	core->config.CacheScripts = true;
+	load();
+	core->cacheWriter.WaitAll();
+	timer.Begin("cached");
+	for (int round = 0; round < rounds; round++) {
+		load();
+	}
+	timer.Stop();
+	timer.Report("");
+	core->config.CacheScripts = cacheScripts;
+
+	const auto& phases = timer.GetPhases();
+	ASSERT_EQ(phases.size(), 3u);
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+	std::cout << "loading " << std::size(scripts) << " scripts: "
+		  << Milliseconds(phases[0].duration).count() / rounds << "ms parsed, "
+		  << Milliseconds(phases[1].duration).count() << "ms parsed and stored, "
+		  << Milliseconds(phases[2].duration).count() / rounds << "ms cached" << std::endl;
+}
+
+}
+#endif
@@ -0,0 +1,78 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "DemoGameTest.h"
+
+#include "../../core/Game.h"
+#include "../../core/GameData.h"
+#include "../../core/Interface.h"
+#include "../../core/InterfaceConfig.h"
+#include "../../core/Logging/Loggers/Stdio.h"
+#include "../../core/Logging/Logging.h"
+#include "../../core/PluginMgr.h"
+#include "../../core/SaveGameMgr.h"
+
+namespace GemRB {
+
+static Interface* gemrb = nullptr;
+Map* DemoGameTest::map = nullptr;
+
+class DemoGameEnvironment : public testing::Environment {
+public:
+	void TearDown() override
+	{
+		if (!gemrb) return;
+		// cleanup to prevent a delay and crash on exit
+		delete core->GetGame();
+		core->SetGame(nullptr);
+		VideoDriver.reset();
+		delete gemrb;
+		gemrb = nullptr;
+	}
+};
+
+static const testing::Environment* const demoGameEnvironment = testing::AddGlobalTestEnvironment(new DemoGameEnvironment());
+
+// set up core and the first map from the demo
+void DemoGameTest::SetUpTestSuite()
+{
+	if (gemrb) return;
+
+	setlocale(LC_ALL, "");
+	const char* argv[] = { "tester", "-c", "../../tester.cfg" };
+	auto cfg = LoadFromArgs(3, const_cast<char**>(argv));
+	ToggleLogging(true);
+	AddLogWriter(createStdioLogWriter());
+	gemrb = new Interface(std::move(cfg));
+
+	auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
+	auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
+	Game* game = gamMgr->LoadGame(new Game(), 0);
+	core->SetGame(game);
+
+	ResRef mapRef { "ar0100" };
+	map = game->GetMap(mapRef, false);
+}
+
+}
+#endif
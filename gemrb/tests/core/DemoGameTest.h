@@ -0,0 +1,45 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef TEST_DEMOGAMETEST_H
+#define TEST_DEMOGAMETEST_H
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+class Map;
+
+/**
+ * Base of the suites that need the core with the demo game loaded.
+ *
+ * The core can only be set up once per process, so it is shared by all the
+ * suites and only torn down after the last test.
+ */
+class DemoGameTest : public testing::Test {
+public:
+	static Map* map; // the first area of the demo
+
+	static void SetUpTestSuite();
+};
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../../core/GameScript/CompiledScript.h"
+#include "../../../core/GameScript/GameScript.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+static Object* MakeObject(ScriptArena* arena, int seed)
+{
+	Object* object = arena ? new (*arena) Object() : new Object();
+	for (int i = 0; i < MAX_OBJECT_FIELDS; ++i) {
+		object->objectFields[i] = seed + i;
+	}
+	object->objectFilters[1] = seed * 2;
+	object->objectRect = Region(seed, 2, 30, 40);
+	object->objectName = StringParam("object");
+	return object;
+}
+
+static void MakeScript(Script& script)
+{
+	ScriptArena& arena = script.arena;
+	for (int b = 0; b < 3; ++b) {
+		ResponseBlock* rB = new (arena) ResponseBlock();
+		rB->condition = new (arena) Condition();
+		for (int t = 0; t < 2; ++t) {
+			Trigger* tR = new (arena) Trigger();
+			tR->triggerID = uint16_t(b * 10 + t);
+			tR->int0Parameter = -b;
+			tR->flags = TF_NEGATE | TF_PRECOMPILED;
+			tR->pointParameter = Point(b, t);
+			tR->string0Parameter = StringParam("globalvariable");
+			tR->objectParameter = t ? MakeObject(&arena, b) : nullptr;
+			rB->condition->triggers.push_back(tR);
+		}
+
+		// a block without responses
+		if (b == 2) {
+			script.responseBlocks.push_back(rB);
+			continue;
+		}
+		rB->responseSet = new (arena) ResponseSet();
+		Response* rE = new (arena) Response();
+		rE->weight = uint8_t(100 - b);
+		Action* aC = new Action(false);
+		aC->actionID = uint16_t(b + 1);
+		aC->objects[1] = MakeObject(nullptr, b + 5);
+		aC->int2Parameter = 7;
+		aC->string1Parameter = StringParam("area");
+		aC->flags = ACF_PRECOMPILED;
+		rE->actions.push_back(aC);
+		rB->responseSet->responses.push_back(rE);
+		script.responseBlocks.push_back(rB);
+	}
+}
+
+static const std::string sourceText = "SC\nCR\nCO\nTR\nOB\n";
+
+static void ExpectEqual(const Object* a, const Object* b)
+{
+	ASSERT_EQ(a == nullptr, b == nullptr);
+	if (!a) return;
+	for (int i = 0; i < MAX_OBJECT_FIELDS; ++i) {
+		EXPECT_EQ(a->objectFields[i], b->objectFields[i]);
+	}
+	for (int i = 0; i < MAX_NESTING; ++i) {
+		EXPECT_EQ(a->objectFilters[i], b->objectFilters[i]);
+	}
+	EXPECT_EQ(a->objectRect, b->objectRect);
+	EXPECT_EQ(a->objectName, b->objectName);
+}
+
+TEST(CompiledScriptTest, RoundTrip)
+{
+	Script original;
+	MakeScript(original);
+	std::string data = WriteCompiledScript(original, sourceText.data(), sourceText.size());
+
+	Script loaded;
+	ASSERT_TRUE(ReadCompiledScript(data.data(), data.size(), sourceText.data(), sourceText.size(), loaded));
+	ASSERT_EQ(loaded.responseBlocks.size(), original.responseBlocks.size());
+	for (size_t b = 0; b < original.responseBlocks.size(); ++b) {
+		const ResponseBlock* rB1 = original.responseBlocks[b];
+		const ResponseBlock* rB2 = loaded.responseBlocks[b];
+		ASSERT_EQ(rB1->condition->triggers.size(), rB2->condition->triggers.size());
+		for (size_t t = 0; t < rB1->condition->triggers.size(); ++t) {
+			const Trigger* tR1 = rB1->condition->triggers[t];
+			const Trigger* tR2 = rB2->condition->triggers[t];
+			EXPECT_EQ(tR1->triggerID, tR2->triggerID);
+			EXPECT_EQ(tR1->int0Parameter, tR2->int0Parameter);
+			EXPECT_EQ(tR1->flags, tR2->flags);
+			EXPECT_EQ(tR1->pointParameter, tR2->pointParameter);
+			EXPECT_EQ(tR1->string0Parameter, tR2->string0Parameter);
+			EXPECT_EQ(tR1->string1Parameter, tR2->string1Parameter);
+			ExpectEqual(tR1->objectParameter, tR2->objectParameter);
+		}
+
+		ASSERT_EQ(rB1->responseSet == nullptr, rB2->responseSet == nullptr);
+		if (!rB1->responseSet) continue;
+		ASSERT_EQ(rB2->responseSet->responses.size(), size_t(1));
+		const Response* rE1 = rB1->responseSet->responses[0];
+		const Response* rE2 = rB2->responseSet->responses[0];
+		EXPECT_EQ(rE1->weight, rE2->weight);
+		ASSERT_EQ(rE2->actions.size(), size_t(1));
+		const Action* aC1 = rE1->actions[0];
+		const Action* aC2 = rE2->actions[0];
+		EXPECT_EQ(aC1->actionID, aC2->actionID);
+		EXPECT_EQ(aC1->int2Parameter, aC2->int2Parameter);
+		EXPECT_EQ(aC1->string1Parameter, aC2->string1Parameter);
+		EXPECT_EQ(aC1->flags, aC2->flags);
+		EXPECT_EQ(aC2->GetRef(), 1);
+		for (int i = 0; i < 3; ++i) {
+			ExpectEqual(aC1->objects[i], aC2->objects[i]);
+		}
+	}
+}
+
+TEST(CompiledScriptTest, Damaged)
+{
+	Script original;
+	MakeScript(original);
+	std::string data = WriteCompiledScript(original, sourceText.data(), sourceText.size());
+
+	// every truncation must be rejected and leave the script empty
+	for (size_t size = 0; size < data.size(); size += 7) {
+		Script loaded;
+		EXPECT_FALSE(ReadCompiledScript(data.data(), size, sourceText.data(), sourceText.size(), loaded));
+		EXPECT_TRUE(loaded.responseBlocks.empty());
+	}
+
+	std::string foreign = data;
+	foreign[0] = 'X';
+	Script loaded;
+	EXPECT_FALSE(ReadCompiledScript(foreign.data(), foreign.size(), sourceText.data(), sourceText.size(), loaded));
+}
+
+TEST(CompiledScriptTest, OtherSource)
+{
+	Script original;
+	MakeScript(original);
+	std::string data = WriteCompiledScript(original, sourceText.data(), sourceText.size());
+
+	// same size, different text
+	std::string edited = sourceText;
+	edited[3] = 'R';
+	Script loaded;
+	EXPECT_FALSE(ReadCompiledScript(data.data(), data.size(), edited.data(), edited.size(), loaded));
+	EXPECT_TRUE(loaded.responseBlocks.empty());
+
+	std::string shorter = sourceText.substr(0, sourceText.size() - 1);
+	EXPECT_FALSE(ReadCompiledScript(data.data(), data.size(), shorter.data(), shorter.size(), loaded));
+	EXPECT_TRUE(ReadCompiledScript(data.data(), data.size(), sourceText.data(), sourceText.size(), loaded));
+}
+
+TEST(CompiledScriptTest, ActionsOutliveScript)
+{
+	Action* aC;
+	{
+		Script script;
+		MakeScript(script);
+		aC = script.responseBlocks[0]->responseSet->responses[0]->actions[0];
+		// like a queued action
+		aC->IncRef();
+	}
+	EXPECT_EQ(aC->GetRef(), 1);
+	EXPECT_EQ(aC->objects[1]->objectFields[0], 5);
+	aC->Release();
+}
+
+}
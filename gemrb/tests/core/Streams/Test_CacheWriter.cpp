@@ -0,0 +1,66 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "Streams/CacheWriter.h"
+#include "Streams/FileStream.h"
+#include "Streams/MemoryStream.h"
+#include "System/VFS.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+static const path_t CACHE_WRITER_TEST_FILE = PathJoin("tests", "resources", "streams", "cachewriter.tmp");
+
+TEST(CacheWriterTest, WritesInOrder)
+{
+	CacheWriter writer;
+	for (uint32_t round = 0; round < 3; ++round) {
+		auto contents = new MemoryStream(CACHE_WRITER_TEST_FILE, nullptr, 0);
+		for (uint32_t i = 0; i < 100000; ++i) {
+			contents->WriteScalar(i + round);
+		}
+		contents->Rewind();
+		writer.Write(CACHE_WRITER_TEST_FILE, contents);
+	}
+	EXPECT_TRUE(writer.Wait(CACHE_WRITER_TEST_FILE));
+
+	// only the last write is left
+	FileStream file;
+	ASSERT_TRUE(file.Open(CACHE_WRITER_TEST_FILE));
+	EXPECT_EQ(file.Size(), 400000);
+	uint32_t first = 0;
+	file.ReadScalar(first);
+	EXPECT_EQ(first, 2);
+	file.Close();
+
+	EXPECT_TRUE(writer.WaitAll());
+	UnlinkFile(CACHE_WRITER_TEST_FILE);
+}
+
+TEST(CacheWriterTest, ReportsFailures)
+{
+	CacheWriter writer;
+	path_t badPath = PathJoin("tests", "resources", "missing", "dir", "file.are");
+	writer.Write(badPath, new MemoryStream(badPath, nullptr, 0));
+	EXPECT_FALSE(writer.Wait(badPath));
+	// reported only once
+	EXPECT_TRUE(writer.WaitAll());
+}
+
+}
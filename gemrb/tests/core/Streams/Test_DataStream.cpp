@@ -217,6 +217,27 @@ TEST(DataStreamWritingTest, Writes)
 	}
 }
 
+TEST(DataStreamWritingTest, Appends)
+{
+	MemoryStream stream { "", nullptr, 0 };
+
+	for (uint16_t i = 0; i < 1000; ++i) {
+		EXPECT_EQ(stream.WriteScalar(i), 2);
+	}
+	EXPECT_EQ(stream.Size(), 2000);
+
+	stream.Seek(10, GEM_STREAM_START);
+	stream.WriteScalar(uint16_t { 0xffff });
+	EXPECT_EQ(stream.Size(), 2000);
+
+	stream.Rewind();
+	for (uint16_t i = 0; i < 1000; ++i) {
+		uint16_t v;
+		stream.ReadScalar(v);
+		EXPECT_EQ(v, i == 5 ? 0xffff : i);
+	}
+}
+
 static DataStream* createFileStream(const path_t& path)
 {
 	auto fstream = new FileStream();
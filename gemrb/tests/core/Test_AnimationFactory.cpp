@@ -0,0 +1,102 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "DemoGameTest.h"
+
+#include "../../includes/ie_stats.h"
+
+#include "../../core/AnimationFactory.h"
+#include "../../core/CharAnimations.h"
+#include "../../core/Factory.h"
+#include "../../core/GameData.h"
+#include "../../core/Scriptable/Actor.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace GemRB {
+
+class AnimationFactoryTest : public DemoGameTest {};
+
+// actors with the same animation only keep their own playback state
+TEST_F(AnimationFactoryTest, ActorsShareFrameSets)
+{
+	std::unique_ptr<Actor> first { gamedata->GetCreature(ResRef("rabbit")) };
+	std::unique_ptr<Actor> second { gamedata->GetCreature(ResRef("rabbit")) };
+	ASSERT_NE(first, nullptr);
+	ASSERT_NE(second, nullptr);
+
+	const auto* firstParts = first->GetAnims()->GetAnimation(IE_ANI_AWAKE, S);
+	size_t shared = AnimationFactory::GetCycleStats().hits;
+	const auto* secondParts = second->GetAnims()->GetAnimation(IE_ANI_AWAKE, S);
+	ASSERT_NE(firstParts, nullptr);
+	ASSERT_NE(secondParts, nullptr);
+	ASSERT_FALSE(firstParts->empty());
+	ASSERT_EQ(firstParts->size(), secondParts->size());
+
+	for (size_t i = 0; i < firstParts->size(); ++i) {
+		ASSERT_NE((*firstParts)[i], nullptr);
+		ASSERT_NE((*secondParts)[i], nullptr);
+		EXPECT_NE((*firstParts)[i], (*secondParts)[i]);
+		EXPECT_TRUE((*firstParts)[i]->SharesFrames(*(*secondParts)[i]));
+	}
+	EXPECT_GT(AnimationFactory::GetCycleStats().hits, shared);
+}
+
+// a factory isn't rebuilt while its frames are in use, which would duplicate them
+TEST_F(AnimationFactoryTest, SharedAfterEviction)
+{
+	auto source = gamedata->GetFactoryResourceAs<const AnimationFactory>(ResRef("rabbG17"), IE_BAM_CLASS_ID);
+	ASSERT_NE(source, nullptr);
+	auto makeFactory = [&source](const char* name) {
+		std::vector<Holder<Sprite2D>> frames { source->GetFrameWithoutCycle(0) };
+		std::vector<AnimationFactory::CycleEntry> cycles { { 1, 0 } };
+		std::vector<AnimationFactory::index_t> lookup { 0 };
+		return std::make_shared<AnimationFactory>(ResRef(name), std::move(frames), std::move(cycles), std::move(lookup));
+	};
+
+	// nothing unused fits
+	Factory factory(0);
+	auto af = makeFactory("SHARED");
+	factory.AddFactoryObject(af);
+	std::unique_ptr<Animation> first { af->GetCycle(0) };
+	ASSERT_NE(first, nullptr);
+	af = nullptr;
+
+	factory.AddFactoryObject(makeFactory("OTHER"));
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("OTHER"), IE_BAM_CLASS_ID), nullptr);
+	auto cached = std::static_pointer_cast<const AnimationFactory>(factory.GetFactoryObject(ResRef("SHARED"), IE_BAM_CLASS_ID));
+	ASSERT_NE(cached, nullptr);
+	std::unique_ptr<Animation> second { cached->GetCycle(0) };
+	EXPECT_TRUE(first->SharesFrames(*second));
+
+	// once nothing plays it, it can go
+	first = nullptr;
+	second = nullptr;
+	cached = nullptr;
+	factory.AddFactoryObject(makeFactory("OTHER"));
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("SHARED"), IE_BAM_CLASS_ID), nullptr);
+}
+
+}
+#endif
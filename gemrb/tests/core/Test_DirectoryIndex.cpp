@@ -0,0 +1,178 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "DirectoryIndex.h"
+
+#include "Streams/FileStream.h"
+
+#include <ctime>
+#include <gtest/gtest.h>
+#ifdef WIN32
+	#include <sys/utime.h>
+#else
+	#include <utime.h>
+#endif
+
+namespace GemRB {
+
+TEST(DirectoryIndexTest, Empty)
+{
+	DirectoryIndex index;
+	EXPECT_EQ(index.Count(), size_t(0));
+	EXPECT_TRUE(index.Find("file.txt").empty());
+}
+
+TEST(DirectoryIndexTest, Find)
+{
+	path_t dir = PathJoin("tests", "resources", "VFS", "encoding");
+	auto index = DirectoryIndex::Load(dir, false);
+
+	// only files, no directories
+	EXPECT_EQ(index.Count(), size_t(2));
+	EXPECT_EQ(index.Find("file.txt"), StringView("file.txt"));
+	EXPECT_EQ(index.Find("FILE.TXT"), StringView("file.txt"));
+	EXPECT_EQ(index.Find("file_äöü.txt"), StringView("file_äöü.txt"));
+	EXPECT_TRUE(index.Find("file").empty());
+	EXPECT_TRUE(index.Find("file.txt2").empty());
+	EXPECT_TRUE(index.Find("directory").empty());
+}
+
+class PersistentDirectoryIndexTest : public testing::Test {
+protected:
+	path_t dir = PathJoin("tests", "resources", "dirindex");
+	path_t indexFile = PathJoin("tests", "resources", "dirindex.bin");
+	path_t otherFile = PathJoin("tests", "resources", "dirindex2.bin");
+	// old enough to be stored
+	long long dirTime = std::time(nullptr) - 100;
+
+	void SetUp() override
+	{
+		ASSERT_TRUE(DirExists(dir) || MakeDirectory(dir));
+		AddFile("a.txt");
+		AddFile("B.txt");
+	}
+
+	void TearDown() override
+	{
+		Reread();
+		DirectoryIndex::Flush();
+		DelTree(dir, false);
+		RemoveDirectory(dir);
+		UnlinkFile(indexFile);
+		UnlinkFile(otherFile);
+	}
+
+	void AddFile(const path_t& name) const
+	{
+		FileStream file;
+		ASSERT_TRUE(file.Create(PathJoin(dir, name)));
+	}
+
+	void SetDirTime(long long time) const
+	{
+		utimbuf times { time_t(time), time_t(time) };
+		ASSERT_EQ(utime(dir.c_str(), &times), 0);
+	}
+
+	// makes the next Load with indexFile read it again
+	void Reread() const
+	{
+		DirectoryIndex::Load(dir, otherFile);
+	}
+};
+
+TEST_F(PersistentDirectoryIndexTest, RoundTrip)
+{
+	SetDirTime(dirTime);
+	EXPECT_EQ(DirectoryIndex::Load(dir, indexFile).Count(), size_t(2));
+	DirectoryIndex::Flush();
+	EXPECT_TRUE(FileExists(indexFile));
+
+	// a change the time doesn't show, so only a stored listing misses it
+	AddFile("c.txt");
+	SetDirTime(dirTime);
+	Reread();
+	auto index = DirectoryIndex::Load(dir, indexFile);
+	EXPECT_EQ(index.Count(), size_t(2));
+	EXPECT_EQ(index.Find("b.TXT"), StringView("B.txt"));
+	EXPECT_TRUE(index.Find("c.txt").empty());
+}
+
+TEST_F(PersistentDirectoryIndexTest, TimeInvalidates)
+{
+	SetDirTime(dirTime);
+	DirectoryIndex::Load(dir, indexFile);
+	DirectoryIndex::Flush();
+
+	AddFile("c.txt");
+	SetDirTime(dirTime + 10);
+	Reread();
+	auto index = DirectoryIndex::Load(dir, indexFile);
+	EXPECT_EQ(index.Count(), size_t(3));
+	EXPECT_EQ(index.Find("C.TXT"), StringView("c.txt"));
+}
+
+TEST_F(PersistentDirectoryIndexTest, RewriteKeepsOldListings)
+{
+	SetDirTime(dirTime);
+	DirectoryIndex::Load(dir, indexFile);
+	DirectoryIndex::Flush();
+	Reread();
+
+	// served from the index file, which is replaced below
+	auto old = DirectoryIndex::Load(dir, indexFile);
+	AddFile("c.txt");
+	SetDirTime(dirTime + 10);
+	EXPECT_EQ(DirectoryIndex::Load(dir, indexFile).Count(), size_t(3));
+	DirectoryIndex::Flush();
+	Reread();
+
+	EXPECT_EQ(old.Count(), size_t(2));
+	EXPECT_EQ(old.Find("A.TXT"), StringView("a.txt"));
+	EXPECT_EQ(DirectoryIndex::Load(dir, indexFile).Find("c.txt"), StringView("c.txt"));
+}
+
+TEST_F(PersistentDirectoryIndexTest, DamagedFile)
+{
+	SetDirTime(dirTime);
+	DirectoryIndex::Load(dir, indexFile);
+	DirectoryIndex::Flush();
+	AddFile("c.txt");
+	SetDirTime(dirTime);
+	Reread();
+
+	FileStream* file = FileStream::OpenFile(indexFile);
+	ASSERT_NE(file, nullptr);
+	std::string data(file->Size(), '\0');
+	ASSERT_EQ(file->Read(&data[0], data.size()), strret_t(data.size()));
+	delete file;
+
+	// every truncation is ignored as a whole, so the directory is listed again
+	for (size_t size = 0; size < data.size(); size += 5) {
+		FileStream out;
+		ASSERT_TRUE(out.Create(indexFile));
+		out.Write(data.data(), size);
+		out.Close();
+		EXPECT_EQ(DirectoryIndex::Load(dir, indexFile).Count(), size_t(3));
+		Reread();
+	}
+}
+
+}
@@ -0,0 +1,87 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "DemoGameTest.h"
+
+#include "../../core/EffectQueue.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+// the opcodes come from the effect tables of the demo
+class EffectQueueTest : public DemoGameTest {};
+
+// the opcode indexed lookups have to find the same as plain scans of the queue
+TEST_F(EffectQueueTest, IndexMatchesScan)
+{
+	constexpr int effectCount = 500;
+	constexpr ieDword opcodeCount = 50;
+
+	EffectQueue queue;
+	for (int i = 0; i < effectCount; i++) {
+		Effect* fx = new Effect();
+		fx->Opcode = i % opcodeCount;
+		fx->Parameter1 = i;
+		fx->Parameter2 = i % 7;
+		fx->TimingMode = FX_DURATION_INSTANT_PERMANENT;
+		queue.AddEffect(fx, i % 5 == 0);
+	}
+
+	// expire some effects, so the index also goes through a cleanup
+	auto iter = queue.GetFirstEffect();
+	int i = 0;
+	for (Effect* fx = queue.GetNextEffect(iter); fx; fx = queue.GetNextEffect(iter)) {
+		if (i++ % 10 == 0) fx->TimingMode = FX_DURATION_JUST_EXPIRED;
+	}
+	queue.Cleanup();
+	EXPECT_EQ(queue.GetEffectsCount(), size_t(effectCount - effectCount / 10));
+
+	const EffectQueue& constQueue = queue;
+	auto scanParam = [&constQueue](ieDword opcode, ieDword param2) -> const Effect* {
+		auto f = constQueue.GetFirstEffect();
+		for (const Effect* fx = constQueue.GetNextEffect(f); fx; fx = constQueue.GetNextEffect(f)) {
+			if (fx->Opcode == opcode && fx->Parameter2 == param2) return fx;
+		}
+		return nullptr;
+	};
+	auto scanBonus = [&constQueue](ieDword opcode, ieDword param2) {
+		int sum = 0;
+		auto f = constQueue.GetFirstEffect();
+		for (const Effect* fx = constQueue.GetNextEffect(f); fx; fx = constQueue.GetNextEffect(f)) {
+			if (fx->Opcode == opcode && fx->Parameter2 == param2) sum += fx->Parameter1;
+		}
+		return sum;
+	};
+
+	for (ieDword opcode = 0; opcode < opcodeCount; opcode++) {
+		EffectRef ref = { "Synthetic", int(opcode) };
+		for (ieDword param2 = 0; param2 < 8; param2++) {
+			EXPECT_EQ(queue.HasEffectWithParam(ref, param2), scanParam(opcode, param2));
+			EXPECT_EQ(queue.BonusForParam2(ref, param2), scanBonus(opcode, param2));
+		}
+	}
+}
+
+}
+#endif
@@ -0,0 +1,127 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/Factory.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+class SizedObject : public FactoryObject {
+public:
+	size_t size;
+	SizedObject(const char* name, size_t size)
+		: FactoryObject(ResRef(name), IE_BAM_CLASS_ID), size(size) {}
+
+	size_t GetMemorySize() const override { return size; }
+};
+
+class SharingObject : public SizedObject {
+public:
+	std::shared_ptr<int> part = std::make_shared<int>(0);
+	using SizedObject::SizedObject;
+
+	std::shared_ptr<int> GetPart() const { return Share(part); }
+};
+
+TEST(FactoryTest, Lookup)
+{
+	Factory factory;
+	auto first = std::make_shared<SizedObject>("CGEAR", 10);
+	factory.AddFactoryObject(first);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("cgear", 20));
+
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("Cgear"), IE_BAM_CLASS_ID), first);
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("CGEAR"), IE_BMP_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("CGEAR2"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject(ResRef(), IE_BAM_CLASS_ID), nullptr);
+
+	const auto& stats = factory.GetStats();
+	EXPECT_EQ(stats.hits, 1u);
+	EXPECT_EQ(stats.misses, 2u);
+	EXPECT_EQ(stats.objects, 1u);
+	EXPECT_EQ(stats.bytes, 10u);
+}
+
+TEST(FactoryTest, EvictsUnusedLeastRecentlyUsed)
+{
+	Factory factory(100);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("A", 40));
+	factory.AddFactoryObject(std::make_shared<SizedObject>("B", 40));
+	auto held = std::make_shared<SizedObject>("C", 10);
+	factory.AddFactoryObject(held);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("PINNED", 10), false);
+	// A becomes the most recently used one
+	EXPECT_NE(factory.GetFactoryObject(ResRef("A"), IE_BAM_CLASS_ID), nullptr);
+
+	factory.AddFactoryObject(std::make_shared<SizedObject>("D", 30));
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("B"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject(ResRef("A"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetStats().evictions, 1u);
+	EXPECT_EQ(factory.GetStats().bytes, 90u);
+
+	// only pinned and held objects are left to evict, besides the new one
+	factory.AddFactoryObject(std::make_shared<SizedObject>("E", 200));
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("C"), IE_BAM_CLASS_ID), held);
+	EXPECT_NE(factory.GetFactoryObject(ResRef("PINNED"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("A"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("E"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetStats().bytes, 20u);
+	EXPECT_EQ(factory.GetStats().objects, 2u);
+}
+
+TEST(FactoryTest, KeepsObjectsWithPartsInUse)
+{
+	Factory factory(100);
+	std::shared_ptr<int> part;
+	{
+		auto object = std::make_shared<SharingObject>("A", 60);
+		factory.AddFactoryObject(object);
+		part = object->GetPart();
+	}
+
+	factory.AddFactoryObject(std::make_shared<SizedObject>("B", 60));
+	EXPECT_NE(factory.GetFactoryObject(ResRef("A"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("B"), IE_BAM_CLASS_ID), nullptr);
+
+	part = nullptr;
+	factory.AddFactoryObject(std::make_shared<SizedObject>("C", 60));
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("A"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject(ResRef("C"), IE_BAM_CLASS_ID), nullptr);
+}
+
+TEST(FactoryTest, CountsGrowth)
+{
+	Factory factory(100);
+	auto grows = std::make_shared<SizedObject>("A", 10);
+	factory.AddFactoryObject(grows);
+	grows->size = 50;
+	EXPECT_EQ(factory.GetStats().bytes, 50u);
+
+	// over the budget once it is used no more
+	grows->size = 120;
+	grows = nullptr;
+	factory.AddFactoryObject(std::make_shared<SizedObject>("B", 10));
+	EXPECT_EQ(factory.GetFactoryObject(ResRef("A"), IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetStats().bytes, 10u);
+	EXPECT_EQ(factory.GetStats().objects, 1u);
+}
+
+}
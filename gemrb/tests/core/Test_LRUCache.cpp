@@ -0,0 +1,91 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/LRUCache.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+struct CachedValue {
+	int value;
+
+	explicit CachedValue(int value)
+		: value(value) {}
+
+	void evictionNotice() const {}
+};
+
+struct EvictAny {
+	bool operator()(const CachedValue&) const
+	{
+		return true;
+	}
+};
+
+TEST(LRUCacheTest, EvictsLeastRecentlyUsed)
+{
+	LRUCache<CachedValue, EvictAny, int> cache { 2 };
+	cache.SetAt(1, 10);
+	cache.SetAt(2, 20);
+	const CachedValue* first = cache.LookupAndTouch(1);
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(first->value, 10);
+
+	cache.SetAt(3, 30);
+	EXPECT_NE(cache.Lookup(1), nullptr);
+	EXPECT_EQ(cache.Lookup(2), nullptr);
+	EXPECT_EQ(cache.Lookup(3)->value, 30);
+	EXPECT_EQ(cache.LookupAndTouch(2), nullptr);
+}
+
+TEST(LRUCacheTest, TouchSingleItem)
+{
+	LRUCache<CachedValue, EvictAny, int> cache { 1 };
+	cache.SetAt(1, 10);
+	EXPECT_TRUE(cache.Touch(1));
+	cache.SetAt(2, 20);
+	EXPECT_EQ(cache.Lookup(1), nullptr);
+	EXPECT_EQ(cache.Lookup(2)->value, 20);
+}
+
+TEST(LRUCacheTest, Clear)
+{
+	LRUCache<CachedValue, EvictAny> cache { 2 };
+	cache.SetAt("a", 1);
+	cache.SetAt("b", 2);
+	cache.Clear();
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_EQ(cache.Lookup("b"), nullptr);
+	EXPECT_FALSE(cache.Touch("a"));
+	EXPECT_FALSE(cache.Remove("b"));
+
+	// usable as before
+	cache.SetAt("a", 3);
+	cache.SetAt("b", 4);
+	cache.SetAt("c", 5);
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_EQ(cache.Lookup("b")->value, 4);
+	EXPECT_EQ(cache.Lookup("c")->value, 5);
+	EXPECT_TRUE(cache.Remove("c"));
+	EXPECT_EQ(cache.Lookup("c"), nullptr);
+}
+
+}
@@ -20,55 +20,25 @@
 // FIXME: remove once fixed, this is excluding non-linux build bots
 #if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
 
+#include "DemoGameTest.h"
+
+#include "../../includes/ie_stats.h"
+
 #include "../../core/GameData.h"
+#include "../../core/GameScript/GSUtils.h"
+#include "../../core/GameScript/GameScript.h"
+#include "../../core/GameScript/Matching.h"
+#include "../../core/GameScript/Targets.h"
 #include "../../core/Interface.h"
-#include "../../core/InterfaceConfig.h"
-#include "../../core/Logging/Loggers/Stdio.h"
-#include "../../core/Logging/Logging.h"
 #include "../../core/Map.h"
-#include "../../core/PluginMgr.h"
-#include "../../core/SaveGameMgr.h"
+#include "../../core/Scriptable/Actor.h"
 
+#include <algorithm>
 #include <gtest/gtest.h>
 
 namespace GemRB {
 
-class MapTest : public testing::Test {
-public:
-	static const Interface* gemrb;
-	static Map* map;
-
-	// set up core and the first map from the demo
-	static void SetUpTestSuite()
-	{
-		setlocale(LC_ALL, "");
-		const char* argv[] = { "tester", "-c", "../../tester.cfg" };
-		auto cfg = LoadFromArgs(3, const_cast<char**>(argv));
-		ToggleLogging(true);
-		AddLogWriter(createStdioLogWriter());
-		gemrb = new Interface(std::move(cfg));
-
-		auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
-		auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
-		Game* game = gamMgr->LoadGame(new Game(), 0);
-		core->SetGame(game);
-
-		ResRef mapRef { "ar0100" };
-		map = game->GetMap(mapRef, false);
-	}
-
-	static void TearDownTestSuite()
-	{
-		// cleanup to prevent a delay and crash on exit
-		delete core->GetGame();
-		core->SetGame(nullptr);
-		VideoDriver.reset();
-		delete gemrb;
-	}
-};
-
-Map* MapTest::map = nullptr;
-const Interface* MapTest::gemrb = nullptr;
+class MapTest : public DemoGameTest {};
 
 static Point badPaths[] = { Point(1270, 640), Point(1071, 699), Point(1170, 967), Point(1126, 601) };
 static Point goodPaths[] = { Point(1126, 601), Point(685, 655), Point(720, 496), Point(1056, 336) };
@@ -119,6 +89,72 @@ TEST_F(MapTest, GetBlockedInLineTestDouble)
 	}
 }
 
+// the cached sight results have to match the uncached walk, also after a searchmap change
+TEST_F(MapTest, LOSCacheMatchesWalk)
+{
+	const Size mapSize = map->tileProps.GetSize();
+
+	std::vector<std::pair<SearchmapPoint, SearchmapPoint>> lines;
+	for (int i = 0; i < 1000; i++) {
+		SearchmapPoint s((i * 37) % mapSize.w, (i * 53) % mapSize.h);
+		SearchmapPoint d(Clamp(s.x + (i % 41) - 20, 0, mapSize.w - 1), Clamp(s.y + (i % 31) - 15, 0, mapSize.h - 1));
+		lines.emplace_back(s, d);
+	}
+
+	for (const auto& line : lines) {
+		map->SetLOSCacheEnabled(true);
+		bool cached = map->IsVisibleLOS(line.first, line.second, nullptr);
+		EXPECT_EQ(cached, map->IsVisibleLOS(line.first, line.second, nullptr));
+		map->SetLOSCacheEnabled(false);
+		EXPECT_EQ(cached, map->IsVisibleLOS(line.first, line.second, nullptr));
+	}
+
+	// a new wall on a visible line has to be seen through the cache
+	map->SetLOSCacheEnabled(true);
+	for (const auto& line : lines) {
+		if (line.first == line.second || !map->IsVisibleLOS(line.first, line.second, nullptr)) continue;
+		PathMapFlags old = map->tileProps.QuerySearchMap(line.second);
+		map->tileProps.PaintSearchMap(line.second, PathMapFlags::SIDEWALL);
+		map->SearchMapChanged(line.second);
+		EXPECT_FALSE(map->IsVisibleLOS(line.first, line.second, nullptr));
+		map->tileProps.PaintSearchMap(line.second, old);
+		map->SearchMapChanged(line.second);
+		EXPECT_TRUE(map->IsVisibleLOS(line.first, line.second, nullptr));
+		break;
+	}
+}
+
+// the cached walk checks every cell, the old one stepped over some (see Map::IsVisibleLOS)
+TEST_F(MapTest, LOSMatchesBlockedInLine)
+{
+	const Size mapSize = map->tileProps.GetSize();
+	map->SetLOSCacheEnabled(false);
+
+	int tileDifferences = 0;
+	int navDifferences = 0;
+	constexpr int lineCount = 1000;
+	for (int i = 0; i < lineCount; i++) {
+		SearchmapPoint s((i * 37) % mapSize.w, (i * 53) % mapSize.h);
+		SearchmapPoint d(Clamp(s.x + (i % 41) - 20, 0, mapSize.w - 1), Clamp(s.y + (i % 31) - 15, 0, mapSize.h - 1));
+		bool walked = !bool(map->GetBlockedInLineTile(s, d, false) & PathMapFlags::SIDEWALL);
+		if (walked != map->IsVisibleLOS(s, d, nullptr)) {
+			tileDifferences++;
+		}
+
+		// somewhere inside the cells
+		Point ns = s.ToNavmapPoint() + Point(i % 16, i % 12);
+		Point nd = d.ToNavmapPoint() + Point((i * 7) % 16, (i * 5) % 12);
+		walked = !bool(map->GetBlockedInLine(ns, nd, false) & PathMapFlags::SIDEWALL);
+		if (walked != map->IsVisibleLOS(ns, nd, nullptr)) {
+			navDifferences++;
+		}
+	}
+	map->SetLOSCacheEnabled(true);
+
+	EXPECT_LE(tileDifferences, lineCount / 50);
+	EXPECT_LE(navDifferences, lineCount / 50);
+}
+
 TEST_F(MapTest, FindPathTest)
 {
 	// straight path
@@ -150,5 +186,331 @@ TEST_F(MapTest, FindPathTest)
 	EXPECT_TRUE(path);
 	EXPECT_GT(path.Size(), 1);
 }
+
+// batched searches must give the same paths as searching one by one
+TEST_F(MapTest, FindPathsBatch)
+{
+	constexpr int circleSize = 2;
+
+	std::vector<PathRequest> requests;
+	for (const Point& start : badPaths) {
+		for (const Point& dest : goodPaths) {
+			PathRequest request;
+			request.start = start;
+			request.dest = dest;
+			request.size = circleSize;
+			requests.push_back(request);
+		}
+	}
+
+	map->FindPaths(requests);
+	for (const auto& request : requests) {
+		Path path = map->FindPath(request.start, request.dest, circleSize);
+		ASSERT_EQ(request.path.Size(), path.Size()) << request.start.x << "." << request.start.y << " -> " << request.dest.x << "." << request.dest.y;
+		for (size_t i = 0; i < path.Size(); i++) {
+			EXPECT_EQ(request.path.GetStep(i).point, path.GetStep(i).point);
+			EXPECT_EQ(request.path.GetStep(i).orient, path.GetStep(i).orient);
+		}
+	}
+
+	// and a second batch with the same scratch buffers gives the same again
+	std::vector<PathRequest> again = requests;
+	map->FindPaths(again);
+	for (size_t i = 0; i < requests.size(); i++) {
+		EXPECT_EQ(again[i].path.Size(), requests[i].path.Size());
+	}
+}
+
+// queued searches reach their movers only at the delivery and are then taken by WalkTo
+TEST_F(MapTest, QueuedPathsAreDelivered)
+{
+	std::vector<Actor*> movers;
+	for (int i = 0; i < 3; i++) {
+		Actor* actor = gamedata->GetCreature(ResRef("rabbit"));
+		ASSERT_NE(actor, nullptr);
+		actor->SetPosition(goodPaths[i], false);
+		map->AddActor(actor, true);
+		movers.push_back(actor);
+	}
+
+	const Point& dest = goodPaths[3];
+	for (const Actor* actor : movers) {
+		PathRequest request;
+		request.start = actor->Pos;
+		request.dest = dest;
+		request.size = actor->circleSize;
+		request.flags = PF_SIGHT | PF_ACTORS_ARE_BLOCKING;
+		request.caller = actor;
+		map->QueuePath(std::move(request));
+		EXPECT_TRUE(map->IsPathQueued(actor));
+	}
+	// gone before the dispatch, so it's skipped
+	Actor* leaver = movers.back();
+	movers.pop_back();
+	map->RemoveActor(leaver);
+
+	map->DispatchPaths();
+	for (const Actor* actor : movers) {
+		EXPECT_TRUE(map->IsPathQueued(actor));
+		EXPECT_FALSE(actor->HasPlannedPath(dest, 0));
+	}
+
+	map->DeliverPaths();
+	EXPECT_FALSE(leaver->HasPlannedPath(dest, 0));
+	for (Actor* actor : movers) {
+		EXPECT_FALSE(map->IsPathQueued(actor));
+		EXPECT_TRUE(actor->HasPlannedPath(dest, 0));
+		// anywhere else, it's searched again
+		EXPECT_FALSE(actor->HasPlannedPath(goodPaths[0], 0));
+		EXPECT_FALSE(actor->HasPlannedPath(dest, 10));
+
+		actor->Movable::WalkTo(dest);
+		EXPECT_TRUE(actor->InMove());
+		EXPECT_FALSE(actor->HasPlannedPath(dest, 0));
+		actor->Stop();
+	}
+
+	delete leaver;
+	for (Actor* actor : movers) {
+		map->RemoveActor(actor);
+		delete actor;
+	}
+}
+
+// long routes planned on the cluster graph have to reach the same places as
+// the plain search on the biggest demo area
+TEST_F(MapTest, HierarchicalPathsMatchFlat)
+{
+	constexpr int circleSize = 2;
+
+	Map* bigMap = core->GetGame()->GetMap(ResRef("ar0110"), false);
+	ASSERT_NE(bigMap, nullptr);
+
+	// pairs of walkable points from opposite corners of the area
+	const Size& mapSize = bigMap->tileProps.GetSize();
+	std::vector<PathRequest> requests;
+	for (int y = 0; y < mapSize.h / 3; y += 4) {
+		for (int x = 0; x < mapSize.w / 3; x += 4) {
+			SearchmapPoint near(x, y);
+			SearchmapPoint far(mapSize.w - 1 - x, mapSize.h - 1 - y);
+			if (!(bigMap->GetBlockedTile(near) & PathMapFlags::PASSABLE)) continue;
+			if (!(bigMap->GetBlockedTile(far) & PathMapFlags::PASSABLE)) continue;
+			PathRequest request;
+			request.start = near.ToNavmapPoint() + Point(8, 6);
+			request.dest = far.ToNavmapPoint() + Point(8, 6);
+			request.size = circleSize;
+			requests.push_back(request);
+		}
+	}
+	ASSERT_FALSE(requests.empty());
+
+	std::vector<PathRequest> flat = requests;
+	bigMap->SetHierarchicalPathing(false);
+	bigMap->FindPaths(flat);
+	bigMap->SetHierarchicalPathing(true);
+	bigMap->FindPaths(requests);
+
+	// the search leaves a blocked corridor, so it finds the same routes
+	for (size_t i = 0; i < requests.size(); i++) {
+		const Path& path = requests[i].path;
+		ASSERT_EQ(bool(path), bool(flat[i].path)) << requests[i].start.x << "." << requests[i].start.y;
+		if (!path) continue;
+		EXPECT_EQ(path.GetStep(path.Size() - 1).point, flat[i].path.GetStep(flat[i].path.Size() - 1).point);
+	}
+}
+
+// IDS object matching through the actor index has to find what the full actor scan finds
+TEST_F(MapTest, ActorIndexMatchesScan)
+{
+	constexpr int actorCount = 100;
+
+	std::vector<Actor*> crowd;
+	for (int i = 0; i < actorCount; i++) {
+		Actor* actor = gamedata->GetCreature(ResRef("rabbit"));
+		ASSERT_NE(actor, nullptr);
+		actor->SetBase(IE_EA, i % 3 ? EA_ENEMY : EA_NEUTRAL);
+		actor->SetBase(IE_CLASS, 1 + i % 12);
+		actor->SetBase(IE_RACE, 1 + i % 7);
+		actor->SetPosition(Point(700 + (i % 10) * 20, 500 + (i / 10) * 20), false);
+		map->AddActor(actor, true);
+		crowd.push_back(actor);
+	}
+
+	// ea, general, race, class, specific, gender, alignment
+	std::vector<Object> objects(4);
+	objects[0].objectFields[0] = EA_ENEMY; // [ENEMY]
+	objects[1].objectFields[0] = EA_ENEMY; // [ENEMY.0.0.MAGE]
+	objects[1].objectFields[3] = 1;
+	objects[2].objectFields[2] = 3; // [0.0.ELF]
+	objects[3].objectFields[0] = EA_EVILCUTOFF; // [EVILCUTOFF.0.0.THIEF]
+	objects[3].objectFields[3] = 4;
+
+	auto collect = [](Targets* tgts) {
+		std::vector<const Scriptable*> found;
+		if (!tgts) return found;
+		for (unsigned int i = 0; i < tgts->Count(); i++) {
+			found.push_back(tgts->GetTarget(i, ST_ANY));
+		}
+		delete tgts;
+		return found;
+	};
+
+	for (const Object& object : objects) {
+		map->SetActorIndexEnabled(true);
+		auto indexed = collect(GetAllObjects(map, map, &object, 0));
+		map->SetActorIndexEnabled(false);
+		auto scanned = collect(GetAllObjects(map, map, &object, 0));
+		EXPECT_FALSE(indexed.empty());
+		EXPECT_EQ(indexed, scanned);
+	}
+
+	// the index follows changes to the matched stats
+	crowd[0]->SetBase(IE_EA, EA_ENEMY); // was neutral, already a mage
+	map->SetActorIndexEnabled(true);
+	auto indexed = collect(GetAllObjects(map, map, &objects[1], 0));
+	EXPECT_NE(std::find(indexed.begin(), indexed.end(), crowd[0]), indexed.end());
+	map->SetActorIndexEnabled(false);
+	EXPECT_EQ(indexed, collect(GetAllObjects(map, map, &objects[1], 0)));
+	map->SetActorIndexEnabled(true);
+
+	for (Actor* actor : crowd) {
+		map->RemoveActor(actor);
+		delete actor;
+	}
+}
+
+// the actor grid radius and point queries have to find what the full actor
+// scan finds, both for a sparse and a dense crowd
+TEST_F(MapTest, ActorGridMatchesScan)
+{
+	constexpr int actorCount = 200;
+	const Size mapSize = map->GetSize();
+
+	std::vector<Actor*> crowd;
+	for (int i = 0; i < actorCount; i++) {
+		Actor* actor = gamedata->GetCreature(ResRef("rabbit"));
+		ASSERT_NE(actor, nullptr);
+		actor->SetBase(IE_EA, i % 3 ? EA_ENEMY : EA_NEUTRAL);
+		map->AddActor(actor, true);
+		crowd.push_back(actor);
+	}
+
+	std::vector<Point> probes;
+	for (int i = 0; i < 50; i++) {
+		probes.emplace_back((i * 97) % mapSize.w, (i * 61) % mapSize.h);
+	}
+
+	// spread over the whole area first, then packed around the probes
+	for (int layout = 0; layout < 2; layout++) {
+		for (int i = 0; i < actorCount; i++) {
+			Point pos;
+			if (layout == 0) {
+				pos = Point((i * 337) % mapSize.w, (i * 211) % mapSize.h);
+			} else {
+				pos = probes[i % probes.size()] + Point((i % 5) * 16, (i % 7) * 12);
+			}
+			// moves update the grid through SetPos
+			crowd[i]->SetPosition(pos, false);
+		}
+
+		for (const Point& p : probes) {
+			map->SetActorGridEnabled(true);
+			auto gridAll = map->GetAllActorsInRadius(p, GA_NO_LOS, 15);
+			auto gridOne = map->GetActorInRadius(p, 0, 100);
+			auto gridPoint = map->GetActor(p, 0);
+			auto gridRect = map->GetActorsInRect(Region(p, Size(200, 150)), 0);
+			bool gridEnemy = map->AnyEnemyNearPoint(p);
+			map->SetActorGridEnabled(false);
+			EXPECT_EQ(gridAll, map->GetAllActorsInRadius(p, GA_NO_LOS, 15)) << "layout " << layout;
+			EXPECT_EQ(gridOne, map->GetActorInRadius(p, 0, 100)) << "layout " << layout;
+			EXPECT_EQ(gridPoint, map->GetActor(p, 0)) << "layout " << layout;
+			EXPECT_EQ(gridRect, map->GetActorsInRect(Region(p, Size(200, 150)), 0)) << "layout " << layout;
+			EXPECT_EQ(gridEnemy, map->AnyEnemyNearPoint(p)) << "layout " << layout;
+		}
+	}
+
+	map->SetActorGridEnabled(true);
+	for (Actor* actor : crowd) {
+		map->RemoveActor(actor);
+		delete actor;
+	}
+}
+
+// the cached fog footprints have to uncover the same as retracing them
+TEST_F(MapTest, FogFootprintsMatchRetrace)
+{
+	constexpr int actorCount = 6;
+
+	std::vector<Actor*> party;
+	for (int i = 0; i < actorCount; i++) {
+		Actor* actor = gamedata->GetCreature(ResRef("rabbit"));
+		ASSERT_NE(actor, nullptr);
+		actor->SetBase(IE_EXPLORE, 1);
+		actor->SetPosition(Point(600 + i * 60, 500 + (i % 2) * 80), false);
+		map->AddActor(actor, true);
+		party.push_back(actor);
+	}
+
+	auto compare = [&]() {
+		map->UpdateFog();
+		std::vector<uint8_t> cached(map->VisibleBitmap.begin(), map->VisibleBitmap.end());
+		// any searchmap change drops all the footprints
+		map->SearchMapChanged(SearchmapPoint());
+		map->UpdateFog();
+		std::vector<uint8_t> retraced(map->VisibleBitmap.begin(), map->VisibleBitmap.end());
+		EXPECT_EQ(cached, retraced);
+	};
+	compare();
+
+	// one of them walks on, the others keep their footprints
+	party[0]->SetPosition(party[0]->Pos + Point(100, 60), false);
+	compare();
+
+	for (Actor* actor : party) {
+		map->RemoveActor(actor);
+		delete actor;
+	}
+	map->UpdateFog();
+}
+
+TEST_F(MapTest, IncrementalTriggersDeterminism)
+{
+	// ar0100.bcs has a Global("ReturnedOutside","GLOBAL",1) and an OnCreation() block
+	auto runRounds = [](bool incremental) {
+		core->config.IncrementalTriggers = incremental;
+		Game* game = core->GetGame();
+		SetVariable(game, "ReturnedOutside", 0, "GLOBAL");
+		map->SetInternalFlag(IF_ACTIVE, BitOp::OR);
+		map->ClearActions();
+		map->ClearTriggers();
+
+		GameScript script(ResRef("ar0100"), map);
+		std::vector<std::vector<unsigned short>> queues;
+		for (int round = 0; round < 8; round++) {
+			if (round == 2) SetVariable(game, "ReturnedOutside", 1, "GLOBAL");
+			if (round == 4) SetVariable(game, "ReturnedOutside", 2, "GLOBAL");
+			if (round == 6) map->AddTrigger(TriggerEntry(trigger_oncreation));
+
+			script.Update();
+			map->ClearTriggers();
+
+			// immediate actions don't end up in the queue, but can change the variable
+			std::vector<unsigned short> queue { static_cast<unsigned short>(CheckVariable(game, "ReturnedOutside", "GLOBAL")) };
+			while (Action* action = map->PopNextAction()) {
+				queue.push_back(action->actionID);
+				action->Release();
+			}
+			queues.push_back(std::move(queue));
+		}
+		return queues;
+	};
+
+	auto full = runRounds(false);
+	auto incremental = runRounds(true);
+	EXPECT_EQ(full, incremental);
+	EXPECT_EQ(full[0].size(), 1U);
+	EXPECT_NE(full[2], full[1]);
+	core->config.IncrementalTriggers = true;
+}
 }
 #endif
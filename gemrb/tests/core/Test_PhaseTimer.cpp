@@ -0,0 +1,68 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/PhaseTimer.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace GemRB {
+
+TEST(PhaseTimerTest, PhasesInOrder)
+{
+	PhaseTimer timer("test");
+	timer.Begin("first");
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	timer.Begin("second");
+	timer.Stop();
+	timer.Stop(); // no effect
+
+	const auto& phases = timer.GetPhases();
+	ASSERT_EQ(phases.size(), size_t(2));
+	EXPECT_EQ(phases[0].name, "first");
+	EXPECT_EQ(phases[1].name, "second");
+	EXPECT_GE(phases[0].duration, std::chrono::milliseconds(2));
+	EXPECT_EQ(timer.GetTotal(), phases[0].duration + phases[1].duration);
+}
+
+TEST(PhaseTimerTest, EmptyTimer)
+{
+	PhaseTimer timer("idle");
+	timer.Stop();
+	EXPECT_TRUE(timer.GetPhases().empty());
+	EXPECT_EQ(timer.GetTotal(), PhaseTimer::Clock::duration::zero());
+	EXPECT_EQ(timer.ToJSON(), "{\"timer\": \"idle\", \"total_ms\": 0.000, \"phases\": []}\n");
+}
+
+TEST(PhaseTimerTest, JSON)
+{
+	PhaseTimer timer("startup");
+	timer.Begin("video");
+	timer.Begin("strings");
+	timer.Stop();
+
+	std::string json = timer.ToJSON();
+	EXPECT_EQ(json.rfind("{\"timer\": \"startup\", \"total_ms\": ", 0), size_t(0));
+	EXPECT_NE(json.find("\"phases\": [{\"name\": \"video\", \"ms\": "), std::string::npos);
+	EXPECT_NE(json.find("}, {\"name\": \"strings\", \"ms\": "), std::string::npos);
+	EXPECT_EQ(json.substr(json.size() - 4), "}]}\n");
+}
+
+}
@@ -0,0 +1,209 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/PluginMgr.h"
+#include "../../core/ResourceManager.h"
+#include "../../core/ResourceSource.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace GemRB {
+
+// unused by the real plugins
+static constexpr PluginID INDEXED_SOURCE = 0x7E570001;
+static constexpr PluginID UNINDEXED_SOURCE = 0x7E570002;
+static constexpr PluginID MISSING_SOURCE = 0x7E570003;
+
+// the resources of a source are the comma separated names of its path
+class FakeSource : public ResourceSource {
+public:
+	static std::map<std::string, FakeSource*> opened; // by description
+	static std::mutex openedMutex;
+	std::set<std::string> names;
+	int probes = 0;
+	bool indexed = true;
+
+	bool Open(const path_t& filename, std::string desc) override
+	{
+		description = std::move(desc);
+		size_t start = 0;
+		while (start < filename.length()) {
+			size_t end = std::min(filename.find(',', start), filename.length());
+			names.insert(filename.substr(start, end - start));
+			start = end + 1;
+		}
+		// AddSources opens them in parallel
+		std::lock_guard<std::mutex> lock(openedMutex);
+		opened[description] = this;
+		return true;
+	}
+
+	bool HasResource(StringView resname, SClass_ID) override
+	{
+		++probes;
+		std::string name(resname.c_str(), resname.length());
+		std::transform(name.begin(), name.end(), name.begin(), tolower);
+		return names.count(name) != 0;
+	}
+
+	bool HasResource(StringView resname, const ResourceDesc&) override
+	{
+		return HasResource(resname, IE_2DA_CLASS_ID);
+	}
+
+	DataStream* GetResource(StringView, SClass_ID) override { return nullptr; }
+	DataStream* GetResource(StringView, const ResourceDesc&) override { return nullptr; }
+	bool IsIndexed() const override { return indexed; }
+};
+
+std::map<std::string, FakeSource*> FakeSource::opened;
+std::mutex FakeSource::openedMutex;
+
+static PluginHolder<Plugin> CreateIndexed()
+{
+	return std::make_shared<FakeSource>();
+}
+
+static PluginHolder<Plugin> CreateUnindexed()
+{
+	auto source = std::make_shared<FakeSource>();
+	source->indexed = false;
+	return source;
+}
+
+class ResourceManagerTest : public testing::Test {
+protected:
+	ResourceManager manager;
+
+	static void SetUpTestSuite()
+	{
+		PluginMgr::Get()->RegisterPlugin(INDEXED_SOURCE, CreateIndexed);
+		PluginMgr::Get()->RegisterPlugin(UNINDEXED_SOURCE, CreateUnindexed);
+	}
+
+	void SetUp() override
+	{
+		FakeSource::opened.clear();
+	}
+
+	bool Exists(StringView name) const
+	{
+		return manager.Exists(name, IE_2DA_CLASS_ID, true);
+	}
+
+	static int Probes(const std::string& description)
+	{
+		return FakeSource::opened.at(description)->probes;
+	}
+};
+
+TEST_F(ResourceManagerTest, NegativeHits)
+{
+	manager.AddSource("abc,def", "game", INDEXED_SOURCE);
+	EXPECT_FALSE(Exists("xyz"));
+	EXPECT_EQ(Probes("game"), 1);
+	EXPECT_EQ(manager.GetLocationStats().negativeHits, size_t(0));
+
+	// the indexed source isn't asked again
+	EXPECT_FALSE(Exists("XYZ"));
+	EXPECT_EQ(Probes("game"), 1);
+	EXPECT_EQ(manager.GetLocationStats().negativeHits, size_t(1));
+
+	EXPECT_TRUE(Exists("abc"));
+	EXPECT_TRUE(Exists("ABC"));
+	EXPECT_EQ(Probes("game"), 2);
+	EXPECT_EQ(manager.GetLocationStats().hits, size_t(2));
+}
+
+TEST_F(ResourceManagerTest, LongNamesAreNotCached)
+{
+	manager.AddSource("abcdefghi", "game", INDEXED_SOURCE);
+	EXPECT_TRUE(Exists("abcdefghi"));
+	EXPECT_FALSE(Exists("abcdefghj"));
+	EXPECT_FALSE(Exists("abcdefghj"));
+	EXPECT_EQ(Probes("game"), 3);
+	EXPECT_EQ(manager.GetLocationStats().entries, size_t(0));
+}
+
+TEST_F(ResourceManagerTest, AddSourceInvalidates)
+{
+	manager.AddSource("abc", "game", INDEXED_SOURCE);
+	EXPECT_FALSE(Exists("new"));
+	EXPECT_FALSE(Exists("new"));
+
+	manager.AddSource("new", "mod", INDEXED_SOURCE);
+	EXPECT_EQ(manager.GetLocationStats().invalidations, size_t(1));
+	EXPECT_TRUE(Exists("new"));
+}
+
+TEST_F(ResourceManagerTest, ReplacedSourceInvalidates)
+{
+	manager.AddSource("abc", "game", INDEXED_SOURCE);
+	manager.AddSource("old", "mod", INDEXED_SOURCE);
+	EXPECT_TRUE(Exists("old"));
+	EXPECT_FALSE(Exists("new"));
+
+	manager.AddSource("new", "mod", INDEXED_SOURCE, RM_REPLACE_SAME_SOURCE);
+	EXPECT_FALSE(Exists("old"));
+	EXPECT_TRUE(Exists("new"));
+}
+
+TEST_F(ResourceManagerTest, UnindexedSourcesAreProbed)
+{
+	manager.AddSource("", "saves", UNINDEXED_SOURCE);
+	manager.AddSource("abc", "game", INDEXED_SOURCE);
+	EXPECT_TRUE(Exists("abc"));
+	EXPECT_FALSE(Exists("xyz"));
+	EXPECT_TRUE(Exists("abc"));
+	EXPECT_FALSE(Exists("xyz"));
+	EXPECT_EQ(Probes("saves"), 4);
+	EXPECT_EQ(Probes("game"), 2);
+
+	// files written there are found right away, in front of the indexed ones
+	FakeSource::opened.at("saves")->names.insert("xyz");
+	FakeSource::opened.at("saves")->names.insert("abc");
+	EXPECT_TRUE(Exists("xyz"));
+	EXPECT_TRUE(Exists("abc"));
+	EXPECT_EQ(Probes("game"), 2);
+}
+
+TEST_F(ResourceManagerTest, AddSourcesKeepsOrder)
+{
+	std::vector<ResourceManager::SourceDesc> sources = {
+		{ "abc", "first", INDEXED_SOURCE },
+		{ "abc", "missing", MISSING_SOURCE },
+		{ "abc,xyz", "second", UNINDEXED_SOURCE }
+	};
+	std::vector<bool> added = manager.AddSources(sources);
+	EXPECT_EQ(added, std::vector<bool>({ true, false, true }));
+
+	// searched in the given order
+	EXPECT_TRUE(Exists("abc"));
+	EXPECT_EQ(Probes("first"), 1);
+	EXPECT_EQ(Probes("second"), 0);
+	EXPECT_TRUE(Exists("xyz"));
+	EXPECT_EQ(Probes("second"), 1);
+}
+
+}
@@ -0,0 +1,99 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/ResourcePrefetcher.h"
+
+#include "../../core/Streams/MemoryStream.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <mutex>
+
+namespace GemRB {
+
+static DataStream* MakeStream(const char* contents)
+{
+	size_t len = strlen(contents);
+	void* data = malloc(len);
+	memcpy(data, contents, len);
+	return new MemoryStream("test.wed", data, len);
+}
+
+TEST(ResourcePrefetcherTest, HandsOverStreams)
+{
+	ResourcePrefetcher prefetcher;
+	prefetcher.Queue(ResRef("AR0100"), IE_WED_CLASS_ID, MakeStream("WED V1.3"));
+	prefetcher.Queue(ResRef("AR0100"), IE_TIS_CLASS_ID, MakeStream("TIS V1"));
+	EXPECT_TRUE(prefetcher.IsQueued(ResRef("ar0100"), IE_WED_CLASS_ID));
+	EXPECT_FALSE(prefetcher.IsQueued(ResRef("ar0100"), IE_MOS_CLASS_ID));
+
+	DataStream* str = prefetcher.GetStream("ar0100", IE_WED_CLASS_ID);
+	ASSERT_NE(str, nullptr);
+	char buffer[8];
+	ASSERT_EQ(str->Size(), sizeof(buffer));
+	str->Read(buffer, sizeof(buffer));
+	EXPECT_EQ(memcmp(buffer, "WED V1.3", sizeof(buffer)), 0);
+	delete str;
+
+	// taken only once
+	EXPECT_FALSE(prefetcher.IsQueued(ResRef("ar0100"), IE_WED_CLASS_ID));
+	EXPECT_EQ(prefetcher.GetStream("ar0100", IE_WED_CLASS_ID), nullptr);
+	EXPECT_EQ(prefetcher.GetStream("ar0100", IE_BMP_CLASS_ID), nullptr);
+	EXPECT_EQ(prefetcher.GetStream("ar0200", IE_WED_CLASS_ID), nullptr);
+
+	prefetcher.Clear();
+	EXPECT_EQ(prefetcher.GetStream("ar0100", IE_TIS_CLASS_ID), nullptr);
+}
+
+TEST(ResourcePrefetcherTest, QueuesJobResults)
+{
+	ResourcePrefetcher prefetcher;
+	prefetcher.QueueJob([]() {
+		return std::vector<ResourcePrefetcher::Request> { { ResRef("AR0100"), IE_WED_CLASS_ID, MakeStream("WED V1.3") } };
+	});
+	prefetcher.WaitForJobs();
+
+	DataStream* str = prefetcher.GetStream("ar0100", IE_WED_CLASS_ID);
+	ASSERT_NE(str, nullptr);
+	EXPECT_EQ(str->Size(), strpos_t(8));
+	delete str;
+}
+
+TEST(ResourcePrefetcherTest, ClearDoesNotWait)
+{
+	ResourcePrefetcher prefetcher;
+	std::mutex gate;
+	std::unique_lock<std::mutex> closed(gate);
+	prefetcher.QueueJob([&gate]() {
+		std::lock_guard<std::mutex> open(gate);
+		return std::vector<ResourcePrefetcher::Request> { { ResRef("AR0100"), IE_WED_CLASS_ID, MakeStream("WED V1.3") } };
+	});
+
+	// the job is still blocked, so this would hang if it waited
+	prefetcher.Clear();
+	closed.unlock();
+	prefetcher.WaitForJobs();
+
+	// and what the job found is discarded
+	EXPECT_FALSE(prefetcher.IsQueued(ResRef("ar0100"), IE_WED_CLASS_ID));
+	EXPECT_EQ(prefetcher.GetStream("ar0100", IE_WED_CLASS_ID), nullptr);
+}
+
+}
@@ -0,0 +1,80 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../core/TaskPool.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace GemRB {
+
+TEST(TaskPoolTest, RunsAfterDependencies)
+{
+	std::vector<int> order;
+	std::mutex orderMutex;
+	auto record = [&order, &orderMutex](int step) {
+		return [&order, &orderMutex, step]() {
+			std::lock_guard<std::mutex> lock(orderMutex);
+			order.push_back(step);
+		};
+	};
+
+	TaskPool pool(4);
+	TaskPool::TaskID first = pool.Add(record(1));
+	TaskPool::TaskID second = pool.Add(record(2), { first });
+	pool.Add(record(3), { first, second });
+	pool.WaitAll();
+	EXPECT_EQ(order, std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST(TaskPoolTest, RunsIndependentTasksTogether)
+{
+	std::atomic<int> started { 0 };
+	auto rendezvous = [&started]() {
+		++started;
+		// only finishes if the other one runs at the same time
+		while (started < 2) {
+			std::this_thread::yield();
+		}
+	};
+
+	TaskPool pool(2);
+	pool.Add(rendezvous);
+	pool.Add(rendezvous);
+	pool.WaitAll();
+	EXPECT_EQ(started, 2);
+}
+
+TEST(TaskPoolTest, RethrowsErrors)
+{
+	bool ranDependent = false;
+	TaskPool pool(1);
+	TaskPool::TaskID failing = pool.Add([]() { throw std::runtime_error("broken"); });
+	TaskPool::TaskID dependent = pool.Add([&ranDependent]() { ranDependent = true; }, { failing });
+	TaskPool::TaskID independent = pool.Add([]() {});
+
+	EXPECT_THROW(pool.Wait(failing), std::runtime_error);
+	EXPECT_THROW(pool.Wait(dependent), std::runtime_error);
+	EXPECT_NO_THROW(pool.Wait(independent));
+	EXPECT_FALSE(ranDependent);
+}
+
+}
@@ -0,0 +1,94 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "VariableSlots.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+TEST(VariableSlotsTest, Intern)
+{
+	uint32_t id = InternVariable(ieVariable { "TestIntern" }, VariableSpace::Shared);
+	EXPECT_EQ(InternVariable(ieVariable { "testintern" }, VariableSpace::Shared), id);
+	EXPECT_NE(InternVariable(ieVariable { "TestIntern2" }, VariableSpace::Shared), id);
+
+	// the spaces are numbered separately
+	size_t locals = InternedVariableCount(VariableSpace::Local);
+	InternVariable(ieVariable { "TestIntern" }, VariableSpace::Local);
+	EXPECT_EQ(InternedVariableCount(VariableSpace::Local), locals + 1);
+}
+
+TEST(VariableSlotsTest, Find)
+{
+	ieVarsMap vars;
+	vars[ieVariable { "found" }] = 5;
+	VariableSlots slots;
+	uint32_t found = InternVariable(ieVariable { "found" }, VariableSpace::Shared);
+	uint32_t missing = InternVariable(ieVariable { "missing" }, VariableSpace::Shared);
+
+	const ieDword* value = slots.Find(vars, VariableSpace::Shared, found, "FOUND");
+	ASSERT_NE(value, nullptr);
+	EXPECT_EQ(*value, ieDword(5));
+	vars[ieVariable { "found" }] = 6;
+	EXPECT_EQ(*slots.Find(vars, VariableSpace::Shared, found, "FOUND"), ieDword(6));
+
+	EXPECT_EQ(slots.Find(vars, VariableSpace::Shared, missing, "missing"), nullptr);
+	EXPECT_EQ(slots.Find(vars, VariableSpace::Shared, missing, "missing"), nullptr);
+	// the negative entry must not survive the variable being added behind our back
+	vars[ieVariable { "missing" }] = 7;
+	value = slots.Find(vars, VariableSpace::Shared, missing, "missing");
+	ASSERT_NE(value, nullptr);
+	EXPECT_EQ(*value, ieDword(7));
+}
+
+TEST(VariableSlotsTest, Get)
+{
+	ieVarsMap vars;
+	VariableSlots slots;
+	uint32_t id = InternVariable(ieVariable { "created" }, VariableSpace::Local);
+
+	EXPECT_EQ(slots.Get(vars, VariableSpace::Local, id, "created", false), nullptr);
+	EXPECT_TRUE(vars.empty());
+
+	ieDword* value = slots.Get(vars, VariableSpace::Local, id, "created", true);
+	ASSERT_NE(value, nullptr);
+	*value = 3;
+	EXPECT_EQ(vars[ieVariable { "CREATED" }], ieDword(3));
+	EXPECT_EQ(slots.Get(vars, VariableSpace::Local, id, "created", false), value);
+}
+
+TEST(VariableSlotsTest, Copy)
+{
+	ieVarsMap vars;
+	vars[ieVariable { "copied" }] = 1;
+	VariableSlots slots;
+	uint32_t id = InternVariable(ieVariable { "copied" }, VariableSpace::Shared);
+	slots.Find(vars, VariableSpace::Shared, id, "copied");
+
+	// a copied map has its own nodes, so the copied slots have to start over
+	ieVarsMap copiedVars = vars;
+	VariableSlots copiedSlots = slots;
+	const ieDword* value = copiedSlots.Find(copiedVars, VariableSpace::Shared, id, "copied");
+	ASSERT_NE(value, nullptr);
+	EXPECT_EQ(value, &copiedVars[ieVariable { "copied" }]);
+}
+
+}
@@ -0,0 +1,185 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "../../../core/Video/PixelKernels.h"
+
+#include <gtest/gtest.h>
+#include <random>
+
+namespace GemRB {
+
+static const PixelFormat ARGB = PixelFormat::ARGB32Bit();
+static const PixelFormat XRGB {
+	0, 0, 0, 0, 16, 8, 0, 0, 0x00FF0000, 0x0000FF00, 0x000000FF, 0, 4, 32, 0, false, false, {}
+};
+static const PixelFormat ABGR {
+	0, 0, 0, 0, 0, 8, 16, 24, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000, 4, 32, 0, false, false, {}
+};
+
+static std::vector<PixelKernelISA> ISAs()
+{
+	std::vector<PixelKernelISA> isas;
+	for (int isa = 0; isa <= int(SupportedPixelKernelISA()); ++isa) {
+		isas.push_back(PixelKernelISA(isa));
+	}
+	return isas;
+}
+
+static std::vector<uint32_t> RandomPixels(std::mt19937& rng, size_t count, uint32_t amask)
+{
+	std::vector<uint32_t> pixels(count);
+	for (uint32_t& px : pixels) {
+		px = rng();
+		// plenty of the special cases
+		switch (rng() % 4) {
+			case 0:
+				px &= ~amask;
+				break;
+			case 1:
+				px |= amask;
+				break;
+			default:
+				break;
+		}
+	}
+	return pixels;
+}
+
+// restores the selected instruction set after each test
+class PixelKernelsTest : public testing::Test {
+protected:
+	void TearDown() override
+	{
+		SetPixelKernelISA(SupportedPixelKernelISA());
+	}
+};
+
+static Color ReadColor(uint32_t px, const PixelFormat& fmt)
+{
+	uint8_t a = fmt.Amask ? (px & fmt.Amask) >> fmt.Ashift : 255;
+	return Color((px & fmt.Rmask) >> fmt.Rshift, (px & fmt.Gmask) >> fmt.Gshift, (px & fmt.Bmask) >> fmt.Bshift, a);
+}
+
+static uint32_t WriteColor(const Color& c, const PixelFormat& fmt)
+{
+	return uint32_t(c.r) << fmt.Rshift | uint32_t(c.g) << fmt.Gshift | uint32_t(c.b) << fmt.Bshift | ((uint32_t(c.a) << fmt.Ashift) & fmt.Amask);
+}
+
+// what BlitBlendedRect does with the pipeline
+template<SHADER SHADE>
+static void PipelineRow(const RGBBlendingPipeline<SHADE, true>& pipeline, const std::vector<uint32_t>& src, std::vector<uint32_t>& dst,
+			const PixelFormat& srcFmt, const PixelFormat& dstFmt)
+{
+	for (size_t i = 0; i < src.size(); ++i) {
+		Color d = ReadColor(dst[i], dstFmt);
+		pipeline(ReadColor(src[i], srcFmt), d, 0);
+		dst[i] = WriteColor(d, dstFmt);
+	}
+}
+
+template<SHADER SHADE>
+static void ComparePipeline(const RGBBlendingPipeline<SHADE, true>& pipeline, const PixelFormat& srcFmt, const PixelFormat& dstFmt,
+			    const std::vector<PixelKernelISA>& isas)
+{
+	std::mt19937 rng(static_cast<uint32_t>(SHADE) * 31 + dstFmt.Amask);
+	// odd sizes to cover the scalar tails
+	for (int count : { 1, 3, 7, 8, 37, 259 }) {
+		auto src = RandomPixels(rng, count, srcFmt.Amask);
+		auto dst = RandomPixels(rng, count, 0);
+		auto expected = dst;
+		PipelineRow(pipeline, src, expected, srcFmt, dstFmt);
+
+		RowBlender32 blender(SHADE, pipeline.GetTint(), pipeline.GetShift(), dstFmt);
+		for (PixelKernelISA isa : isas) {
+			SetPixelKernelISA(isa);
+			auto result = dst;
+			blender(src.data(), result.data(), count);
+			EXPECT_EQ(result, expected) << "isa " << int(isa) << ", shader " << int(SHADE) << ", count " << count;
+		}
+	}
+}
+
+TEST_F(PixelKernelsTest, RowBlenderSupports)
+{
+	EXPECT_TRUE(RowBlender32::Supports(ARGB, ARGB));
+	EXPECT_TRUE(RowBlender32::Supports(ARGB, XRGB));
+	EXPECT_TRUE(RowBlender32::Supports(ABGR, ABGR));
+	EXPECT_FALSE(RowBlender32::Supports(XRGB, ARGB)); // no source alpha
+	EXPECT_FALSE(RowBlender32::Supports(ABGR, ARGB)); // different layouts
+	EXPECT_FALSE(RowBlender32::Supports(ARGB, PixelFormat(2, 0xF800, 0x07E0, 0x001F, 0)));
+	EXPECT_FALSE(PaletteBlender32::Supports(PixelFormat(2, 0xF800, 0x07E0, 0x001F, 0)));
+	EXPECT_TRUE(PaletteBlender32::Supports(XRGB));
+}
+
+TEST_F(PixelKernelsTest, RowBlenderMatchesPipeline)
+{
+	const Color tint(200, 120, 255, 180);
+	const auto isas = ISAs();
+	for (const PixelFormat* dstFmt : { &ARGB, &XRGB }) {
+		ComparePipeline(RGBBlendingPipeline<SHADER::NONE, true>(), ARGB, *dstFmt, isas);
+		ComparePipeline(RGBBlendingPipeline<SHADER::TINT, true>(tint), ARGB, *dstFmt, isas);
+		ComparePipeline(RGBBlendingPipeline<SHADER::GREYSCALE, true>(), ARGB, *dstFmt, isas);
+		ComparePipeline(RGBBlendingPipeline<SHADER::GREYSCALE, true>(tint), ARGB, *dstFmt, isas);
+		ComparePipeline(RGBBlendingPipeline<SHADER::SEPIA, true>(), ARGB, *dstFmt, isas);
+		ComparePipeline(RGBBlendingPipeline<SHADER::SEPIA, true>(tint), ARGB, *dstFmt, isas);
+	}
+	ComparePipeline(RGBBlendingPipeline<SHADER::SEPIA, true>(tint), ABGR, ABGR, isas);
+}
+
+TEST_F(PixelKernelsTest, PaletteBlenderMatchesRLEBlender)
+{
+	std::mt19937 rng(42);
+	Color colors[256];
+	for (Color& c : colors) {
+		c = Color(rng(), rng(), rng(), rng() % 3 ? rng() : 255 * (rng() % 2));
+	}
+
+	for (const PixelFormat* fmt : { &ARGB, &XRGB, &ABGR }) {
+		PaletteBlender32 blender(colors, *fmt);
+		for (int count : { 1, 5, 8, 61, 300 }) {
+			std::vector<uint8_t> indices(count);
+			for (uint8_t& idx : indices) {
+				idx = rng();
+			}
+			auto dst = RandomPixels(rng, count, fmt->Amask);
+
+			// SRBlender_Alpha for 32bpp
+			auto expected = dst;
+			for (int i = 0; i < count; ++i) {
+				const Color& c = colors[indices[i]];
+				Color d = ReadColor(dst[i], *fmt);
+				unsigned int dr = 1 + c.a * c.r + (255 - c.a) * d.r;
+				unsigned int dg = 1 + c.a * c.g + (255 - c.a) * d.g;
+				unsigned int db = 1 + c.a * c.b + (255 - c.a) * d.b;
+				Color out((dr + (dr >> 8)) >> 8, (dg + (dg >> 8)) >> 8, (db + (db >> 8)) >> 8, 0);
+				expected[i] = WriteColor(out, *fmt) | fmt->Amask;
+			}
+
+			for (PixelKernelISA isa : ISAs()) {
+				SetPixelKernelISA(isa);
+				auto result = dst;
+				blender(indices.data(), result.data(), count);
+				EXPECT_EQ(result, expected) << "isa " << int(isa) << ", count " << count;
+			}
+		}
+	}
+}
+
+}